@@ -31,11 +31,14 @@
 #include "file_access_pack.h"
 
 #include "core/io/file_access_encrypted.h"
+#include "core/io/marshalls.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/version.h"
 
 #include <stdio.h>
+#include <zstd.h>
 
 Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
 	for (int i = 0; i < sources.size(); i++) {
@@ -47,13 +50,14 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_compressed) {
 	PathMD5 pmd5(p_path.md5_buffer());
 
 	bool exists = files.has(pmd5);
 
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
+	pf.compressed = p_compressed;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -95,6 +99,56 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 	}
 }
 
+PackedData::MapFileFunc PackedData::map_file_func = nullptr;
+PackedData::UnmapFileFunc PackedData::unmap_file_func = nullptr;
+
+void PackedData::set_map_file_funcs(MapFileFunc p_map_func, UnmapFileFunc p_unmap_func) {
+	map_file_func = p_map_func;
+	unmap_file_func = p_unmap_func;
+}
+
+void PackedData::map_pack(const String &p_path) {
+	if (!map_file_func || mapped_packs.has(p_path)) {
+		return;
+	}
+
+	MappedPack mapped_pack;
+	mapped_pack.data = map_file_func(p_path, &mapped_pack.length);
+	if (!mapped_pack.data) {
+		// The files will be read from the pack instead.
+		print_verbose("Can't memory map pack '" + p_path + "'.");
+		return;
+	}
+	mapped_packs[p_path] = mapped_pack;
+}
+
+const uint8_t *PackedData::get_mapped_pack(const String &p_path, uint64_t *r_length) const {
+	const MappedPack *mapped_pack = mapped_packs.getptr(p_path);
+	if (!mapped_pack) {
+		return nullptr;
+	}
+	*r_length = mapped_pack->length;
+	return mapped_pack->data;
+}
+
+void PackedData::add_dictionary(const String &p_pkg_path, const Vector<uint8_t> &p_dictionary) {
+	ZSTD_DDict *ddict = ZSTD_createDDict(p_dictionary.ptr(), p_dictionary.size());
+	ERR_FAIL_NULL_MSG(ddict, "Can't load the compression dictionary of pack '" + p_pkg_path + "'.");
+
+	ZSTD_DDict **existing = dictionaries.getptr(p_pkg_path);
+	if (existing) {
+		ZSTD_freeDDict(*existing);
+		*existing = ddict;
+	} else {
+		dictionaries.insert(p_pkg_path, ddict);
+	}
+}
+
+const ZSTD_DDict_s *PackedData::get_dictionary(const String &p_pkg_path) const {
+	ZSTD_DDict *const *ddict = dictionaries.getptr(p_pkg_path);
+	return ddict ? *ddict : nullptr;
+}
+
 void PackedData::add_pack_source(PackSource *p_source) {
 	if (p_source != nullptr) {
 		sources.push_back(p_source);
@@ -121,6 +175,12 @@ PackedData::~PackedData() {
 	for (int i = 0; i < sources.size(); i++) {
 		memdelete(sources[i]);
 	}
+	for (const KeyValue<String, MappedPack> &E : mapped_packs) {
+		unmap_file_func(E.value.data, E.value.length);
+	}
+	for (const KeyValue<String, ZSTD_DDict *> &E : dictionaries) {
+		ZSTD_freeDDict(E.value);
+	}
 	_free_packed_dirs(root);
 }
 
@@ -200,21 +260,37 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // patch number, not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION, false, "Pack version unsupported: " + itos(version) + ".");
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V2 && version != PACK_FORMAT_VERSION_V3, false, "Pack version unsupported: " + itos(version) + ".");
 	ERR_FAIL_COND_V_MSG(ver_major > VERSION_MAJOR || (ver_major == VERSION_MAJOR && ver_minor > VERSION_MINOR), false, "Pack created with a newer version of the engine: " + itos(ver_major) + "." + itos(ver_minor) + ".");
 
 	uint32_t pack_flags = f->get_32();
 	uint64_t file_base = f->get_64();
 
+	// Version 2 packs have no compressed files, the dictionary fields are reserved there.
+	if (version < PACK_FORMAT_VERSION_V3) {
+		pack_flags &= ~PACK_ZSTD_DICTIONARY;
+	}
+
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
 
-	for (int i = 0; i < 16; i++) {
+	uint64_t dictionary_ofs = f->get_64();
+	uint64_t dictionary_size = f->get_64();
+	for (int i = 0; i < 12; i++) {
 		//reserved
 		f->get_32();
 	}
 
 	int file_count = f->get_32();
 
+	if (pack_flags & PACK_ZSTD_DICTIONARY) {
+		uint64_t directory_pos = f->get_position();
+		f->seek(file_base + dictionary_ofs + p_offset);
+		Vector<uint8_t> dictionary = f->get_buffer(dictionary_size);
+		ERR_FAIL_COND_V_MSG((uint64_t)dictionary.size() != dictionary_size, false, "Can't read the compression dictionary of pack '" + p_path + "'.");
+		PackedData::get_singleton()->add_dictionary(p_path, dictionary);
+		f->seek(directory_pos);
+	}
+
 	if (enc_directory) {
 		Ref<FileAccessEncrypted> fae;
 		fae.instantiate();
@@ -247,9 +323,11 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
 
-		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
+		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), version >= PACK_FORMAT_VERSION_V3 && (flags & PACK_FILE_COMPRESSED));
 	}
 
+	PackedData::get_singleton()->map_pack(p_path);
+
 	return true;
 }
 
@@ -264,8 +342,170 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 	return ERR_UNAVAILABLE;
 }
 
+void FileAccessPack::_open_compressed(const uint8_t *p_mapped_pack, uint64_t p_mapped_length) {
+	ERR_FAIL_COND_MSG(pf.encrypted, "Encrypted files can't be compressed, in pack '" + String(pf.pack) + "'.");
+	dictionary = PackedData::get_singleton()->get_dictionary(pf.pack);
+
+	const uint8_t *header = nullptr;
+	if (p_mapped_pack) {
+		ERR_FAIL_COND_MSG(pf.offset + 8 > p_mapped_length, "Compressed file out of the bounds of pack '" + String(pf.pack) + "'.");
+		header = p_mapped_pack + pf.offset;
+	} else {
+		f = FileAccess::open(pf.pack, FileAccess::READ);
+		ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
+		f->seek(pf.offset);
+	}
+
+	const uint32_t size = header ? decode_uint32(header) : f->get_32();
+	const uint32_t count = header ? decode_uint32(header + 4) : f->get_32();
+	const uint64_t table_size = 8 + (uint64_t)count * 8;
+	if (size == 0 || count != (pf.size + size - 1) / size || (header && pf.offset + table_size > p_mapped_length)) {
+		f.unref();
+		ERR_FAIL_MSG("Corrupted compressed file in pack '" + String(pf.pack) + "'.");
+	}
+
+	off = pf.offset + table_size;
+
+	block_offsets.resize(count + 1);
+	block_offsets[0] = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		const uint64_t offset = header ? decode_uint64(header + 8 + i * 8) : f->get_64();
+		// Offsets going backwards would wrap around when computing block sizes.
+		if (offset < block_offsets[i] || (header && offset > p_mapped_length - off)) {
+			block_offsets.clear();
+			f.unref();
+			ERR_FAIL_MSG("Corrupted compressed file in pack '" + String(pf.pack) + "'.");
+		}
+		block_offsets[i + 1] = offset;
+	}
+
+	if (header) {
+		compressed_data = p_mapped_pack + off;
+	}
+	block_size = size;
+}
+
+bool FileAccessPack::_decompress_block(ZSTD_DCtx_s *p_dctx, const ZSTD_DDict_s *p_dictionary, const uint8_t *p_src, uint64_t p_src_size, uint8_t *p_dst, uint64_t p_dst_size) {
+	if (p_src_size == p_dst_size) {
+		// Stored uncompressed.
+		memcpy(p_dst, p_src, p_dst_size);
+		return true;
+	}
+
+	size_t ret;
+	if (p_dictionary) {
+		ret = ZSTD_decompress_usingDDict(p_dctx, p_dst, p_dst_size, p_src, p_src_size, p_dictionary);
+	} else {
+		ret = ZSTD_decompressDCtx(p_dctx, p_dst, p_dst_size, p_src, p_src_size);
+	}
+	return !ZSTD_isError(ret) && ret == p_dst_size;
+}
+
+void FileAccessPack::_decompress_blocks_task(uint32_t p_index, DecompressionJob *p_job) const {
+	ZSTD_DCtx *task_dctx = ZSTD_createDCtx();
+
+	// Take the next block until they are all decompressed.
+	while (!p_job->failed.is_set()) {
+		uint32_t i = p_job->next.postincrement();
+		if (i >= p_job->block_count) {
+			break;
+		}
+
+		const uint32_t block = p_job->first_block + i;
+		const uint8_t *src = p_job->src + (block_offsets[block] - block_offsets[p_job->first_block]);
+		if (!_decompress_block(task_dctx, dictionary, src, block_offsets[block + 1] - block_offsets[block], p_job->dst + (uint64_t)i * block_size, _get_block_length(block))) {
+			p_job->failed.set();
+		}
+	}
+
+	ZSTD_freeDCtx(task_dctx);
+}
+
+bool FileAccessPack::_decompress_blocks(uint32_t p_first_block, uint32_t p_count, uint8_t *p_dst) const {
+	const uint64_t begin = block_offsets[p_first_block];
+	const uint64_t end = block_offsets[p_first_block + p_count];
+
+	const uint8_t *src = nullptr;
+	if (compressed_data) {
+		src = compressed_data + begin;
+	} else {
+		// Reads are const, but the position of the pack file is not part of the state of this file.
+		Ref<FileAccess> pack_file = f;
+		read_buffer.resize(end - begin);
+		pack_file->seek(off + begin);
+		if (pack_file->get_buffer(read_buffer.ptrw(), end - begin) != end - begin) {
+			return false;
+		}
+		src = read_buffer.ptr();
+	}
+
+	WorkerThreadPool *wtp = WorkerThreadPool::get_singleton();
+	if (p_count >= PARALLEL_DECOMPRESSION_MIN_BLOCKS && wtp && wtp->get_thread_count() > 1 && !wtp->is_worker_thread()) {
+		DecompressionJob job;
+		job.first_block = p_first_block;
+		job.block_count = p_count;
+		job.src = src;
+		job.dst = p_dst;
+
+		WorkerThreadPool::GroupID group_task = wtp->add_template_group_task(this, &FileAccessPack::_decompress_blocks_task, &job, MIN(p_count, (uint32_t)wtp->get_thread_count()), -1, true, SNAME("FileAccessPackDecompression"));
+		wtp->wait_for_group_task_completion(group_task);
+		return !job.failed.is_set();
+	}
+
+	if (!dctx) {
+		dctx = ZSTD_createDCtx();
+	}
+	for (uint32_t i = 0; i < p_count; i++) {
+		const uint32_t block = p_first_block + i;
+		if (!_decompress_block(dctx, dictionary, src + (block_offsets[block] - begin), block_offsets[block + 1] - block_offsets[block], p_dst + (uint64_t)i * block_size, _get_block_length(block))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FileAccessPack::_read_compressed(uint8_t *p_dst, uint64_t p_length) const {
+	const uint32_t block_count = block_offsets.size() - 1;
+
+	uint64_t done = 0;
+	while (done < p_length) {
+		const uint64_t position = pos + done;
+		const uint32_t block = position / block_size;
+		const uint64_t in_block = position - (uint64_t)block * block_size;
+
+		if (in_block == 0 && block != cached_block) {
+			// The whole blocks in the range are decompressed straight to the destination.
+			uint32_t count = 0;
+			uint64_t length = 0;
+			while (block + count < block_count && done + length + _get_block_length(block + count) <= p_length) {
+				length += _get_block_length(block + count);
+				count++;
+			}
+			if (count > 0) {
+				ERR_FAIL_COND_V_MSG(!_decompress_blocks(block, count, p_dst + done), false, "Can't decompress file from pack '" + String(pf.pack) + "'.");
+				done += length;
+				continue;
+			}
+		}
+
+		if (block != cached_block) {
+			block_cache.resize(block_size);
+			cached_block = -1;
+			ERR_FAIL_COND_V_MSG(!_decompress_blocks(block, 1, block_cache.ptrw()), false, "Can't decompress file from pack '" + String(pf.pack) + "'.");
+			cached_block = block;
+		}
+
+		const uint64_t length = MIN(_get_block_length(block) - in_block, p_length - done);
+		memcpy(p_dst + done, block_cache.ptr() + in_block, length);
+		done += length;
+	}
+	return true;
+}
+
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (data || block_size) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -273,7 +513,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!data && f.is_null(), "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -281,7 +521,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!data && !block_size) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -302,18 +544,29 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint8_t FileAccessPack::get_8() const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), 0, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!data && f.is_null(), 0, "File must be opened before use.");
 	if (pos >= pf.size) {
 		eof = true;
 		return 0;
 	}
 
+	if (data) {
+		return data[pos++];
+	}
+
+	if (block_size) {
+		uint8_t b = 0;
+		_read_compressed(&b, 1);
+		pos++;
+		return b;
+	}
+
 	pos++;
 	return f->get_8();
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!data && f.is_null(), -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -326,21 +579,43 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
-	pos += p_length;
-
 	if (to_read <= 0) {
+		pos += p_length;
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+
+	if (data) {
+		memcpy(p_dst, data + pos, to_read);
+	} else if (block_size) {
+		if (!_read_compressed(p_dst, to_read)) {
+			eof = true;
+			return 0;
+		}
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
+	pos += p_length;
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_mapped_buffer(uint64_t p_length) const {
+	if (!data || eof || pos > pf.size || p_length > pf.size - pos) {
+		return nullptr;
+	}
+
+	const uint8_t *ptr = data + pos;
+	pos += p_length;
+	return ptr;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!data && f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -367,16 +642,44 @@ bool FileAccessPack::file_exists(const String &p_name) {
 }
 
 void FileAccessPack::close() {
+	data = nullptr;
 	f = Ref<FileAccess>();
+
+	block_size = 0;
+	block_offsets.clear();
+	compressed_data = nullptr;
+	if (dctx) {
+		ZSTD_freeDCtx(dctx);
+		dctx = nullptr;
+	}
+	block_cache.clear();
+	cached_block = -1;
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+		pf(p_file) {
+	pos = 0;
+	eof = false;
+	off = pf.offset;
+
+	// Read straight from the memory mapped pack when possible.
+	uint64_t mapped_length = 0;
+	const uint8_t *mapped_pack = pf.encrypted ? nullptr : PackedData::get_singleton()->get_mapped_pack(pf.pack, &mapped_length);
+
+	if (pf.compressed) {
+		_open_compressed(mapped_pack, mapped_length);
+		return;
+	}
+
+	if (mapped_pack && pf.offset + pf.size <= mapped_length) {
+		data = mapped_pack + pf.offset;
+		return;
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
-	off = pf.offset;
 
 	if (pf.encrypted) {
 		Ref<FileAccessEncrypted> fae;
@@ -394,8 +697,12 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
+}
+
+FileAccessPack::~FileAccessPack() {
+	if (dctx) {
+		ZSTD_freeDCtx(dctx);
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -36,22 +36,36 @@
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
+#include "core/templates/safe_refcount.h"
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
+// The packed file format version numbers. Version 3 adds the compressed files and
+// their dictionary, the packs without compressed files are still written as version 2.
+#define PACK_FORMAT_VERSION_V2 2
+#define PACK_FORMAT_VERSION_V3 3
 // The current packed file format version number.
-#define PACK_FORMAT_VERSION 2
+#define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V3
 
 enum PackFlags {
-	PACK_DIR_ENCRYPTED = 1 << 0
+	PACK_DIR_ENCRYPTED = 1 << 0,
+	// The first reserved fields of the header hold the offset and size of a zstd dictionary, used by the compressed files.
+	PACK_ZSTD_DICTIONARY = 1 << 1,
 };
 
 enum PackFileFlags {
-	PACK_FILE_ENCRYPTED = 1 << 0
+	PACK_FILE_ENCRYPTED = 1 << 0,
+	// The file is split in blocks compressed independently with zstd. It starts with the uncompressed block size,
+	// the block count and the end offset of each compressed block, relative to the end of this table.
+	// Blocks which don't get smaller are stored uncompressed.
+	PACK_FILE_COMPRESSED = 1 << 1,
 };
 
 class PackSource;
+struct ZSTD_DCtx_s;
+struct ZSTD_DDict_s;
 
 class PackedData {
 	friend class FileAccessPack;
@@ -66,6 +80,7 @@ public:
 		uint8_t md5[16];
 		PackSource *src = nullptr;
 		bool encrypted;
+		bool compressed = false;
 	};
 
 private:
@@ -100,6 +115,15 @@ private:
 
 	Vector<PackSource *> sources;
 
+	struct MappedPack {
+		const uint8_t *data = nullptr;
+		uint64_t length = 0;
+	};
+
+	HashMap<String, MappedPack> mapped_packs;
+
+	HashMap<String, ZSTD_DDict_s *> dictionaries;
+
 	PackedDir *root = nullptr;
 
 	static PackedData *singleton;
@@ -108,8 +132,24 @@ private:
 	void _free_packed_dirs(PackedDir *p_dir);
 
 public:
+	typedef const uint8_t *(*MapFileFunc)(const String &p_path, uint64_t *r_length);
+	typedef void (*UnmapFileFunc)(const uint8_t *p_data, uint64_t p_length);
+
+private:
+	static MapFileFunc map_file_func;
+	static UnmapFileFunc unmap_file_func;
+
+public:
+	// Set by the platforms which can memory map the packs.
+	static void set_map_file_funcs(MapFileFunc p_map_func, UnmapFileFunc p_unmap_func);
+
+	void map_pack(const String &p_path); // for PackSource
+	const uint8_t *get_mapped_pack(const String &p_path, uint64_t *r_length) const;
+
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_compressed = false); // for PackSource
+	void add_dictionary(const String &p_pkg_path, const Vector<uint8_t> &p_dictionary); // for PackSource
+	const ZSTD_DDict_s *get_dictionary(const String &p_pkg_path) const;
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
@@ -147,6 +187,38 @@ class FileAccessPack : public FileAccess {
 	mutable bool eof;
 	uint64_t off;
 
+	// The file in the memory mapped pack, if any. `f` is not used then.
+	const uint8_t *data = nullptr;
+
+	// Compressed files are decompressed one block at a time, reading from the
+	// memory mapped pack if any, or from `f` otherwise.
+	static const uint32_t PARALLEL_DECOMPRESSION_MIN_BLOCKS = 4;
+
+	struct DecompressionJob {
+		uint32_t first_block = 0;
+		uint32_t block_count = 0;
+		const uint8_t *src = nullptr;
+		uint8_t *dst = nullptr;
+		SafeNumeric<uint32_t> next;
+		SafeFlag failed;
+	};
+
+	uint32_t block_size = 0; // Zero if the file is not compressed.
+	LocalVector<uint64_t> block_offsets; // One more than the blocks, the last one is the end of the data.
+	const uint8_t *compressed_data = nullptr;
+	const ZSTD_DDict_s *dictionary = nullptr;
+	mutable ZSTD_DCtx_s *dctx = nullptr;
+	mutable Vector<uint8_t> block_cache;
+	mutable int64_t cached_block = -1;
+	mutable Vector<uint8_t> read_buffer;
+
+	void _open_compressed(const uint8_t *p_mapped_pack, uint64_t p_mapped_length);
+	_FORCE_INLINE_ uint64_t _get_block_length(uint32_t p_block) const { return MIN((uint64_t)block_size, pf.size - (uint64_t)p_block * block_size); }
+	static bool _decompress_block(ZSTD_DCtx_s *p_dctx, const ZSTD_DDict_s *p_dictionary, const uint8_t *p_src, uint64_t p_src_size, uint8_t *p_dst, uint64_t p_dst_size);
+	void _decompress_blocks_task(uint32_t p_index, DecompressionJob *p_job) const;
+	bool _decompress_blocks(uint32_t p_first_block, uint32_t p_count, uint8_t *p_dst) const;
+	bool _read_compressed(uint8_t *p_dst, uint64_t p_length) const;
+
 	Ref<FileAccess> f;
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
@@ -166,6 +238,7 @@ public:
 	virtual uint8_t get_8() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_buffer(uint64_t p_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -181,6 +254,7 @@ public:
 	virtual void close() override;
 
 	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	~FileAccessPack();
 };
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
@@ -194,14 +194,22 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 			case '"': {
 				index++;
 				String str;
+				// Runs of characters without escapes are copied at once.
+				int span_start = index;
 				while (true) {
 					if (p_str[index] == 0) {
 						r_err_str = "Unterminated String";
 						return ERR_PARSE_ERROR;
 					} else if (p_str[index] == '"') {
+						if (index > span_start) {
+							str += String(&p_str[span_start], index - span_start);
+						}
 						index++;
 						break;
 					} else if (p_str[index] == '\\') {
+						if (index > span_start) {
+							str += String(&p_str[span_start], index - span_start);
+						}
 						//escaped characters...
 						index++;
 						char32_t next = p_str[index];
@@ -311,12 +319,10 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 						}
 
 						str += res;
+						span_start = index + 1;
 
-					} else {
-						if (p_str[index] == '\n') {
-							line++;
-						}
-						str += p_str[index];
+					} else if (p_str[index] == '\n') {
+						line++;
 					}
 					index++;
 				}
@@ -342,15 +348,13 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 					return OK;
 
 				} else if (is_ascii_char(p_str[index])) {
-					String id;
-
+					const int id_start = index;
 					while (is_ascii_char(p_str[index])) {
-						id += p_str[index];
 						index++;
 					}
 
 					r_token.type = TK_IDENTIFIER;
-					r_token.value = id;
+					r_token.value = String(&p_str[id_start], index - id_start);
 					return OK;
 				} else {
 					r_err_str = "Unexpected character.";
@@ -363,7 +367,7 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 	return ERR_PARSE_ERROR;
 }
 
-Error JSON::_parse_value(Variant &value, Token &token, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str) {
+Error JSON::_parse_value(Variant &value, Token &token, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str, LocalVector<Variant> &r_values) {
 	if (p_depth > Variant::MAX_RECURSION_DEPTH) {
 		r_err_str = "JSON structure is too deep. Bailing.";
 		return ERR_OUT_OF_MEMORY;
@@ -371,14 +375,14 @@ Error JSON::_parse_value(Variant &value, Token &token, const char32_t *p_str, in
 
 	if (token.type == TK_CURLY_BRACKET_OPEN) {
 		Dictionary d;
-		Error err = _parse_object(d, p_str, index, p_len, line, p_depth + 1, r_err_str);
+		Error err = _parse_object(d, p_str, index, p_len, line, p_depth + 1, r_err_str, r_values);
 		if (err) {
 			return err;
 		}
 		value = d;
 	} else if (token.type == TK_BRACKET_OPEN) {
 		Array a;
-		Error err = _parse_array(a, p_str, index, p_len, line, p_depth + 1, r_err_str);
+		Error err = _parse_array(a, p_str, index, p_len, line, p_depth + 1, r_err_str, r_values);
 		if (err) {
 			return err;
 		}
@@ -407,9 +411,11 @@ Error JSON::_parse_value(Variant &value, Token &token, const char32_t *p_str, in
 	return OK;
 }
 
-Error JSON::_parse_array(Array &array, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str) {
+Error JSON::_parse_array(Array &array, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str, LocalVector<Variant> &r_values) {
 	Token token;
 	bool need_comma = false;
+	// Elements are gathered on the shared value stack, so the array is allocated once at its final size.
+	const uint32_t first_value = r_values.size();
 
 	while (index < p_len) {
 		Error err = _get_token(p_str, index, p_len, token, line, r_err_str);
@@ -418,6 +424,12 @@ Error JSON::_parse_array(Array &array, const char32_t *p_str, int &index, int p_
 		}
 
 		if (token.type == TK_BRACKET_CLOSE) {
+			const uint32_t count = r_values.size() - first_value;
+			array.resize(count);
+			for (uint32_t i = 0; i < count; i++) {
+				array[i] = r_values[first_value + i];
+			}
+			r_values.resize(first_value);
 			return OK;
 		}
 
@@ -432,12 +444,12 @@ Error JSON::_parse_array(Array &array, const char32_t *p_str, int &index, int p_
 		}
 
 		Variant v;
-		err = _parse_value(v, token, p_str, index, p_len, line, p_depth, r_err_str);
+		err = _parse_value(v, token, p_str, index, p_len, line, p_depth, r_err_str, r_values);
 		if (err) {
 			return err;
 		}
 
-		array.push_back(v);
+		r_values.push_back(v);
 		need_comma = true;
 	}
 
@@ -445,11 +457,12 @@ Error JSON::_parse_array(Array &array, const char32_t *p_str, int &index, int p_
 	return ERR_PARSE_ERROR;
 }
 
-Error JSON::_parse_object(Dictionary &object, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str) {
+Error JSON::_parse_object(Dictionary &object, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str, LocalVector<Variant> &r_values) {
 	bool at_key = true;
-	String key;
 	Token token;
 	bool need_comma = false;
+	// Keys and values are gathered on the shared value stack, so the dictionary is allocated once at its final size.
+	const uint32_t first_value = r_values.size();
 
 	while (index < p_len) {
 		if (at_key) {
@@ -459,6 +472,12 @@ Error JSON::_parse_object(Dictionary &object, const char32_t *p_str, int &index,
 			}
 
 			if (token.type == TK_CURLY_BRACKET_CLOSE) {
+				const uint32_t count = r_values.size() - first_value;
+				object.reserve(count / 2);
+				for (uint32_t i = 0; i < count; i += 2) {
+					object[r_values[first_value + i]] = r_values[first_value + i + 1];
+				}
+				r_values.resize(first_value);
 				return OK;
 			}
 
@@ -477,7 +496,7 @@ Error JSON::_parse_object(Dictionary &object, const char32_t *p_str, int &index,
 				return ERR_PARSE_ERROR;
 			}
 
-			key = token.value;
+			r_values.push_back(token.value);
 			err = _get_token(p_str, index, p_len, token, line, r_err_str);
 			if (err != OK) {
 				return err;
@@ -494,11 +513,11 @@ Error JSON::_parse_object(Dictionary &object, const char32_t *p_str, int &index,
 			}
 
 			Variant v;
-			err = _parse_value(v, token, p_str, index, p_len, line, p_depth, r_err_str);
+			err = _parse_value(v, token, p_str, index, p_len, line, p_depth, r_err_str, r_values);
 			if (err) {
 				return err;
 			}
-			object[key] = v;
+			r_values.push_back(v);
 			need_comma = true;
 			at_key = true;
 		}
@@ -519,14 +538,14 @@ Error JSON::_parse_string(const String &p_json, Variant &r_ret, String &r_err_st
 	int len = p_json.length();
 	Token token;
 	r_err_line = 0;
-	String aux_key;
+	LocalVector<Variant> values;
 
 	Error err = _get_token(str, idx, len, token, r_err_line, r_err_str);
 	if (err) {
 		return err;
 	}
 
-	err = _parse_value(r_ret, token, str, idx, len, r_err_line, 0, r_err_str);
+	err = _parse_value(r_ret, token, str, idx, len, r_err_line, 0, r_err_str, values);
 
 	// Check if EOF is reached
 	// or it's a type of the next token.
@@ -0,0 +1,598 @@
+/**************************************************************************/
+/*  json_reader.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "json_reader.h"
+
+// Returns a non-zero value if any byte of p_word is p_byte.
+static _FORCE_INLINE_ uint64_t _match_byte(uint64_t p_word, uint8_t p_byte) {
+	const uint64_t x = p_word ^ (0x0101010101010101ULL * p_byte);
+	return (x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL;
+}
+
+static void _append_utf8(LocalVector<char> &r_buffer, char32_t p_char) {
+	if (p_char < 0x80) {
+		r_buffer.push_back(p_char);
+	} else if (p_char < 0x800) {
+		r_buffer.push_back(0xc0 | (p_char >> 6));
+		r_buffer.push_back(0x80 | (p_char & 0x3f));
+	} else if (p_char < 0x10000) {
+		r_buffer.push_back(0xe0 | (p_char >> 12));
+		r_buffer.push_back(0x80 | ((p_char >> 6) & 0x3f));
+		r_buffer.push_back(0x80 | (p_char & 0x3f));
+	} else {
+		r_buffer.push_back(0xf0 | (p_char >> 18));
+		r_buffer.push_back(0x80 | ((p_char >> 12) & 0x3f));
+		r_buffer.push_back(0x80 | ((p_char >> 6) & 0x3f));
+		r_buffer.push_back(0x80 | (p_char & 0x3f));
+	}
+}
+
+bool JSONReader::_fill() {
+	if (file.is_null() || buffer.is_empty()) {
+		return false;
+	}
+
+	length = file->get_buffer(buffer.ptrw(), CHUNK_SIZE);
+	data = buffer.ptr();
+	pos = 0;
+	return length > 0;
+}
+
+Error JSONReader::_set_error(const String &p_message) {
+	err_str = p_message;
+	token_type = TOKEN_NONE;
+	value = Variant();
+	return ERR_PARSE_ERROR;
+}
+
+void JSONReader::_skip_whitespace() {
+	while (_has_data()) {
+		const uint8_t c = data[pos];
+		if (c == '\n') {
+			current_line++;
+		} else if (c > 32) {
+			return;
+		}
+		pos++;
+	}
+}
+
+void JSONReader::_skip_plain_string() {
+	// Most of the input is usually strings, so they are scanned 8 bytes at a time.
+	while (pos + 8 <= length) {
+		uint64_t word;
+		memcpy(&word, data + pos, 8);
+		if (_match_byte(word, '"') | _match_byte(word, '\\') | _match_byte(word, '\n')) {
+			break;
+		}
+		pos += 8;
+	}
+
+	while (pos < length && data[pos] != '"' && data[pos] != '\\' && data[pos] != '\n') {
+		pos++;
+	}
+}
+
+bool JSONReader::_read_hex(char32_t &r_value) {
+	r_value = 0;
+	for (int i = 0; i < 4; i++) {
+		if (!_has_data()) {
+			_set_error("Unterminated String");
+			return false;
+		}
+
+		const char32_t c = data[pos++];
+		char32_t v;
+		if (is_digit(c)) {
+			v = c - '0';
+		} else if (c >= 'a' && c <= 'f') {
+			v = c - 'a' + 10;
+		} else if (c >= 'A' && c <= 'F') {
+			v = c - 'A' + 10;
+		} else {
+			_set_error("Malformed hex constant in string");
+			return false;
+		}
+
+		r_value = (r_value << 4) | v;
+	}
+
+	return true;
+}
+
+bool JSONReader::_read_string() {
+	pos++; // Opening quote.
+	string_buffer.clear();
+
+	while (true) {
+		if (!_has_data()) {
+			_set_error("Unterminated String");
+			return false;
+		}
+
+		const uint64_t start = pos;
+		_skip_plain_string();
+		if (pos > start) {
+			const uint32_t buffer_size = string_buffer.size();
+			string_buffer.resize(buffer_size + (pos - start));
+			memcpy(string_buffer.ptr() + buffer_size, data + start, pos - start);
+		}
+		if (pos == length) {
+			continue; // Refill.
+		}
+
+		const uint8_t c = data[pos++];
+		if (c == '"') {
+			break;
+		} else if (c == '\n') {
+			current_line++;
+			string_buffer.push_back('\n');
+			continue;
+		}
+
+		if (!_has_data()) {
+			_set_error("Unterminated String");
+			return false;
+		}
+
+		const uint8_t next = data[pos++];
+		switch (next) {
+			case 'b':
+				string_buffer.push_back(8);
+				break;
+			case 't':
+				string_buffer.push_back(9);
+				break;
+			case 'n':
+				string_buffer.push_back(10);
+				break;
+			case 'f':
+				string_buffer.push_back(12);
+				break;
+			case 'r':
+				string_buffer.push_back(13);
+				break;
+			case 'u': {
+				char32_t res;
+				if (!_read_hex(res)) {
+					return false;
+				}
+
+				if ((res & 0xfffffc00) == 0xd800) {
+					char32_t trail = 0;
+					if (_peek() != '\\') {
+						_set_error("Invalid UTF-16 sequence in string, unpaired lead surrogate");
+						return false;
+					}
+					pos++;
+					if (_peek() != 'u') {
+						_set_error("Invalid UTF-16 sequence in string, unpaired lead surrogate");
+						return false;
+					}
+					pos++;
+					if (!_read_hex(trail)) {
+						return false;
+					}
+					if ((trail & 0xfffffc00) != 0xdc00) {
+						_set_error("Invalid UTF-16 sequence in string, unpaired lead surrogate");
+						return false;
+					}
+					res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+				} else if ((res & 0xfffffc00) == 0xdc00) {
+					_set_error("Invalid UTF-16 sequence in string, unpaired trail surrogate");
+					return false;
+				}
+
+				_append_utf8(string_buffer, res);
+			} break;
+			default: {
+				string_buffer.push_back(next);
+			} break;
+		}
+	}
+
+	value = string_buffer.is_empty() ? String() : String::utf8(string_buffer.ptr(), string_buffer.size());
+	return true;
+}
+
+bool JSONReader::_skip_string() {
+	pos++; // Opening quote.
+
+	while (true) {
+		if (!_has_data()) {
+			_set_error("Unterminated String");
+			return false;
+		}
+
+		_skip_plain_string();
+		if (pos == length) {
+			continue;
+		}
+
+		const uint8_t c = data[pos++];
+		if (c == '"') {
+			return true;
+		} else if (c == '\n') {
+			current_line++;
+		} else if (c == '\\') {
+			if (!_has_data()) {
+				_set_error("Unterminated String");
+				return false;
+			}
+			pos++;
+		}
+	}
+}
+
+bool JSONReader::_read_number() {
+	char number[64];
+	int number_length = 0;
+
+	while (_has_data()) {
+		const uint8_t c = data[pos];
+		if (!is_digit(c) && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E') {
+			break;
+		}
+		if (number_length == 63) {
+			_set_error("Number is too long.");
+			return false;
+		}
+		number[number_length++] = c;
+		pos++;
+	}
+	number[number_length] = 0;
+
+	value = String::to_float(number);
+	return true;
+}
+
+bool JSONReader::_read_literal() {
+	char literal[8];
+	int literal_length = 0;
+
+	while (_has_data() && is_ascii_alphanumeric_char(data[pos])) {
+		if (literal_length == 7) {
+			break;
+		}
+		literal[literal_length++] = data[pos++];
+	}
+	literal[literal_length] = 0;
+
+	if (strcmp(literal, "true") == 0) {
+		value = true;
+	} else if (strcmp(literal, "false") == 0) {
+		value = false;
+	} else if (strcmp(literal, "null") == 0) {
+		value = Variant();
+	} else {
+		_set_error("Expected 'true','false' or 'null', got '" + String(literal) + "'.");
+		return false;
+	}
+
+	return true;
+}
+
+Error JSONReader::_read_value() {
+	_skip_whitespace();
+
+	const int c = _peek();
+	if (c == '{' || c == '[') {
+		pos++;
+		Frame frame;
+		frame.object = c == '{';
+		stack.push_back(frame);
+		token_type = frame.object ? TOKEN_OBJECT_BEGIN : TOKEN_ARRAY_BEGIN;
+		return OK;
+	}
+
+	bool valid;
+	if (c == -1) {
+		return _set_error("Expected value, got EOF.");
+	} else if (c == '"') {
+		valid = _read_string();
+	} else if (c == '-' || is_digit(c)) {
+		valid = _read_number();
+	} else if (is_ascii_alphanumeric_char(c)) {
+		valid = _read_literal();
+	} else {
+		return _set_error("Unexpected character.");
+	}
+
+	if (!valid) {
+		return ERR_PARSE_ERROR;
+	}
+	token_type = TOKEN_VALUE;
+	return OK;
+}
+
+Error JSONReader::read() {
+	if (!err_str.is_empty()) {
+		return ERR_PARSE_ERROR;
+	}
+	value = Variant();
+
+	if (stack.is_empty()) {
+		if (!root_read) {
+			root_read = true;
+			return _read_value();
+		}
+
+		_skip_whitespace();
+		if (_has_data()) {
+			return _set_error("Expected 'EOF'");
+		}
+		token_type = TOKEN_NONE;
+		return ERR_FILE_EOF;
+	}
+
+	Frame &top = stack[stack.size() - 1];
+	if (top.expect_value) {
+		top.expect_value = false;
+		return _read_value();
+	}
+
+	_skip_whitespace();
+	int c = _peek();
+	if (c == (top.object ? '}' : ']')) {
+		pos++;
+		token_type = top.object ? TOKEN_OBJECT_END : TOKEN_ARRAY_END;
+		stack.resize(stack.size() - 1);
+		return OK;
+	}
+
+	if (top.has_items) {
+		if (c != ',') {
+			return _set_error(top.object ? "Expected '}' or ','" : "Expected ','");
+		}
+		pos++;
+		_skip_whitespace();
+		c = _peek();
+	}
+	top.has_items = true;
+
+	if (!top.object) {
+		return _read_value();
+	}
+
+	if (c != '"') {
+		return _set_error("Expected key");
+	}
+	if (!_read_string()) {
+		return ERR_PARSE_ERROR;
+	}
+	_skip_whitespace();
+	if (_peek() != ':') {
+		return _set_error("Expected ':'");
+	}
+	pos++;
+	top.expect_value = true;
+	token_type = TOKEN_KEY;
+	return OK;
+}
+
+JSONReader::TokenType JSONReader::get_token_type() const {
+	return token_type;
+}
+
+Variant JSONReader::get_value() const {
+	return value;
+}
+
+int JSONReader::get_depth() const {
+	return stack.size();
+}
+
+int JSONReader::get_current_line() const {
+	return current_line;
+}
+
+String JSONReader::get_error_message() const {
+	return err_str;
+}
+
+Variant JSONReader::read_value() {
+	if (token_type == TOKEN_KEY && read() != OK) {
+		return Variant();
+	}
+	if (token_type == TOKEN_VALUE) {
+		return value;
+	}
+	ERR_FAIL_COND_V_MSG(token_type != TOKEN_OBJECT_BEGIN && token_type != TOKEN_ARRAY_BEGIN, Variant(), "The current token doesn't start a value.");
+
+	// The containers being filled are kept on a stack rather than parsed recursively.
+	LocalVector<Variant> containers;
+	LocalVector<String> keys;
+	containers.push_back(token_type == TOKEN_OBJECT_BEGIN ? Variant(Dictionary()) : Variant(Array()));
+	keys.push_back(String());
+
+	while (true) {
+		if (read() != OK) {
+			return Variant();
+		}
+
+		Variant v;
+		switch (token_type) {
+			case TOKEN_KEY: {
+				keys[keys.size() - 1] = value;
+				continue;
+			}
+			case TOKEN_OBJECT_BEGIN:
+			case TOKEN_ARRAY_BEGIN: {
+				containers.push_back(token_type == TOKEN_OBJECT_BEGIN ? Variant(Dictionary()) : Variant(Array()));
+				keys.push_back(String());
+				continue;
+			}
+			case TOKEN_OBJECT_END:
+			case TOKEN_ARRAY_END: {
+				v = containers[containers.size() - 1];
+				containers.resize(containers.size() - 1);
+				keys.resize(keys.size() - 1);
+				if (containers.is_empty()) {
+					return v;
+				}
+			} break;
+			case TOKEN_VALUE: {
+				v = value;
+			} break;
+			default: {
+				return Variant();
+			}
+		}
+
+		const Variant &parent = containers[containers.size() - 1];
+		if (parent.get_type() == Variant::DICTIONARY) {
+			Dictionary d = parent;
+			d[keys[keys.size() - 1]] = v;
+		} else {
+			Array a = parent;
+			a.push_back(v);
+		}
+	}
+}
+
+void JSONReader::skip_section() {
+	if (token_type == TOKEN_KEY && read() != OK) {
+		return;
+	}
+	if (token_type != TOKEN_OBJECT_BEGIN && token_type != TOKEN_ARRAY_BEGIN) {
+		return;
+	}
+
+	// Only the structure is followed, the skipped content isn't decoded nor validated.
+	int depth = 1;
+	while (true) {
+		if (!_has_data()) {
+			_set_error("Unexpected end of file.");
+			return;
+		}
+
+		const uint8_t c = data[pos];
+		switch (c) {
+			case '\n': {
+				current_line++;
+				pos++;
+			} break;
+			case '{':
+			case '[': {
+				depth++;
+				pos++;
+			} break;
+			case '}':
+			case ']': {
+				depth--;
+				pos++;
+				if (depth == 0) {
+					token_type = c == '}' ? TOKEN_OBJECT_END : TOKEN_ARRAY_END;
+					stack.resize(stack.size() - 1);
+					return;
+				}
+			} break;
+			case '"': {
+				if (!_skip_string()) {
+					return;
+				}
+			} break;
+			default: {
+				pos++;
+			} break;
+		}
+	}
+}
+
+Error JSONReader::open(const String &p_path) {
+	close();
+
+	Error err;
+	file = FileAccess::open(p_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(file.is_null(), err, "Cannot open file '" + p_path + "'.");
+
+	// Files mapped in memory are read in place, others are read by chunks.
+	const uint64_t file_length = file->get_length();
+	data = file->get_mapped_buffer(file_length);
+	if (data) {
+		length = file_length;
+	} else {
+		buffer.resize(CHUNK_SIZE);
+	}
+
+	// Skip the UTF-8 BOM.
+	if (_has_data() && length >= 3 && data[0] == 0xef && data[1] == 0xbb && data[2] == 0xbf) {
+		pos = 3;
+	}
+
+	return OK;
+}
+
+Error JSONReader::open_buffer(const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_COND_V(p_buffer.is_empty(), ERR_INVALID_DATA);
+	close();
+
+	buffer = p_buffer;
+	data = buffer.ptr();
+	length = buffer.size();
+	return OK;
+}
+
+void JSONReader::close() {
+	file.unref();
+	buffer.clear();
+	data = nullptr;
+	length = 0;
+	pos = 0;
+
+	stack.clear();
+	root_read = false;
+	token_type = TOKEN_NONE;
+	value = Variant();
+	current_line = 0;
+	err_str = String();
+}
+
+void JSONReader::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("read"), &JSONReader::read);
+	ClassDB::bind_method(D_METHOD("get_token_type"), &JSONReader::get_token_type);
+	ClassDB::bind_method(D_METHOD("get_value"), &JSONReader::get_value);
+	ClassDB::bind_method(D_METHOD("get_depth"), &JSONReader::get_depth);
+	ClassDB::bind_method(D_METHOD("get_current_line"), &JSONReader::get_current_line);
+	ClassDB::bind_method(D_METHOD("get_error_message"), &JSONReader::get_error_message);
+	ClassDB::bind_method(D_METHOD("read_value"), &JSONReader::read_value);
+	ClassDB::bind_method(D_METHOD("skip_section"), &JSONReader::skip_section);
+	ClassDB::bind_method(D_METHOD("open", "file"), &JSONReader::open);
+	ClassDB::bind_method(D_METHOD("open_buffer", "buffer"), &JSONReader::open_buffer);
+	ClassDB::bind_method(D_METHOD("close"), &JSONReader::close);
+
+	BIND_ENUM_CONSTANT(TOKEN_NONE);
+	BIND_ENUM_CONSTANT(TOKEN_OBJECT_BEGIN);
+	BIND_ENUM_CONSTANT(TOKEN_OBJECT_END);
+	BIND_ENUM_CONSTANT(TOKEN_ARRAY_BEGIN);
+	BIND_ENUM_CONSTANT(TOKEN_ARRAY_END);
+	BIND_ENUM_CONSTANT(TOKEN_KEY);
+	BIND_ENUM_CONSTANT(TOKEN_VALUE);
+}
@@ -0,0 +1,118 @@
+/**************************************************************************/
+/*  json_reader.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include "core/io/file_access.h"
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+// Pull parser for JSON documents too large to be loaded at once with JSON.
+// Files are read in chunks and only the current key or value is decoded.
+class JSONReader : public RefCounted {
+	GDCLASS(JSONReader, RefCounted);
+
+public:
+	enum TokenType {
+		TOKEN_NONE,
+		TOKEN_OBJECT_BEGIN,
+		TOKEN_OBJECT_END,
+		TOKEN_ARRAY_BEGIN,
+		TOKEN_ARRAY_END,
+		TOKEN_KEY,
+		TOKEN_VALUE,
+	};
+
+private:
+	static const uint32_t CHUNK_SIZE = 65536;
+
+	struct Frame {
+		bool object = false;
+		bool has_items = false;
+		bool expect_value = false;
+	};
+
+	Ref<FileAccess> file;
+	Vector<uint8_t> buffer;
+	const uint8_t *data = nullptr;
+	uint64_t length = 0;
+	uint64_t pos = 0;
+
+	LocalVector<Frame> stack;
+	LocalVector<char> string_buffer;
+	bool root_read = false;
+
+	TokenType token_type = TOKEN_NONE;
+	Variant value;
+	int current_line = 0;
+	String err_str;
+
+	bool _fill();
+	_FORCE_INLINE_ bool _has_data() {
+		return pos < length || _fill();
+	}
+	_FORCE_INLINE_ int _peek() {
+		return _has_data() ? data[pos] : -1;
+	}
+
+	void _skip_whitespace();
+	void _skip_plain_string();
+	bool _read_hex(char32_t &r_value);
+	bool _read_string();
+	bool _skip_string();
+	bool _read_number();
+	bool _read_literal();
+	Error _read_value();
+	Error _set_error(const String &p_message);
+
+protected:
+	static void _bind_methods();
+
+public:
+	Error read();
+	TokenType get_token_type() const;
+	Variant get_value() const;
+	int get_depth() const;
+	int get_current_line() const;
+	String get_error_message() const;
+
+	Variant read_value();
+	void skip_section();
+
+	Error open(const String &p_path);
+	Error open_buffer(const Vector<uint8_t> &p_buffer);
+	void close();
+};
+
+VARIANT_ENUM_CAST(JSONReader::TokenType);
+
+#endif // JSON_READER_H
@@ -33,6 +33,7 @@
 #include "core/object/ref_counted.h"
 #include "core/os/keyboard.h"
 #include "core/string/print_string.h"
+#include "core/templates/local_vector.h"
 
 #include <limits.h>
 #include <stdio.h>
@@ -58,6 +59,41 @@ ObjectID EncodedObjectAsID::get_object_id() const {
 #define ENCODE_MASK 0xFF
 #define ENCODE_FLAG_64 1 << 16
 #define ENCODE_FLAG_OBJECT_AS_ID 1 << 16
+#define ENCODE_FLAG_COMPACT 1 << 17
+
+// Compact integers are zigzag encoded, then stored as variable-length unsigned integers.
+#define VARINT_MAX_SIZE 10
+
+static _FORCE_INLINE_ int _encode_varint(int64_t p_value, uint8_t *p_arr) {
+	return encode_varuint(((uint64_t)p_value << 1) ^ (uint64_t)(p_value >> 63), p_arr);
+}
+
+static _FORCE_INLINE_ bool _decode_varint(const uint8_t *p_arr, int p_len, int &r_used, int64_t &r_value) {
+	uint64_t v;
+	if (!decode_varuint(p_arr, p_len, r_used, v)) {
+		return false;
+	}
+	r_value = int64_t(v >> 1) ^ -int64_t(v & 1);
+	return true;
+}
+
+// Decodes p_count compact integers, followed by padding to 4 bytes.
+template <typename T>
+static Error _decode_compact_ints(const uint8_t *p_buffer, int p_len, int32_t p_count, T *r_values, int &r_used) {
+	int ofs = 0;
+	for (int32_t i = 0; i < p_count; i++) {
+		int used;
+		int64_t value;
+		ERR_FAIL_COND_V(!_decode_varint(p_buffer + ofs, p_len - ofs, used, value), ERR_INVALID_DATA);
+		r_values[i] = value;
+		ofs += used;
+	}
+
+	ofs += (4 - ofs % 4) % 4;
+	ERR_FAIL_COND_V(ofs > p_len, ERR_INVALID_DATA);
+	r_used = ofs;
+	return OK;
+}
 
 static Error _decode_string(const uint8_t *&buf, int &len, int *r_len, String &r_string) {
 	ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
@@ -759,6 +795,43 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			Array varr;
 
+			if (type & ENCODE_FLAG_COMPACT) {
+				// Typed arrays of numbers, stored without the header of each element.
+				ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
+				const uint32_t element_type = decode_uint32(buf);
+				buf += 4;
+				len -= 4;
+				ERR_FAIL_COND_V(element_type != Variant::INT && element_type != Variant::FLOAT, ERR_INVALID_DATA);
+				ERR_FAIL_COND_V(count > len, ERR_INVALID_DATA);
+
+				varr.set_typed(element_type, StringName(), Variant());
+				varr.resize(count);
+
+				int used;
+				if (element_type == Variant::INT) {
+					LocalVector<int64_t> values;
+					values.resize(count);
+					Error err = _decode_compact_ints(buf, len, count, values.ptr(), used);
+					ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
+					for (int i = 0; i < count; i++) {
+						varr[i] = values[i];
+					}
+				} else {
+					ERR_FAIL_MUL_OF(count, 8, ERR_INVALID_DATA);
+					ERR_FAIL_COND_V(count * 8 > len, ERR_INVALID_DATA);
+					used = count * 8;
+					for (int i = 0; i < count; i++) {
+						varr[i] = decode_double(buf + i * 8);
+					}
+				}
+
+				r_variant = varr;
+				if (r_len) {
+					(*r_len) += 4 + used;
+				}
+				break;
+			}
+
 			for (int i = 0; i < count; i++) {
 				int used = 0;
 				Variant v;
@@ -809,18 +882,35 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			int32_t count = decode_uint32(buf);
 			buf += 4;
 			len -= 4;
-			ERR_FAIL_MUL_OF(count, 4, ERR_INVALID_DATA);
-			ERR_FAIL_COND_V(count < 0 || count * 4 > len, ERR_INVALID_DATA);
 
 			Vector<int32_t> data;
 
+			if (type & ENCODE_FLAG_COMPACT) {
+				ERR_FAIL_COND_V(count < 0 || count > len, ERR_INVALID_DATA);
+				data.resize(count);
+				int used;
+				Error err = _decode_compact_ints(buf, len, count, data.ptrw(), used);
+				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
+				r_variant = Variant(data);
+				if (r_len) {
+					(*r_len) += 4 + used;
+				}
+				break;
+			}
+
+			ERR_FAIL_MUL_OF(count, 4, ERR_INVALID_DATA);
+			ERR_FAIL_COND_V(count < 0 || count * 4 > len, ERR_INVALID_DATA);
+
 			if (count) {
-				//const int*rbuf=(const int*)buf;
 				data.resize(count);
 				int32_t *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_uint32(&buf[i * 4]);
 				}
+#else
+				memcpy(w, buf, count * 4);
+#endif
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -833,18 +923,35 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			int32_t count = decode_uint32(buf);
 			buf += 4;
 			len -= 4;
-			ERR_FAIL_MUL_OF(count, 8, ERR_INVALID_DATA);
-			ERR_FAIL_COND_V(count < 0 || count * 8 > len, ERR_INVALID_DATA);
 
 			Vector<int64_t> data;
 
+			if (type & ENCODE_FLAG_COMPACT) {
+				ERR_FAIL_COND_V(count < 0 || count > len, ERR_INVALID_DATA);
+				data.resize(count);
+				int used;
+				Error err = _decode_compact_ints(buf, len, count, data.ptrw(), used);
+				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
+				r_variant = Variant(data);
+				if (r_len) {
+					(*r_len) += 4 + used;
+				}
+				break;
+			}
+
+			ERR_FAIL_MUL_OF(count, 8, ERR_INVALID_DATA);
+			ERR_FAIL_COND_V(count < 0 || count * 8 > len, ERR_INVALID_DATA);
+
 			if (count) {
-				//const int*rbuf=(const int*)buf;
 				data.resize(count);
 				int64_t *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int64_t i = 0; i < count; i++) {
 					w[i] = decode_uint64(&buf[i * 8]);
 				}
+#else
+				memcpy(w, buf, count * 8);
+#endif
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -863,12 +970,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<float> data;
 
 			if (count) {
-				//const float*rbuf=(const float*)buf;
 				data.resize(count);
 				float *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_float(&buf[i * 4]);
 				}
+#else
+				memcpy(w, buf, count * 4);
+#endif
 			}
 			r_variant = data;
 
@@ -890,9 +1000,13 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			if (count) {
 				data.resize(count);
 				double *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int64_t i = 0; i < count; i++) {
 					w[i] = decode_double(&buf[i * 8]);
 				}
+#else
+				memcpy(w, buf, count * 8);
+#endif
 			}
 			r_variant = data;
 
@@ -1069,6 +1183,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				carray.resize(count);
 				Color *w = carray.ptrw();
 
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < count; i++) {
 					// Colors should always be in single-precision.
 					w[i].r = decode_float(buf + i * 4 * 4 + 4 * 0);
@@ -1076,6 +1191,10 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					w[i].b = decode_float(buf + i * 4 * 4 + 4 * 2);
 					w[i].a = decode_float(buf + i * 4 * 4 + 4 * 3);
 				}
+#else
+				static_assert(sizeof(Color) == 4 * 4);
+				memcpy(w, buf, count * 4 * 4);
+#endif
 
 				int adv = 4 * 4 * count;
 
@@ -1641,9 +1760,13 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_uint32(datalen, buf);
 				buf += 4;
 				const int32_t *r = data.ptr();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < datalen; i++) {
 					encode_uint32(r[i], &buf[i * datasize]);
 				}
+#else
+				memcpy(buf, r, datalen * datasize);
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1658,9 +1781,13 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_uint32(datalen, buf);
 				buf += 4;
 				const int64_t *r = data.ptr();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int64_t i = 0; i < datalen; i++) {
 					encode_uint64(r[i], &buf[i * datasize]);
 				}
+#else
+				memcpy(buf, r, datalen * datasize);
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1675,9 +1802,13 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_uint32(datalen, buf);
 				buf += 4;
 				const float *r = data.ptr();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int i = 0; i < datalen; i++) {
 					encode_float(r[i], &buf[i * datasize]);
 				}
+#else
+				memcpy(buf, r, datalen * datasize);
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1692,9 +1823,13 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_uint32(datalen, buf);
 				buf += 4;
 				const double *r = data.ptr();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int i = 0; i < datalen; i++) {
 					encode_double(r[i], &buf[i * datasize]);
 				}
+#else
+				memcpy(buf, r, datalen * datasize);
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1792,6 +1927,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			if (buf) {
+#ifdef BIG_ENDIAN_ENABLED
 				for (int i = 0; i < len; i++) {
 					Color c = data.get(i);
 
@@ -1801,6 +1937,10 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 					encode_float(c.a, &buf[12]);
 					buf += 4 * 4; // Colors should always be in single-precision.
 				}
+#else
+				memcpy(buf, data.ptr(), len * 4 * 4);
+				buf += len * 4 * 4;
+#endif
 			}
 
 			r_len += 4 * 4 * len;
@@ -1814,6 +1954,254 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 	return OK;
 }
 
+// Output of the single-pass encoder, grown as needed and never shrunk so it can be reused.
+struct EncodeBuffer {
+	Vector<uint8_t> &data;
+	uint8_t *ptr = nullptr;
+	int len = 0;
+	int max_size = INT_MAX;
+
+	// Makes room for p_size more bytes without using them, and returns where to write them.
+	// Returns null, without growing, if the output would get larger than max_size.
+	_FORCE_INLINE_ uint8_t *reserve(int p_size) {
+		if (unlikely((int64_t)len + p_size > data.size())) {
+			if ((int64_t)len + p_size > max_size) {
+				return nullptr;
+			}
+			data.resize(MIN((int64_t)next_power_of_2(len + p_size), (int64_t)max_size));
+			ptr = data.ptrw();
+		}
+		return ptr + len;
+	}
+
+	_FORCE_INLINE_ uint8_t *append(int p_size) {
+		uint8_t *w = reserve(p_size);
+		if (likely(w)) {
+			len += p_size;
+		}
+		return w;
+	}
+
+	EncodeBuffer(Vector<uint8_t> &p_data, int p_max_size) :
+			data(p_data), max_size(p_max_size) {
+		ptr = data.ptrw();
+	}
+};
+
+// Largest encoding of the types which don't contain other values, a double-precision Projection.
+#define ENCODE_FIXED_MAX_SIZE (4 + 16 * 8)
+
+template <typename T>
+static Error _encode_compact_ints(const T *p_values, int p_count, EncodeBuffer &r_buffer) {
+	uint8_t *w = r_buffer.reserve(p_count * VARINT_MAX_SIZE + 3);
+	if (unlikely(!w)) {
+		// Too close to the size limit for the worst case, reserve the exact size.
+		uint8_t scratch[VARINT_MAX_SIZE];
+		int needed = 0;
+		for (int i = 0; i < p_count; i++) {
+			needed += _encode_varint(p_values[i], scratch);
+		}
+		w = r_buffer.reserve(needed + 3);
+		if (!w) {
+			return ERR_OUT_OF_MEMORY;
+		}
+	}
+	int size = 0;
+	for (int i = 0; i < p_count; i++) {
+		size += _encode_varint(p_values[i], w + size);
+	}
+	while (size % 4) {
+		w[size++] = 0; // pad
+	}
+	r_buffer.len += size;
+	return OK;
+}
+
+static Error _encode_variant_buffered(const Variant &p_variant, EncodeBuffer &r_buffer, bool p_full_objects, bool p_compact, int p_depth) {
+	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
+
+	const Variant::Type type = p_variant.get_type();
+	switch (type) {
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			const CharString utf8 = String(p_variant).utf8();
+			const int pad = (4 - utf8.length() % 4) % 4;
+
+			uint8_t *w = r_buffer.append(8 + utf8.length() + pad);
+			if (unlikely(!w)) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(type, w);
+			encode_uint32(utf8.length(), w + 4);
+			memcpy(w + 8, utf8.get_data(), utf8.length());
+			memset(w + 8 + utf8.length(), 0, pad);
+		} break;
+		case Variant::ARRAY: {
+			const Array array = p_variant;
+			const int count = array.size();
+			const uint32_t element_type = array.get_typed_builtin();
+
+			if (p_compact && array.is_typed() && (element_type == Variant::INT || element_type == Variant::FLOAT)) {
+				// Elements are known to be numbers, so their headers are left out.
+				uint8_t *w = r_buffer.append(12);
+				if (unlikely(!w)) {
+					return ERR_OUT_OF_MEMORY;
+				}
+				encode_uint32(Variant::ARRAY | ENCODE_FLAG_COMPACT, w);
+				encode_uint32(count, w + 4);
+				encode_uint32(element_type, w + 8);
+
+				if (element_type == Variant::INT) {
+					LocalVector<int64_t> values;
+					values.resize(count);
+					for (int i = 0; i < count; i++) {
+						values[i] = array[i];
+					}
+					Error err = _encode_compact_ints(values.ptr(), count, r_buffer);
+					if (err != OK) {
+						return err;
+					}
+				} else {
+					w = r_buffer.append(count * 8);
+					if (unlikely(!w)) {
+						return ERR_OUT_OF_MEMORY;
+					}
+					for (int i = 0; i < count; i++) {
+						encode_double(array[i], w + i * 8);
+					}
+				}
+				break;
+			}
+
+			uint8_t *w = r_buffer.append(8);
+			if (unlikely(!w)) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(Variant::ARRAY, w);
+			encode_uint32(count, w + 4);
+			for (int i = 0; i < count; i++) {
+				Error err = _encode_variant_buffered(array[i], r_buffer, p_full_objects, p_compact, p_depth + 1);
+				if (err != OK) {
+					return err;
+				}
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			const Dictionary d = p_variant;
+
+			uint8_t *w = r_buffer.append(8);
+			if (unlikely(!w)) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(Variant::DICTIONARY, w);
+			encode_uint32(uint32_t(d.size()), w + 4);
+
+			List<Variant> keys;
+			d.get_key_list(&keys);
+
+			for (const Variant &E : keys) {
+				Error err = _encode_variant_buffered(E, r_buffer, p_full_objects, p_compact, p_depth + 1);
+				if (err != OK) {
+					return err;
+				}
+				const Variant *v = d.getptr(E);
+				ERR_FAIL_COND_V(!v, ERR_BUG);
+				err = _encode_variant_buffered(*v, r_buffer, p_full_objects, p_compact, p_depth + 1);
+				if (err != OK) {
+					return err;
+				}
+			}
+		} break;
+		case Variant::PACKED_INT32_ARRAY:
+		case Variant::PACKED_INT64_ARRAY: {
+			if (p_compact) {
+				uint8_t *w = r_buffer.append(8);
+				if (unlikely(!w)) {
+					return ERR_OUT_OF_MEMORY;
+				}
+				encode_uint32(type | ENCODE_FLAG_COMPACT, w);
+				if (type == Variant::PACKED_INT32_ARRAY) {
+					const Vector<int32_t> data = p_variant;
+					encode_uint32(data.size(), w + 4);
+					Error err = _encode_compact_ints(data.ptr(), data.size(), r_buffer);
+					if (err != OK) {
+						return err;
+					}
+				} else {
+					const Vector<int64_t> data = p_variant;
+					encode_uint32(data.size(), w + 4);
+					Error err = _encode_compact_ints(data.ptr(), data.size(), r_buffer);
+					if (err != OK) {
+						return err;
+					}
+				}
+				break;
+			}
+			[[fallthrough]];
+		}
+		case Variant::NODE_PATH:
+		case Variant::SIGNAL:
+		case Variant::PACKED_BYTE_ARRAY:
+		case Variant::PACKED_FLOAT32_ARRAY:
+		case Variant::PACKED_FLOAT64_ARRAY:
+		case Variant::PACKED_STRING_ARRAY:
+		case Variant::PACKED_VECTOR2_ARRAY:
+		case Variant::PACKED_VECTOR3_ARRAY:
+		case Variant::PACKED_COLOR_ARRAY: {
+			// Types of variable size which are cheap to measure, or rare, are measured first.
+			int len;
+			Error err = encode_variant(p_variant, nullptr, len, p_full_objects, p_depth);
+			ERR_FAIL_COND_V(err, err);
+			uint8_t *w = r_buffer.append(len);
+			if (unlikely(!w)) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			err = encode_variant(p_variant, w, len, p_full_objects, p_depth);
+			ERR_FAIL_COND_V(err, err);
+		} break;
+		case Variant::OBJECT: {
+			if (p_full_objects) {
+				int len;
+				Error err = encode_variant(p_variant, nullptr, len, p_full_objects, p_depth);
+				ERR_FAIL_COND_V(err, err);
+				uint8_t *w = r_buffer.append(len);
+				if (unlikely(!w)) {
+					return ERR_OUT_OF_MEMORY;
+				}
+				err = encode_variant(p_variant, w, len, p_full_objects, p_depth);
+				ERR_FAIL_COND_V(err, err);
+				break;
+			}
+			[[fallthrough]];
+		}
+		default: {
+			int len;
+			uint8_t *w = r_buffer.reserve(ENCODE_FIXED_MAX_SIZE);
+			if (unlikely(!w)) {
+				// Too close to the size limit for the largest value, reserve the exact size.
+				Error err = encode_variant(p_variant, nullptr, len, p_full_objects, p_depth);
+				ERR_FAIL_COND_V(err, err);
+				w = r_buffer.reserve(len);
+				if (!w) {
+					return ERR_OUT_OF_MEMORY;
+				}
+			}
+			Error err = encode_variant(p_variant, w, len, p_full_objects, p_depth);
+			ERR_FAIL_COND_V(err, err);
+			r_buffer.len += len;
+		} break;
+	}
+
+	return OK;
+}
+
+Error encode_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer, int &r_len, bool p_full_objects, bool p_compact, int p_max_size) {
+	EncodeBuffer buffer(r_buffer, p_max_size);
+	Error err = _encode_variant_buffered(p_variant, buffer, p_full_objects, p_compact, 0);
+	r_len = err == OK ? buffer.len : 0;
+	return err;
+}
+
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count) {
 	// We always allocate a new array, and we don't memcpy.
 	// We also don't consider returning a pointer to the passed vectors when sizeof(real_t) == 4.
@@ -146,6 +146,20 @@ static inline int encode_cstring(const char *p_string, uint8_t *p_data) {
 	return len + 1;
 }
 
+// Unsigned LEB128, 7 bits per byte. Pass a null array to only get the encoded size.
+static inline int encode_varuint(uint64_t p_uint, uint8_t *p_arr) {
+	int len = 0;
+	do {
+		uint8_t byte = p_uint & 0x7F;
+		p_uint >>= 7;
+		if (p_arr) {
+			p_arr[len] = byte | (p_uint ? 0x80 : 0);
+		}
+		len++;
+	} while (p_uint);
+	return len;
+}
+
 static inline uint16_t decode_uint16(const uint8_t *p_arr) {
 	uint16_t u = 0;
 
@@ -197,6 +211,19 @@ static inline double decode_double(const uint8_t *p_arr) {
 	return md.d;
 }
 
+// Returns false when the buffer ends before the value does, or the value is longer than 64 bits.
+static inline bool decode_varuint(const uint8_t *p_arr, int p_len, int &r_used, uint64_t &r_uint) {
+	r_uint = 0;
+	for (int i = 0; i < p_len && i < 10; i++) {
+		r_uint |= uint64_t(p_arr[i] & 0x7F) << (7 * i);
+		if (!(p_arr[i] & 0x80)) {
+			r_used = i + 1;
+			return true;
+		}
+	}
+	return false;
+}
+
 class EncodedObjectAsID : public RefCounted {
 	GDCLASS(EncodedObjectAsID, RefCounted);
 
@@ -214,6 +241,10 @@ public:
 
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false, int p_depth = 0);
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, int p_depth = 0);
+// Encodes in a single pass at the start of r_buffer, which is grown as needed and never shrunk, so it can be reused.
+// In compact mode, integer arrays are stored as variable-length integers, which older versions can't decode.
+// Fails with ERR_OUT_OF_MEMORY, without growing r_buffer past it, if the encoding is larger than p_max_size.
+Error encode_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer, int &r_len, bool p_full_objects = false, bool p_compact = false, int p_max_size = INT_MAX);
 
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count);
 
@@ -31,11 +31,14 @@
 #include "pck_packer.h"
 
 #include "core/crypto/crypto_core.h"
+#include "core/io/compression.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
-#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION_V2, PACK_FORMAT_VERSION_V3
 #include "core/version.h"
 
+#include <zstd.h>
+
 static int _get_pad(int p_alignment, int p_n) {
 	int rest = p_n % p_alignment;
 	int pad = 0;
@@ -50,6 +53,7 @@ void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_name", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("set_compression", "enabled", "block_size", "dictionary_size"), &PCKPacker::set_compression, DEFVAL(65536), DEFVAL(0));
 }
 
 Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &p_key, bool p_encrypt_directory) {
@@ -89,15 +93,18 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 	alignment = p_alignment;
 
 	file->store_32(PACK_HEADER_MAGIC);
-	file->store_32(PACK_FORMAT_VERSION);
+	// Stays readable by older versions unless compressed files are added.
+	format_version_ofs = file->get_position();
+	file->store_32(PACK_FORMAT_VERSION_V2);
 	file->store_32(VERSION_MAJOR);
 	file->store_32(VERSION_MINOR);
 	file->store_32(VERSION_PATCH);
 
-	uint32_t pack_flags = 0;
+	pack_flags = 0;
 	if (enc_dir) {
 		pack_flags |= PACK_DIR_ENCRYPTED;
 	}
+	pack_flags_ofs = file->get_position();
 	file->store_32(pack_flags); // flags
 
 	files.clear();
@@ -106,6 +113,15 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 	return OK;
 }
 
+void PCKPacker::set_compression(bool p_enabled, int p_block_size, int p_dictionary_size) {
+	ERR_FAIL_COND_MSG(p_block_size <= 0, "Invalid block size, must be greater than 0.");
+	ERR_FAIL_COND_MSG(p_dictionary_size < 0, "Invalid dictionary size, must be positive.");
+
+	compress = p_enabled;
+	block_size = p_block_size;
+	dictionary_size = p_dictionary_size;
+}
+
 Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encrypt) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
@@ -130,6 +146,7 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 		}
 	}
 	pf.encrypted = p_encrypt;
+	pf.compressed = compress && !p_encrypt;
 
 	uint64_t _size = pf.size;
 	if (p_encrypt) { // Add encryption overhead.
@@ -149,19 +166,7 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 	return OK;
 }
 
-Error PCKPacker::flush(bool p_verbose) {
-	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
-
-	int64_t file_base_ofs = file->get_position();
-	file->store_64(0); // files base
-
-	for (int i = 0; i < 16; i++) {
-		file->store_32(0); // reserved
-	}
-
-	// write the index
-	file->store_32(files.size());
-
+Error PCKPacker::_store_directory() {
 	Ref<FileAccessEncrypted> fae;
 	Ref<FileAccess> fhead = file;
 
@@ -193,6 +198,9 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -201,6 +209,126 @@ Error PCKPacker::flush(bool p_verbose) {
 		fae.unref();
 	}
 
+	return OK;
+}
+
+Vector<uint8_t> PCKPacker::_build_dictionary() const {
+	// zstd's dictionary trainer isn't bundled, so the dictionary is raw content
+	// sampled from the start of the files, which the blocks can refer to like
+	// data that came before them.
+	int compressed_count = 0;
+	for (int i = 0; i < files.size(); i++) {
+		if (files[i].compressed && files[i].size > 0) {
+			compressed_count++;
+		}
+	}
+
+	Vector<uint8_t> dictionary;
+	if (compressed_count == 0) {
+		return dictionary;
+	}
+
+	const uint64_t sample_size = MAX(dictionary_size / compressed_count, 64u);
+	for (int i = 0; i < files.size() && (uint64_t)dictionary.size() < dictionary_size; i++) {
+		if (!files[i].compressed || files[i].size == 0) {
+			continue;
+		}
+
+		Ref<FileAccess> src = FileAccess::open(files[i].src_path, FileAccess::READ);
+		ERR_CONTINUE(src.is_null());
+
+		const uint64_t length = MIN(MIN(sample_size, files[i].size), dictionary_size - dictionary.size());
+		const int64_t dictionary_end = dictionary.size();
+		dictionary.resize(dictionary_end + length);
+		const uint64_t read = src->get_buffer(dictionary.ptrw() + dictionary_end, length);
+		dictionary.resize(dictionary_end + read);
+	}
+
+	return dictionary;
+}
+
+Error PCKPacker::_store_compressed(Ref<FileAccess> p_src, uint64_t p_size, ZSTD_CCtx_s *p_cctx, const ZSTD_CDict_s *p_cdict) {
+	const uint32_t block_count = (p_size + block_size - 1) / block_size;
+	file->store_32(block_size);
+	file->store_32(block_count);
+
+	// The end of each block is only known once it's compressed.
+	const uint64_t table_ofs = file->get_position();
+	for (uint32_t i = 0; i < block_count; i++) {
+		file->store_64(0);
+	}
+
+	Vector<uint8_t> src_block;
+	src_block.resize(block_size);
+	Vector<uint8_t> dst_block;
+	dst_block.resize(ZSTD_compressBound(block_size));
+
+	LocalVector<uint64_t> block_ends;
+	block_ends.reserve(block_count);
+	uint64_t written = 0;
+	for (uint32_t i = 0; i < block_count; i++) {
+		const uint64_t length = MIN((uint64_t)block_size, p_size - (uint64_t)i * block_size);
+		ERR_FAIL_COND_V(p_src->get_buffer(src_block.ptrw(), length) != length, ERR_FILE_CANT_READ);
+
+		size_t compressed_size;
+		if (p_cdict) {
+			compressed_size = ZSTD_compress_usingCDict(p_cctx, dst_block.ptrw(), dst_block.size(), src_block.ptr(), length, p_cdict);
+		} else {
+			compressed_size = ZSTD_compressCCtx(p_cctx, dst_block.ptrw(), dst_block.size(), src_block.ptr(), length, Compression::zstd_level);
+		}
+
+		// Blocks which don't get smaller are stored as is, the reader tells them apart by their size.
+		if (ZSTD_isError(compressed_size) || compressed_size >= length) {
+			file->store_buffer(src_block.ptr(), length);
+			written += length;
+		} else {
+			file->store_buffer(dst_block.ptr(), compressed_size);
+			written += compressed_size;
+		}
+		block_ends.push_back(written);
+	}
+
+	const uint64_t end_ofs = file->get_position();
+	file->seek(table_ofs);
+	for (const uint64_t &block_end : block_ends) {
+		file->store_64(block_end);
+	}
+	file->seek(end_ofs);
+
+	return OK;
+}
+
+Error PCKPacker::flush(bool p_verbose) {
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
+
+	bool has_compressed_files = false;
+	for (int i = 0; i < files.size(); i++) {
+		has_compressed_files = has_compressed_files || files[i].compressed;
+	}
+
+	Vector<uint8_t> dictionary;
+	if (has_compressed_files && dictionary_size > 0) {
+		dictionary = _build_dictionary();
+	}
+
+	int64_t file_base_ofs = file->get_position();
+	file->store_64(0); // files base
+
+	file->store_64(0); // dictionary offset, relative to the files base
+	file->store_64(dictionary.size()); // dictionary size
+	for (int i = 0; i < 12; i++) {
+		file->store_32(0); // reserved
+	}
+
+	// write the index
+	file->store_32(files.size());
+
+	int64_t directory_ofs = file->get_position();
+	Error err = _store_directory();
+	if (err != OK) {
+		return err;
+	}
+
 	int header_padding = _get_pad(alignment, file->get_position());
 	for (int i = 0; i < header_padding; i++) {
 		file->store_8(Math::rand() % 256);
@@ -211,6 +339,30 @@ Error PCKPacker::flush(bool p_verbose) {
 	file->store_64(file_base); // update files base
 	file->seek(file_base);
 
+	ZSTD_CCtx *cctx = nullptr;
+	ZSTD_CDict *cdict = nullptr;
+	if (has_compressed_files) {
+		file->seek(format_version_ofs);
+		file->store_32(PACK_FORMAT_VERSION_V3);
+		file->seek(file_base);
+
+		cctx = ZSTD_createCCtx();
+		if (!dictionary.is_empty()) {
+			cdict = ZSTD_createCDict(dictionary.ptr(), dictionary.size(), Compression::zstd_level);
+
+			file->store_buffer(dictionary.ptr(), dictionary.size());
+			int pad = _get_pad(alignment, file->get_position());
+			for (int j = 0; j < pad; j++) {
+				file->store_8(Math::rand() % 256);
+			}
+
+			int64_t data_ofs = file->get_position();
+			file->seek(pack_flags_ofs);
+			file->store_32(pack_flags | PACK_ZSTD_DICTIONARY);
+			file->seek(data_ofs);
+		}
+	}
+
 	const uint32_t buf_max = 65536;
 	uint8_t *buf = memnew_arr(uint8_t, buf_max);
 
@@ -219,16 +371,28 @@ Error PCKPacker::flush(bool p_verbose) {
 		Ref<FileAccess> src = FileAccess::open(files[i].src_path, FileAccess::READ);
 		uint64_t to_write = files[i].size;
 
+		// The compressed sizes are not known in advance, so the offsets are updated as the files are written.
+		files.write[i].ofs = file->get_position() - file_base;
+
+		Ref<FileAccessEncrypted> fae;
 		Ref<FileAccess> ftmp = file;
 		if (files[i].encrypted) {
 			fae.instantiate();
 			ERR_FAIL_COND_V(fae.is_null(), ERR_CANT_CREATE);
 
-			Error err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
+			err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
 			ERR_FAIL_COND_V(err != OK, ERR_CANT_CREATE);
 			ftmp = fae;
 		}
 
+		if (files[i].compressed) {
+			err = _store_compressed(src, to_write, cctx, cdict);
+			if (err != OK) {
+				break;
+			}
+			to_write = 0;
+		}
+
 		while (to_write > 0) {
 			uint64_t read = src->get_buffer(buf, MIN(to_write, buf_max));
 			ftmp->store_buffer(buf, read);
@@ -252,8 +416,21 @@ Error PCKPacker::flush(bool p_verbose) {
 		}
 	}
 
-	file.unref();
+	if (cdict) {
+		ZSTD_freeCDict(cdict);
+	}
+	if (cctx) {
+		ZSTD_freeCCtx(cctx);
+	}
 	memdelete_arr(buf);
 
-	return OK;
+	if (err == OK && has_compressed_files) {
+		// Store the offsets of the files after the compressed ones, the directory keeps the same size.
+		file->seek(directory_ofs);
+		err = _store_directory();
+	}
+
+	file.unref();
+
+	return err;
 }
@@ -34,6 +34,8 @@
 #include "core/object/ref_counted.h"
 
 class FileAccess;
+struct ZSTD_CCtx_s;
+struct ZSTD_CDict_s;
 
 class PCKPacker : public RefCounted {
 	GDCLASS(PCKPacker, RefCounted);
@@ -44,6 +46,13 @@ class PCKPacker : public RefCounted {
 
 	Vector<uint8_t> key;
 	bool enc_dir = false;
+	uint32_t pack_flags = 0;
+	uint64_t pack_flags_ofs = 0;
+	uint64_t format_version_ofs = 0;
+
+	bool compress = false;
+	uint32_t block_size = 65536;
+	uint32_t dictionary_size = 0;
 
 	static void _bind_methods();
 
@@ -53,12 +62,18 @@ class PCKPacker : public RefCounted {
 		uint64_t ofs = 0;
 		uint64_t size = 0;
 		bool encrypted = false;
+		bool compressed = false;
 		Vector<uint8_t> md5;
 	};
 	Vector<File> files;
 
+	Error _store_directory();
+	Vector<uint8_t> _build_dictionary() const;
+	Error _store_compressed(Ref<FileAccess> p_src, uint64_t p_size, ZSTD_CCtx_s *p_cctx, const ZSTD_CDict_s *p_cdict);
+
 public:
 	Error pck_start(const String &p_file, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
+	void set_compression(bool p_enabled, int p_block_size = 65536, int p_dictionary_size = 0);
 	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false);
 	Error flush(bool p_verbose = false);
 
@@ -33,9 +33,11 @@
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/image.h"
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 
 //#define print_bl(m_what) print_line(m_what)
@@ -447,18 +449,9 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					} else {
 						if (external_resources[erindex].cache.is_null()) {
 							//cache not here yet, wait for it?
-							if (use_sub_threads) {
-								Error err;
-								external_resources.write[erindex].cache = ResourceLoader::load_threaded_get(external_resources[erindex].path, &err);
-
-								if (err != OK || external_resources[erindex].cache.is_null()) {
-									if (!ResourceLoader::get_abort_on_missing_resources()) {
-										ResourceLoader::notify_dependency_error(local_path, external_resources[erindex].path, external_resources[erindex].type);
-									} else {
-										error = ERR_FILE_MISSING_DEPENDENCIES;
-										ERR_FAIL_V_MSG(error, "Can't load dependency: " + external_resources[erindex].path + ".");
-									}
-								}
+							Error err = _resolve_external_resource(erindex);
+							if (err != OK) {
+								return err;
 							}
 						}
 
@@ -710,168 +703,307 @@ Error ResourceLoaderBinary::load() {
 		}
 	}
 
+	if (_can_parse_in_parallel()) {
+		return _load_internal_resources_parallel();
+	}
+
 	for (int i = 0; i < internal_resources.size(); i++) {
-		bool main = i == (internal_resources.size() - 1);
+		LoadedResource loaded;
+		error = _instantiate_internal_resource(i, loaded);
+		if (error) {
+			return error;
+		}
+		if (loaded.resource.is_null()) {
+			continue; // Already loaded.
+		}
 
-		//maybe it is loaded already
-		String path;
-		String id;
+		error = _parse_properties(loaded);
+		if (error) {
+			return error;
+		}
 
-		if (!main) {
-			path = internal_resources[i].path;
+		if (_finish_internal_resource(i, loaded)) {
+			return OK;
+		}
+	}
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
+	return ERR_FILE_EOF;
+}
 
-				internal_resources.write[i].path = path; // Update path.
-			}
+Error ResourceLoaderBinary::_resolve_external_resource(int p_index) {
+	if (!use_sub_threads) {
+		return OK;
+	}
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
-				}
-			}
+	Error err;
+	external_resources.write[p_index].cache = ResourceLoader::load_threaded_get(external_resources[p_index].path, &err);
+
+	if (err != OK || external_resources[p_index].cache.is_null()) {
+		if (!ResourceLoader::get_abort_on_missing_resources()) {
+			ResourceLoader::notify_dependency_error(local_path, external_resources[p_index].path, external_resources[p_index].type);
 		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
-			}
+			error = ERR_FILE_MISSING_DEPENDENCIES;
+			ERR_FAIL_V_MSG(error, "Can't load dependency: " + external_resources[p_index].path + ".");
 		}
+	}
+	return OK;
+}
 
-		uint64_t offset = internal_resources[i].offset;
+Error ResourceLoaderBinary::_instantiate_internal_resource(int p_index, LoadedResource &r_loaded) {
+	bool main = p_index == (internal_resources.size() - 1);
 
-		f->seek(offset);
+	//maybe it is loaded already
+	String path;
+	String id;
 
-		String t = get_unicode_string();
+	if (!main) {
+		path = internal_resources[p_index].path;
 
-		Ref<Resource> res;
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			id = path;
+			path = res_path + "::" + path;
 
-		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-			//use the existing one
+			internal_resources.write[p_index].path = path; // Update path.
+		}
+
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
 			Ref<Resource> cached = ResourceCache::get_ref(path);
-			if (cached->get_class() == t) {
-				cached->reset_state();
-				res = cached;
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				internal_index_cache[path] = cached;
+				return OK;
 			}
 		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
+	}
 
-		MissingResource *missing_resource = nullptr;
+	uint64_t offset = internal_resources[p_index].offset;
 
-		if (res.is_null()) {
-			//did not replace
+	f->seek(offset);
 
-			Object *obj = ClassDB::instantiate(t);
-			if (!obj) {
-				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-					//create a missing resource
-					missing_resource = memnew(MissingResource);
-					missing_resource->set_original_class(t);
-					missing_resource->set_recording_properties(true);
-					obj = missing_resource;
-				} else {
-					error = ERR_FILE_CORRUPT;
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
-				}
-			}
+	String t = get_unicode_string();
 
-			Resource *r = Object::cast_to<Resource>(obj);
-			if (!r) {
-				String obj_class = obj->get_class();
-				error = ERR_FILE_CORRUPT;
-				memdelete(obj); //bye
-				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
-			}
+	Ref<Resource> res;
+
+	if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+		//use the existing one
+		Ref<Resource> cached = ResourceCache::get_ref(path);
+		if (cached->get_class() == t) {
+			cached->reset_state();
+			res = cached;
+		}
+	}
+
+	MissingResource *missing_resource = nullptr;
+
+	if (res.is_null()) {
+		//did not replace
 
-			res = Ref<Resource>(r);
-			if (!path.is_empty() && cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-				r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); //if got here because the resource with same path has different type, replace it
+		Object *obj = ClassDB::instantiate(t);
+		if (!obj) {
+			if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+				//create a missing resource
+				missing_resource = memnew(MissingResource);
+				missing_resource->set_original_class(t);
+				missing_resource->set_recording_properties(true);
+				obj = missing_resource;
+			} else {
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
 			}
-			r->set_scene_unique_id(id);
 		}
 
-		if (!main) {
-			internal_index_cache[path] = res;
+		Resource *r = Object::cast_to<Resource>(obj);
+		if (!r) {
+			String obj_class = obj->get_class();
+			memdelete(obj); //bye
+			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
 		}
 
-		int pc = f->get_32();
+		res = Ref<Resource>(r);
+		if (!path.is_empty() && cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+			r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); //if got here because the resource with same path has different type, replace it
+		}
+		r->set_scene_unique_id(id);
+	}
 
-		//set properties
+	if (!main) {
+		internal_index_cache[path] = res;
+	}
 
-		Dictionary missing_resource_properties;
+	r_loaded.resource = res;
+	r_loaded.path = path;
+	r_loaded.missing_resource = missing_resource;
+	r_loaded.properties_offset = f->get_position();
+	return OK;
+}
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+Error ResourceLoaderBinary::_parse_properties(LoadedResource &r_loaded) {
+	int pc = f->get_32();
+	r_loaded.properties.resize(pc);
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string();
 
-			Variant value;
+		if (name == StringName()) {
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
+		}
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
-			}
+		Variant value;
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource != nullptr) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+		Error err = parse_variant(value);
+		if (err) {
+			return err;
+		}
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
-			}
+		r_loaded.properties[j] = Pair<StringName, Variant>(name, value);
+	}
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
-				}
-			}
+	return OK;
+}
 
-			if (set_valid) {
-				res->set(name, value);
+void ResourceLoaderBinary::_set_properties(LoadedResource &r_loaded) {
+	Ref<Resource> &res = r_loaded.resource;
+
+	Dictionary missing_resource_properties;
+
+	for (Pair<StringName, Variant> &property : r_loaded.properties) {
+		const StringName &name = property.first;
+		Variant &value = property.second;
+
+		bool set_valid = true;
+		if (value.get_type() == Variant::OBJECT && r_loaded.missing_resource != nullptr) {
+			// If the property being set is a missing resource (and the parent is not),
+			// then setting it will most likely not work.
+			// Instead, save it as metadata.
+
+			Ref<MissingResource> mr = value;
+			if (mr.is_valid()) {
+				missing_resource_properties[name] = mr;
+				set_valid = false;
 			}
 		}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+		if (value.get_type() == Variant::ARRAY) {
+			Array set_array = value;
+			bool is_get_valid = false;
+			Variant get_value = res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+				Array get_array = get_value;
+				if (!set_array.is_same_typed(get_array)) {
+					value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
+				}
+			}
 		}
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+		if (set_valid) {
+			res->set(name, value);
 		}
+	}
+	r_loaded.properties.clear();
+
+	if (r_loaded.missing_resource) {
+		r_loaded.missing_resource->set_recording_properties(false);
+	}
+
+	if (!missing_resource_properties.is_empty()) {
+		res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	}
 
 #ifdef TOOLS_ENABLED
-		res->set_edited(false);
+	res->set_edited(false);
 #endif
+}
+
+bool ResourceLoaderBinary::_finish_internal_resource(int p_index, LoadedResource &r_loaded) {
+	_set_properties(r_loaded);
+
+	if (progress) {
+		*progress = (p_index + 1) / float(internal_resources.size());
+	}
 
-		if (progress) {
-			*progress = (i + 1) / float(internal_resources.size());
+	resource_cache.push_back(r_loaded.resource);
+
+	if (p_index == (internal_resources.size() - 1)) {
+		f.unref();
+		resource = r_loaded.resource;
+		resource->set_as_translation_remapped(translation_remapped);
+		error = OK;
+		return true;
+	}
+	return false;
+}
+
+bool ResourceLoaderBinary::_can_parse_in_parallel() const {
+	// Old files can load external resources while parsing, which can't be done from the worker threads.
+	if (!using_named_scene_ids || internal_resources.size() < PARALLEL_PARSE_MIN_RESOURCES) {
+		return false;
+	}
+	WorkerThreadPool *wtp = WorkerThreadPool::get_singleton();
+	// Waiting for the parsing from a worker thread could leave no thread to do it.
+	return wtp && wtp->get_thread_count() > 1 && !wtp->is_worker_thread();
+}
+
+Error ResourceLoaderBinary::_load_internal_resources_parallel() {
+	// Create all the resources first, so the parsed properties can refer to them.
+	LocalVector<LoadedResource> loaded;
+	loaded.resize(internal_resources.size());
+	uint64_t begin = f->get_length();
+	for (int i = 0; i < internal_resources.size(); i++) {
+		error = _instantiate_internal_resource(i, loaded[i]);
+		if (error) {
+			return error;
 		}
+		if (loaded[i].resource.is_valid()) {
+			begin = MIN(begin, loaded[i].properties_offset);
+		}
+	}
 
-		resource_cache.push_back(res);
+	// The parsing threads can't wait for the external resources.
+	for (int i = 0; i < external_resources.size(); i++) {
+		if (external_resources[i].cache.is_null()) {
+			error = _resolve_external_resource(i);
+			if (error) {
+				return error;
+			}
+		}
+	}
 
-		if (main) {
-			f.unref();
-			resource = res;
-			resource->set_as_translation_remapped(translation_remapped);
-			error = OK;
+	// Each thread reads from its own view of the properties of the resources.
+	ParallelParse parse;
+	parse.loaded = &loaded;
+	parse.offset = begin;
+	parse.length = f->get_length() - begin;
+	parse.big_endian = f->is_big_endian();
+	parse.real_is_double = f->real_is_double;
+
+	f->seek(begin);
+	Vector<uint8_t> buffer;
+	parse.data = f->get_mapped_buffer(parse.length);
+	if (!parse.data) {
+		buffer.resize(parse.length);
+		f->get_buffer(buffer.ptrw(), parse.length);
+		parse.data = buffer.ptr();
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ResourceLoaderBinary::_parse_properties_task, &parse, WorkerThreadPool::get_singleton()->get_thread_count(), -1, true, SNAME("ResourceLoaderBinary"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Setting the properties may not be thread-safe, so it's done in file order like when loading on a single thread.
+	for (int i = 0; i < internal_resources.size(); i++) {
+		if (loaded[i].resource.is_null()) {
+			continue; // Already loaded.
+		}
+
+		error = loaded[i].error;
+		if (error) {
+			return error;
+		}
+
+		if (_finish_internal_resource(i, loaded[i])) {
 			return OK;
 		}
 	}
@@ -879,6 +1011,43 @@ Error ResourceLoaderBinary::load() {
 	return ERR_FILE_EOF;
 }
 
+void ResourceLoaderBinary::_parse_properties_task(uint32_t p_index, ParallelParse *p_parse) {
+	Ref<FileAccessMemory> fm;
+	fm.instantiate();
+	fm->open_custom(p_parse->data, p_parse->length);
+	fm->set_big_endian(p_parse->big_endian);
+	fm->real_is_double = p_parse->real_is_double;
+
+	ResourceLoaderBinary parser;
+	parser.f = fm;
+	parser.local_path = local_path;
+	parser.res_path = res_path;
+	parser.ver_format = ver_format;
+	parser.string_map = string_map;
+	parser.using_named_scene_ids = using_named_scene_ids;
+	parser.using_uids = using_uids;
+	parser.external_resources = external_resources;
+	parser.internal_resources = internal_resources;
+	parser.internal_index_cache = internal_index_cache;
+	parser.remaps = remaps;
+	parser.cache_mode = cache_mode;
+
+	// Take the next resource until they are all parsed, as their sizes vary a lot.
+	LocalVector<LoadedResource> &loaded = *p_parse->loaded;
+	while (true) {
+		uint32_t index = p_parse->next.postincrement();
+		if (index >= loaded.size()) {
+			break;
+		}
+		if (loaded[index].resource.is_null()) {
+			continue;
+		}
+
+		fm->seek(loaded[index].properties_offset - p_parse->offset);
+		loaded[index].error = parser._parse_properties(loaded[index]);
+	}
+}
+
 void ResourceLoaderBinary::set_translation_remapped(bool p_remapped) {
 	translation_remapped = p_remapped;
 }
@@ -901,12 +1070,18 @@ static String get_ustring(Ref<FileAccess> f) {
 
 String ResourceLoaderBinary::get_unicode_string() {
 	int len = f->get_32();
-	if (len > str_buf.size()) {
-		str_buf.resize(len);
-	}
 	if (len == 0) {
 		return String();
 	}
+	const uint8_t *mapped = f->get_mapped_buffer(len);
+	if (mapped) {
+		String s;
+		s.parse_utf8((const char *)mapped, len);
+		return s;
+	}
+	if (len > str_buf.size()) {
+		str_buf.resize(len);
+	}
 	f->get_buffer((uint8_t *)&str_buf[0], len);
 	String s;
 	s.parse_utf8(&str_buf[0]);
@@ -34,6 +34,11 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
+
+class MissingResource;
 
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
@@ -78,6 +83,37 @@ class ResourceLoaderBinary {
 	Vector<IntResource> internal_resources;
 	HashMap<String, Ref<Resource>> internal_index_cache;
 
+	struct LoadedResource {
+		Ref<Resource> resource; // Null if it was already loaded.
+		String path;
+		MissingResource *missing_resource = nullptr;
+		uint64_t properties_offset = 0;
+		LocalVector<Pair<StringName, Variant>> properties;
+		Error error = OK;
+	};
+
+	// Files with fewer internal resources are not worth parsing on multiple threads.
+	static const int PARALLEL_PARSE_MIN_RESOURCES = 16;
+
+	struct ParallelParse {
+		LocalVector<LoadedResource> *loaded = nullptr;
+		const uint8_t *data = nullptr;
+		uint64_t offset = 0;
+		uint64_t length = 0;
+		bool big_endian = false;
+		bool real_is_double = false;
+		SafeNumeric<uint32_t> next;
+	};
+
+	Error _resolve_external_resource(int p_index);
+	Error _instantiate_internal_resource(int p_index, LoadedResource &r_loaded);
+	Error _parse_properties(LoadedResource &r_loaded);
+	void _set_properties(LoadedResource &r_loaded);
+	bool _finish_internal_resource(int p_index, LoadedResource &r_loaded);
+	bool _can_parse_in_parallel() const;
+	Error _load_internal_resources_parallel();
+	void _parse_properties_task(uint32_t p_index, ParallelParse *p_parse);
+
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
 
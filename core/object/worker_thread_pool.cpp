@@ -40,15 +40,47 @@ void WorkerThreadPool::Task::free_template_userdata() {
 }
 
 WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
+thread_local WorkerThreadPool::ThreadData *WorkerThreadPool::current_thread_data = nullptr;
+WorkerThreadPool::Dependent WorkerThreadPool::resolved_dependents;
 
 void WorkerThreadPool::_process_task_queue() {
-	task_mutex.lock();
-	Task *task = task_queue.first()->self();
-	task_queue.remove(task_queue.first());
-	task_mutex.unlock();
+	Task *task = _pop_task(_get_current_thread_data());
 	_process_task(task);
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_pop_task(ThreadData *p_thread_data) {
+	Task *task = nullptr;
+	if (use_work_stealing && p_thread_data && p_thread_data->task_deque.pop(task)) {
+		// Own tasks are taken newest first, which keeps nested work hot in cache.
+		return task;
+	}
+
+	// The semaphore guarantees a task is queued for us, but in work stealing mode
+	// it may still sit in the deque of another thread, so retry until we get it.
+	while (true) {
+		task_mutex.lock();
+		if (task_queue.first()) {
+			task = task_queue.first()->self();
+			task_queue.remove(task_queue.first());
+			task_mutex.unlock();
+			return task;
+		}
+		task_mutex.unlock();
+
+		if (!use_work_stealing) {
+			ERR_FAIL_V_MSG(nullptr, "Worker thread woken up with an empty task queue.");
+		}
+
+		uint32_t first = p_thread_data ? p_thread_data->index + 1 : 0;
+		for (uint32_t i = 0; i < threads.size(); i++) {
+			ThreadData &victim = threads[(first + i) % threads.size()];
+			if (&victim != p_thread_data && victim.task_deque.steal(task)) {
+				return task;
+			}
+		}
+	}
+}
+
 void WorkerThreadPool::_process_task(Task *p_task) {
 	bool low_priority = p_task->low_priority;
 
@@ -87,6 +119,11 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			memdelete(p_task->template_userdata); // This is no longer needed at this point, so get rid of it.
 		}
 
+		if (do_post) {
+			// Must happen before the waiting thread is released, as it may free the group.
+			_resolve_dependents(p_task->group->dependencies);
+		}
+
 		if (low_priority && use_native_low_priority_threads) {
 			p_task->completed = true;
 			p_task->done_semaphore.post();
@@ -126,58 +163,86 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			p_task->callable.callp(nullptr, 0, ret, ce);
 		}
 
+		_resolve_dependents(p_task->dependencies);
 		p_task->completed = true;
 		p_task->done_semaphore.post();
 	}
 
 	if (!use_native_low_priority_threads && low_priority) {
 		// A low prioriry task was freed, so see if we can move a pending one to the high priority queue.
-		bool post = false;
+		Task *low_prio_task = nullptr;
 		task_mutex.lock();
 		if (low_priority_task_queue.first()) {
-			Task *low_prio_task = low_priority_task_queue.first()->self();
+			low_prio_task = low_priority_task_queue.first()->self();
 			low_priority_task_queue.remove(low_priority_task_queue.first());
-			task_queue.add_last(&low_prio_task->task_elem);
-			post = true;
 		} else {
 			low_priority_threads_used.decrement();
 		}
-		task_mutex.lock();
-		if (post) {
+		task_mutex.unlock();
+		if (low_prio_task) {
+			_push_tasks(&low_prio_task, 1);
 			task_available_semaphore.post();
 		}
 	}
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
+	ThreadData *thread_data = (ThreadData *)p_user;
+	WorkerThreadPool *pool = thread_data->pool;
+	current_thread_data = thread_data;
 	while (true) {
-		singleton->task_available_semaphore.wait();
-		if (singleton->exit_threads.is_set()) {
+		pool->task_available_semaphore.wait();
+		if (pool->exit_threads.is_set()) {
 			break;
 		}
-		singleton->_process_task_queue();
+		pool->_process_task_queue();
 	}
+	current_thread_data = nullptr;
 }
 
 void WorkerThreadPool::_native_low_priority_thread_function(void *p_user) {
 	Task *task = (Task *)p_user;
-	singleton->_process_task(task);
+	task->pool->_process_task(task);
 }
 
-void WorkerThreadPool::_post_task(Task *p_task, bool p_high_priority) {
+void WorkerThreadPool::_push_tasks(Task **p_tasks, uint32_t p_count) {
+	if (use_work_stealing) {
+		ThreadData *thread_data = _get_current_thread_data();
+		if (thread_data) {
+			// Tasks spawned from a worker go to its own deque, where idle threads can steal them without locking.
+			for (uint32_t i = 0; i < p_count; i++) {
+				thread_data->task_deque.push(p_tasks[i]);
+			}
+			return;
+		}
+	}
+
 	task_mutex.lock();
+	for (uint32_t i = 0; i < p_count; i++) {
+		task_queue.add_last(&p_tasks[i]->task_elem);
+	}
+	task_mutex.unlock();
+}
+
+void WorkerThreadPool::_post_task(Task *p_task, bool p_high_priority) {
 	p_task->low_priority = !p_high_priority;
-	if (!p_high_priority && use_native_low_priority_threads) {
+	if (p_high_priority) {
+		_push_tasks(&p_task, 1);
+		task_available_semaphore.post();
+		return;
+	}
+
+	task_mutex.lock();
+	if (use_native_low_priority_threads) {
 		task_mutex.unlock();
+		p_task->pool = this;
 		p_task->low_priority_thread = native_thread_allocator.alloc();
 		p_task->low_priority_thread->start(_native_low_priority_thread_function, p_task); // Pask task directly to thread.
 
-	} else if (p_high_priority || low_priority_threads_used.get() < max_low_priority_threads) {
-		task_queue.add_last(&p_task->task_elem);
-		if (!p_high_priority) {
-			low_priority_threads_used.increment();
-		}
+	} else if (low_priority_threads_used.get() < max_low_priority_threads) {
+		low_priority_threads_used.increment();
 		task_mutex.unlock();
+		_push_tasks(&p_task, 1);
 		task_available_semaphore.post();
 	} else {
 		// Too many threads using low priority, must go to queue.
@@ -186,11 +251,100 @@ void WorkerThreadPool::_post_task(Task *p_task, bool p_high_priority) {
 	}
 }
 
+void WorkerThreadPool::_post_group(Group *p_group, Task **p_tasks, uint32_t p_count, bool p_high_priority) {
+	if (p_count == 0) {
+		// Should really not call it with zero Elements, but at least it should work.
+		_resolve_dependents(p_group->dependencies);
+		p_group->completed.set_to(true);
+		p_group->done_semaphore.post();
+		return;
+	}
+
+	// The group may be freed as soon as its last task is posted, so don't touch it afterwards.
+	if (p_high_priority) {
+		// Queue all the tasks at once, so the queue lock and semaphore are only taken once per group.
+		for (uint32_t i = 0; i < p_count; i++) {
+			p_tasks[i]->low_priority = false;
+		}
+		_push_tasks(p_tasks, p_count);
+		task_available_semaphore.post(p_count);
+	} else {
+		for (uint32_t i = 0; i < p_count; i++) {
+			_post_task(p_tasks[i], false);
+		}
+	}
+}
+
+void WorkerThreadPool::_add_dependencies(Dependencies &r_dependencies, Task *p_task, Group *p_group, const Vector<TaskID> &p_dependencies) {
+	// Called with the task mutex locked. Start with one extra pending dependency, so nothing can post
+	// the task or group before all its dependencies are registered. The caller must remove it afterwards.
+	r_dependencies.pending.set(1);
+
+	for (const TaskID &dependency_id : p_dependencies) {
+		Dependencies *dependencies = nullptr;
+		if (Task **taskp = tasks.getptr(dependency_id)) {
+			dependencies = &(*taskp)->dependencies;
+		} else if (Group **groupp = groups.getptr(dependency_id)) {
+			dependencies = &(*groupp)->dependencies;
+		} else {
+			ERR_CONTINUE_MSG(true, "Invalid dependency Task or Group ID: " + itos(dependency_id));
+		}
+
+		Dependent *dependent = dependent_allocator.alloc();
+		dependent->task = p_task;
+		dependent->group = p_group;
+		r_dependencies.pending.increment();
+
+		Dependent *head = dependencies->dependents.load();
+		while (true) {
+			if (head == &resolved_dependents) {
+				// Already completed, nothing to wait for.
+				dependent_allocator.free(dependent);
+				r_dependencies.pending.decrement();
+				break;
+			}
+			dependent->next = head;
+			if (dependencies->dependents.compare_exchange_weak(head, dependent)) {
+				break;
+			}
+		}
+	}
+}
+
+void WorkerThreadPool::_resolve_dependents(Dependencies &p_dependencies) {
+	Dependent *dependents = p_dependencies.dependents.exchange(&resolved_dependents);
+	if (!dependents) {
+		return;
+	}
+
+	for (Dependent *dependent = dependents; dependent; dependent = dependent->next) {
+		if (dependent->task) {
+			Task *task = dependent->task;
+			if (task->dependencies.pending.decrement() == 0) {
+				_post_task(task, !task->low_priority);
+			}
+		} else {
+			Group *group = dependent->group;
+			if (group->dependencies.pending.decrement() == 0) {
+				_post_group(group, group->deferred_tasks.ptr(), group->deferred_tasks.size(), group->high_priority);
+			}
+		}
+	}
+
+	task_mutex.lock();
+	while (dependents) {
+		Dependent *next = dependents->next;
+		dependent_allocator.free(dependents);
+		dependents = next;
+	}
+	task_mutex.unlock();
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	task_mutex.lock();
 	// Get a free task
 	Task *task = task_allocator.alloc();
@@ -200,10 +354,16 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->native_func_userdata = p_userdata;
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
+	task->low_priority = !p_high_priority;
 	tasks.insert(id, task);
+	if (!p_dependencies.is_empty()) {
+		_add_dependencies(task->dependencies, task, nullptr, p_dependencies);
+	}
 	task_mutex.unlock();
 
-	_post_task(task, p_high_priority);
+	if (p_dependencies.is_empty() || task->dependencies.pending.decrement() == 0) {
+		_post_task(task, p_high_priority);
+	}
 
 	return id;
 }
@@ -212,6 +372,14 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bo
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task_after(const Vector<TaskID> &p_dependencies, void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_task_after(const Vector<TaskID> &p_dependencies, const Callable &p_action, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	task_mutex.lock();
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -250,12 +418,12 @@ void WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	task_mutex.unlock();
 
 	if (use_native_low_priority_threads && task->low_priority) {
+		// The thread may not be started yet if the task is waiting for dependencies.
+		task->done_semaphore.wait();
 		task->low_priority_thread->wait_to_finish();
 		native_thread_allocator.free(task->low_priority_thread);
 	} else {
-		int *index = thread_ids.getptr(Thread::get_caller_id());
-
-		if (index) {
+		if (_get_current_thread_data()) {
 			// We are an actual process thread, we must not be blocked so continue processing stuff if available.
 			while (true) {
 				if (task->done_semaphore.try_wait()) {
@@ -280,7 +448,7 @@ void WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	task_mutex.unlock();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = threads.size();
@@ -291,12 +459,10 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	GroupID id = last_task++;
 	group->max = p_elements;
 	group->self = id;
+	group->high_priority = p_high_priority;
 
 	Task **tasks_posted = nullptr;
 	if (p_elements == 0) {
-		// Should really not call it with zero Elements, but at least it should work.
-		group->completed.set_to(true);
-		group->done_semaphore.post();
 		group->tasks_used = 0;
 		p_tasks = 0;
 		if (p_template_userdata) {
@@ -305,7 +471,12 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	} else {
 		group->tasks_used = p_tasks;
-		tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
+		if (p_dependencies.is_empty()) {
+			tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
+		} else {
+			group->deferred_tasks.resize(p_tasks);
+			tasks_posted = group->deferred_tasks.ptr();
+		}
 		for (int i = 0; i < p_tasks; i++) {
 			Task *task = task_allocator.alloc();
 			task->native_group_func = p_func;
@@ -319,20 +490,23 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 		}
 	}
 
-	groups[id] = group;
-	task_mutex.unlock();
-
 	if (!p_high_priority && use_native_low_priority_threads) {
 		group->low_priority_native_tasks.resize(p_tasks);
-	}
-
-	for (int i = 0; i < p_tasks; i++) {
-		_post_task(tasks_posted[i], p_high_priority);
-		if (!p_high_priority && use_native_low_priority_threads) {
+		for (int i = 0; i < p_tasks; i++) {
 			group->low_priority_native_tasks[i] = tasks_posted[i];
 		}
 	}
 
+	groups[id] = group;
+	if (!p_dependencies.is_empty()) {
+		_add_dependencies(group->dependencies, nullptr, group, p_dependencies);
+	}
+	task_mutex.unlock();
+
+	if (p_dependencies.is_empty() || group->dependencies.pending.decrement() == 0) {
+		_post_group(group, tasks_posted, p_tasks, p_high_priority);
+	}
+
 	return id;
 }
 
@@ -344,6 +518,14 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task_after(const Vector<TaskID> &p_dependencies, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_group_task_after(const Vector<TaskID> &p_dependencies, const Callable &p_action, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
 	task_mutex.lock();
 	const Group *const *groupp = groups.getptr(p_group);
@@ -370,14 +552,16 @@ bool WorkerThreadPool::is_group_task_completed(GroupID p_group) const {
 void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 	task_mutex.lock();
 	Group **groupp = groups.getptr(p_group);
+	Group *group = groupp ? *groupp : nullptr;
 	task_mutex.unlock();
-	if (!groupp) {
+	if (!group) {
 		ERR_FAIL_MSG("Invalid Group ID");
 	}
-	Group *group = *groupp;
 
 	if (group->low_priority_native_tasks.size() > 0) {
 		for (Task *task : group->low_priority_native_tasks) {
+			// The thread may not be started yet if the group is waiting for dependencies.
+			task->done_semaphore.wait();
 			task->low_priority_thread->wait_to_finish();
 			native_thread_allocator.free(task->low_priority_thread);
 			task_mutex.lock();
@@ -386,11 +570,17 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 		}
 
 		task_mutex.lock();
+		groups.erase(p_group);
 		group_allocator.free(group);
 		task_mutex.unlock();
 	} else {
 		group->done_semaphore.wait();
 
+		// Remove the ID before the group can be freed, so no new dependencies can be added to it.
+		task_mutex.lock(); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
+		groups.erase(p_group);
+		task_mutex.unlock();
+
 		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = group->finished.increment(); // fetch happens before inc, so increment later.
 
@@ -401,13 +591,9 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 			task_mutex.unlock();
 		}
 	}
-
-	task_mutex.lock(); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
-	groups.erase(p_group);
-	task_mutex.unlock();
 }
 
-void WorkerThreadPool::init(int p_thread_count, bool p_use_native_threads_low_priority, float p_low_priority_task_ratio) {
+void WorkerThreadPool::init(int p_thread_count, bool p_use_native_threads_low_priority, float p_low_priority_task_ratio, bool p_use_work_stealing) {
 	ERR_FAIL_COND(threads.size() > 0);
 	if (p_thread_count < 0) {
 		p_thread_count = OS::get_singleton()->get_default_thread_pool_size();
@@ -420,13 +606,14 @@ void WorkerThreadPool::init(int p_thread_count, bool p_use_native_threads_low_pr
 	}
 
 	use_native_low_priority_threads = p_use_native_threads_low_priority;
+	use_work_stealing = p_use_work_stealing;
 
 	threads.resize(p_thread_count);
 
 	for (uint32_t i = 0; i < threads.size(); i++) {
 		threads[i].index = i;
+		threads[i].pool = this;
 		threads[i].thread.start(&WorkerThreadPool::_thread_function, &threads[i]);
-		thread_ids.insert(threads[i].thread.get_id(), i);
 	}
 }
 
@@ -445,9 +632,7 @@ void WorkerThreadPool::finish() {
 
 	exit_threads.set_to(true);
 
-	for (uint32_t i = 0; i < threads.size(); i++) {
-		task_available_semaphore.post();
-	}
+	task_available_semaphore.post(threads.size());
 
 	for (ThreadData &data : threads) {
 		data.thread.wait_to_finish();
@@ -458,19 +643,26 @@ void WorkerThreadPool::finish() {
 
 void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_task", "action", "high_priority", "description"), &WorkerThreadPool::add_task, DEFVAL(false), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("add_task_after", "dependencies", "action", "high_priority", "description"), &WorkerThreadPool::add_task_after, DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_task_completed", "task_id"), &WorkerThreadPool::is_task_completed);
 	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
 
 	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("add_group_task_after", "dependencies", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task_after, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
 	ClassDB::bind_method(D_METHOD("get_group_processed_element_count", "group_id"), &WorkerThreadPool::get_group_processed_element_count);
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
 }
 
 WorkerThreadPool::WorkerThreadPool() {
-	singleton = this;
+	if (!singleton) {
+		singleton = this;
+	}
 }
 
 WorkerThreadPool::~WorkerThreadPool() {
 	finish();
+	if (singleton == this) {
+		singleton = nullptr;
+	}
 }
@@ -39,6 +39,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -52,6 +53,7 @@ public:
 
 private:
 	struct Task;
+	struct Group;
 
 	struct BaseTemplateUserdata {
 		virtual void callback() {}
@@ -59,6 +61,18 @@ private:
 		virtual ~BaseTemplateUserdata() {}
 	};
 
+	struct Dependent {
+		Task *task = nullptr;
+		Group *group = nullptr;
+		Dependent *next = nullptr;
+	};
+
+	// Tasks and groups added with dependencies are only posted once all of those have completed.
+	struct Dependencies {
+		std::atomic<Dependent *> dependents = nullptr; // Set to `resolved_dependents` on completion, after which nothing else can be added.
+		SafeNumeric<uint32_t> pending;
+	};
+
 	struct Group {
 		GroupID self;
 		SafeNumeric<uint32_t> index;
@@ -69,6 +83,9 @@ private:
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
 		TightLocalVector<Task *> low_priority_native_tasks;
+		Dependencies dependencies;
+		TightLocalVector<Task *> deferred_tasks; // Only used while waiting for dependencies.
+		bool high_priority = false;
 	};
 
 	struct Task {
@@ -85,6 +102,8 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		Thread *low_priority_thread = nullptr;
+		WorkerThreadPool *pool = nullptr; // Owner, for tasks run on their own native thread.
+		Dependencies dependencies;
 
 		void free_template_userdata();
 		Task() :
@@ -94,6 +113,9 @@ private:
 	PagedAllocator<Task> task_allocator;
 	PagedAllocator<Group> group_allocator;
 	PagedAllocator<Thread> native_thread_allocator;
+	PagedAllocator<Dependent> dependent_allocator;
+
+	static Dependent resolved_dependents;
 
 	SelfList<Task>::List low_priority_task_queue;
 	SelfList<Task>::List task_queue;
@@ -104,16 +126,20 @@ private:
 	struct ThreadData {
 		uint32_t index;
 		Thread thread;
+		WorkerThreadPool *pool = nullptr;
+		WorkStealingDeque<Task *> task_deque; // Only used in work stealing mode.
 	};
 
 	TightLocalVector<ThreadData> threads;
 	SafeFlag exit_threads;
 
-	HashMap<Thread::ID, int> thread_ids;
+	static thread_local ThreadData *current_thread_data;
+
 	HashMap<TaskID, Task *> tasks;
 	HashMap<GroupID, Group *> groups;
 
 	bool use_native_low_priority_threads = false;
+	bool use_work_stealing = false;
 	uint32_t max_low_priority_threads = 0;
 	SafeNumeric<uint32_t> low_priority_threads_used;
 
@@ -125,12 +151,22 @@ private:
 	void _process_task_queue();
 	void _process_task(Task *task);
 
+	Task *_pop_task(ThreadData *p_thread_data);
+	void _push_tasks(Task **p_tasks, uint32_t p_count);
 	void _post_task(Task *p_task, bool p_high_priority);
+	void _post_group(Group *p_group, Task **p_tasks, uint32_t p_count, bool p_high_priority);
+
+	void _add_dependencies(Dependencies &r_dependencies, Task *p_task, Group *p_group, const Vector<TaskID> &p_dependencies);
+	void _resolve_dependents(Dependencies &p_dependencies);
+
+	_FORCE_INLINE_ ThreadData *_get_current_thread_data() const {
+		return (current_thread_data && current_thread_data->pool == this) ? current_thread_data : nullptr;
+	}
 
 	static WorkerThreadPool *singleton;
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies = Vector<TaskID>());
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies = Vector<TaskID>());
 
 	template <class C, class M, class U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -168,6 +204,20 @@ public:
 	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
+	// Same as above, but the task is only started once all the tasks or groups in `p_dependencies` have completed.
+	// Waiting for a task or group that other tasks depend on is allowed, but only after adding those.
+	template <class C, class M, class U>
+	TaskID add_template_task_after(const Vector<TaskID> &p_dependencies, C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, p_dependencies);
+	}
+	TaskID add_native_task_after(const Vector<TaskID> &p_dependencies, void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_task_after(const Vector<TaskID> &p_dependencies, const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
+
 	bool is_task_completed(TaskID p_task_id) const;
 	void wait_for_task_completion(TaskID p_task_id);
 
@@ -182,14 +232,29 @@ public:
 	}
 	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+
+	template <class C, class M, class U>
+	GroupID add_template_group_task_after(const Vector<TaskID> &p_dependencies, C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String()) {
+		typedef GroupUserData<C, M, U> GroupUD;
+		GroupUD *ud = memnew(GroupUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+	}
+	GroupID add_native_group_task_after(const Vector<TaskID> &p_dependencies, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_group_task_after(const Vector<TaskID> &p_dependencies, const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+
 	uint32_t get_group_processed_element_count(GroupID p_group) const;
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
 
 	_FORCE_INLINE_ int get_thread_count() const { return threads.size(); }
+	_FORCE_INLINE_ bool is_worker_thread() const { return _get_current_thread_data() != nullptr; }
+	_FORCE_INLINE_ bool is_using_work_stealing() const { return use_work_stealing; }
 
 	static WorkerThreadPool *get_singleton() { return singleton; }
-	void init(int p_thread_count = -1, bool p_use_native_threads_low_priority = true, float p_low_priority_task_ratio = 0.3);
+	void init(int p_thread_count = -1, bool p_use_native_threads_low_priority = true, float p_low_priority_task_ratio = 0.3, bool p_use_work_stealing = false);
 	void finish();
 	WorkerThreadPool();
 	~WorkerThreadPool();
@@ -0,0 +1,167 @@
+/**************************************************************************/
+/*  work_stealing_deque.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef WORK_STEALING_DEQUE_H
+#define WORK_STEALING_DEQUE_H
+
+#include "core/os/memory.h"
+#include "core/typedefs.h"
+
+#include <atomic>
+#include <type_traits>
+
+// Chase-Lev work-stealing deque, using the memory orderings described in
+// "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al., 2013).
+// - Only the owner thread may call push() and pop(); those operate on the bottom end.
+// - Any thread may call steal(), which takes from the top end.
+// - When the ring buffer grows, the old buffer is kept alive until the deque is destroyed,
+//   since a concurrent thief may still be reading from it.
+
+template <class T>
+class WorkStealingDeque {
+	static_assert(std::is_trivially_copyable<T>::value);
+	static_assert(std::atomic<T>::is_always_lock_free);
+
+	struct Buffer {
+		int64_t mask = 0;
+		std::atomic<T> *data = nullptr;
+		Buffer *previous = nullptr;
+
+		_FORCE_INLINE_ T get(int64_t p_index) const {
+			return data[p_index & mask].load(std::memory_order_relaxed);
+		}
+		_FORCE_INLINE_ void set(int64_t p_index, T p_value) {
+			data[p_index & mask].store(p_value, std::memory_order_relaxed);
+		}
+	};
+
+	std::atomic<int64_t> top = 0;
+	std::atomic<int64_t> bottom = 0;
+	std::atomic<Buffer *> buffer = nullptr;
+
+	static Buffer *_alloc_buffer(int64_t p_capacity) {
+		Buffer *b = memnew(Buffer);
+		b->mask = p_capacity - 1;
+		b->data = memnew_arr(std::atomic<T>, p_capacity);
+		return b;
+	}
+
+	Buffer *_grow(Buffer *p_buffer, int64_t p_top, int64_t p_bottom) {
+		Buffer *b = _alloc_buffer((p_buffer->mask + 1) * 2);
+		for (int64_t i = p_top; i < p_bottom; i++) {
+			b->set(i, p_buffer->get(i));
+		}
+		b->previous = p_buffer;
+		buffer.store(b, std::memory_order_release);
+		return b;
+	}
+
+public:
+	// Owner only.
+	void push(T p_value) {
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		int64_t t = top.load(std::memory_order_acquire);
+		Buffer *a = buffer.load(std::memory_order_relaxed);
+		if (b - t > a->mask) {
+			a = _grow(a, t, b);
+		}
+		a->set(b, p_value);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+
+	// Owner only. Returns false if the deque is empty.
+	bool pop(T &r_value) {
+		int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		Buffer *a = buffer.load(std::memory_order_relaxed);
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_relaxed);
+
+		if (t > b) {
+			// Empty.
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		r_value = a->get(b);
+		if (t == b) {
+			// Last element, race against thieves for it.
+			bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return won;
+		}
+		return true;
+	}
+
+	// Any thread. Returns false if the deque is empty or if another thread won the race for the element.
+	bool steal(T &r_value) {
+		int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t b = bottom.load(std::memory_order_acquire);
+
+		if (t >= b) {
+			return false;
+		}
+
+		Buffer *a = buffer.load(std::memory_order_acquire);
+		T value = a->get(t);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return false;
+		}
+		r_value = value;
+		return true;
+	}
+
+	// Approximate when called concurrently with push(), pop() or steal().
+	_FORCE_INLINE_ bool is_empty() const {
+		return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+	}
+
+	WorkStealingDeque(int64_t p_initial_capacity = 64) {
+		int64_t capacity = 1;
+		while (capacity < p_initial_capacity) {
+			capacity <<= 1;
+		}
+		buffer.store(_alloc_buffer(capacity), std::memory_order_relaxed);
+	}
+
+	~WorkStealingDeque() {
+		Buffer *b = buffer.load(std::memory_order_relaxed);
+		while (b) {
+			Buffer *previous = b->previous;
+			memdelete_arr(b->data);
+			memdelete(b);
+			b = previous;
+		}
+	}
+};
+
+#endif // WORK_STEALING_DEQUE_H
@@ -232,6 +232,12 @@ void Dictionary::clear() {
 	_p->variant_map.clear();
 }
 
+void Dictionary::reserve(int p_new_capacity) {
+	ERR_FAIL_COND_MSG(_p->read_only, "Dictionary is in read-only state.");
+	ERR_FAIL_COND_MSG(p_new_capacity < 0, "New capacity must be non-negative.");
+	_p->variant_map.reserve(p_new_capacity);
+}
+
 void Dictionary::merge(const Dictionary &p_dictionary, bool p_overwrite) {
 	for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
 		if (p_overwrite || !has(E.key)) {
@@ -62,6 +62,7 @@ public:
 	int size() const;
 	bool is_empty() const;
 	void clear();
+	void reserve(int p_new_capacity);
 	void merge(const Dictionary &p_dictionary, bool p_overwrite = false);
 
 	bool has(const Variant &p_key) const;
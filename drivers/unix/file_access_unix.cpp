@@ -32,11 +32,13 @@
 
 #if defined(UNIX_ENABLED)
 
+#include "core/config/project_settings.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
@@ -339,6 +341,35 @@ void FileAccessUnix::close() {
 	_close();
 }
 
+const uint8_t *FileAccessUnix::map_file(const String &p_path, uint64_t *r_length) {
+	String path = ProjectSettings::get_singleton() ? ProjectSettings::get_singleton()->globalize_path(p_path) : p_path;
+
+	int fd = ::open(path.utf8().get_data(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return nullptr;
+	}
+
+	struct stat st = {};
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+		::close(fd);
+		return nullptr;
+	}
+
+	// The mapping stays valid after the file is closed.
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED) {
+		return nullptr;
+	}
+
+	*r_length = st.st_size;
+	return (const uint8_t *)data;
+}
+
+void FileAccessUnix::unmap_file(const uint8_t *p_data, uint64_t p_length) {
+	munmap((void *)p_data, p_length);
+}
+
 CloseNotificationFunc FileAccessUnix::close_notification_func = nullptr;
 
 FileAccessUnix::~FileAccessUnix() {
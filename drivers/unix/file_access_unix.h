@@ -84,6 +84,9 @@ public:
 
 	virtual void close() override;
 
+	static const uint8_t *map_file(const String &p_path, uint64_t *r_length);
+	static void unmap_file(const uint8_t *p_data, uint64_t p_length);
+
 	FileAccessUnix() {}
 	virtual ~FileAccessUnix();
 };
@@ -74,6 +74,9 @@ Error ENetMultiplayerPeer::create_server(int p_port, int p_max_clients, int p_ma
 	unique_id = 1;
 	connection_status = CONNECTION_CONNECTED;
 	hosts[0] = host;
+	if (threaded_polling) {
+		_start_poll_thread();
+	}
 	return OK;
 }
 
@@ -105,6 +108,9 @@ Error ENetMultiplayerPeer::create_client(const String &p_address, int p_port, in
 	active_mode = MODE_CLIENT;
 	peers[1] = peer;
 	hosts[0] = host;
+	if (threaded_polling) {
+		_start_poll_thread();
+	}
 
 	return OK;
 }
@@ -115,6 +121,9 @@ Error ENetMultiplayerPeer::create_mesh(int p_id) {
 	active_mode = MODE_MESH;
 	unique_id = p_id;
 	connection_status = CONNECTION_CONNECTED;
+	if (threaded_polling) {
+		_start_poll_thread();
+	}
 	return OK;
 }
 
@@ -124,13 +133,14 @@ Error ENetMultiplayerPeer::add_mesh_peer(int p_id, Ref<ENetConnection> p_host) {
 	List<Ref<ENetPacketPeer>> host_peers;
 	p_host->get_peers(host_peers);
 	ERR_FAIL_COND_V_MSG(host_peers.size() != 1 || host_peers[0]->get_state() != ENetPacketPeer::STATE_CONNECTED, ERR_INVALID_PARAMETER, "The provided host must have exactly one peer in the connected state.");
+	MutexLock lock(mutex);
 	hosts[p_id] = p_host;
 	peers[p_id] = host_peers[0];
 	emit_signal(SNAME("peer_connected"), p_id);
 	return OK;
 }
 
-void ENetMultiplayerPeer::_store_packet(int32_t p_source, ENetConnection::Event &p_event) {
+void ENetMultiplayerPeer::_store_packet(int32_t p_source, const ENetConnection::Event &p_event) {
 	Packet packet;
 	packet.packet = p_event.packet;
 	packet.channel = p_event.channel_id;
@@ -164,43 +174,55 @@ void ENetMultiplayerPeer::_disconnect_inactive_peers() {
 	}
 }
 
-void ENetMultiplayerPeer::poll() {
-	ERR_FAIL_COND_MSG(!_is_active(), "The multiplayer instance isn't currently active.");
-
-	_pop_current_packet();
-
-	_disconnect_inactive_peers();
+void ENetMultiplayerPeer::_service_hosts(LocalVector<HostEvent> &r_events) {
+	for (KeyValue<int, Ref<ENetConnection>> &E : hosts) {
+		HostEvent ev;
+		ev.host = E.key;
+		ev.type = E.value->service(0, ev.event);
+		while (ev.type != ENetConnection::EVENT_NONE) {
+			r_events.push_back(ev);
+			if (ev.type == ENetConnection::EVENT_ERROR) {
+				break;
+			}
+			ev = HostEvent();
+			ev.host = E.key;
+			if (E.value->check_events(ev.type, ev.event) <= 0) {
+				break;
+			}
+		}
+	}
+}
 
-	switch (active_mode) {
-		case MODE_CLIENT: {
-			if (!peers.has(1)) {
-				close();
-				return;
+void ENetMultiplayerPeer::_process_events(const LocalVector<HostEvent> &p_events) {
+	HashSet<int> to_drop;
+	for (const HostEvent &E : p_events) {
+		ENetConnection::Event event = E.event;
+		if (!_is_active() || !hosts.has(E.host) || to_drop.has(E.host)) {
+			// Closed while processing previous events.
+			if (E.type == ENetConnection::EVENT_RECEIVE) {
+				_destroy_unused(event.packet);
 			}
-			ENetConnection::Event event;
-			ENetConnection::EventType ret = hosts[0]->service(0, event);
-			do {
-				if (ret == ENetConnection::EVENT_CONNECT) {
+			continue;
+		}
+		switch (active_mode) {
+			case MODE_CLIENT: {
+				if (E.type == ENetConnection::EVENT_CONNECT) {
 					connection_status = CONNECTION_CONNECTED;
 					emit_signal(SNAME("peer_connected"), 1);
-				} else if (ret == ENetConnection::EVENT_DISCONNECT) {
+				} else if (E.type == ENetConnection::EVENT_DISCONNECT) {
 					if (connection_status == CONNECTION_CONNECTED) {
 						// Client just disconnected from server.
 						emit_signal(SNAME("peer_disconnected"), 1);
 					}
 					close();
-				} else if (ret == ENetConnection::EVENT_RECEIVE) {
+				} else if (E.type == ENetConnection::EVENT_RECEIVE) {
 					_store_packet(1, event);
-				} else if (ret != ENetConnection::EVENT_NONE) {
+				} else {
 					close(); // Error.
 				}
-			} while (hosts.has(0) && hosts[0]->check_events(ret, event) > 0);
-		} break;
-		case MODE_SERVER: {
-			ENetConnection::Event event;
-			ENetConnection::EventType ret = hosts[0]->service(0, event);
-			do {
-				if (ret == ENetConnection::EVENT_CONNECT) {
+			} break;
+			case MODE_SERVER: {
+				if (E.type == ENetConnection::EVENT_CONNECT) {
 					if (is_refusing_new_connections()) {
 						event.peer->reset();
 						continue;
@@ -214,7 +236,7 @@ void ENetMultiplayerPeer::poll() {
 					event.peer->set_meta(SNAME("_net_id"), id);
 					peers[id] = event.peer;
 					emit_signal(SNAME("peer_connected"), id);
-				} else if (ret == ENetConnection::EVENT_DISCONNECT) {
+				} else if (E.type == ENetConnection::EVENT_DISCONNECT) {
 					int id = event.peer->get_meta(SNAME("_net_id"));
 					if (!peers.has(id)) {
 						// Never fully connected.
@@ -222,45 +244,110 @@ void ENetMultiplayerPeer::poll() {
 					}
 					emit_signal(SNAME("peer_disconnected"), id);
 					peers.erase(id);
-				} else if (ret == ENetConnection::EVENT_RECEIVE) {
+				} else if (E.type == ENetConnection::EVENT_RECEIVE) {
 					int32_t source = event.peer->get_meta(SNAME("_net_id"));
 					_store_packet(source, event);
-				} else if (ret != ENetConnection::EVENT_NONE) {
+				} else {
 					close(); // Error
 				}
-			} while (hosts.has(0) && hosts[0]->check_events(ret, event) > 0);
-		} break;
-		case MODE_MESH: {
-			HashSet<int> to_drop;
-			for (KeyValue<int, Ref<ENetConnection>> &E : hosts) {
-				ENetConnection::Event event;
-				ENetConnection::EventType ret = E.value->service(0, event);
-				do {
-					if (ret == ENetConnection::EVENT_CONNECT) {
-						event.peer->reset();
-					} else if (ret == ENetConnection::EVENT_RECEIVE) {
-						_store_packet(E.key, event);
-					} else if (ret == ENetConnection::EVENT_NONE) {
-						break; // Keep polling the others.
-					} else {
-						to_drop.insert(E.key); // Error or disconnect.
-						break; // Keep polling the others.
-					}
-				} while (E.value->check_events(ret, event) > 0);
-			}
-			for (const int &P : to_drop) {
-				if (peers.has(P)) {
-					emit_signal(SNAME("peer_disconnected"), P);
-					peers.erase(P);
+			} break;
+			case MODE_MESH: {
+				if (E.type == ENetConnection::EVENT_CONNECT) {
+					event.peer->reset();
+				} else if (E.type == ENetConnection::EVENT_RECEIVE) {
+					_store_packet(E.host, event);
+				} else {
+					to_drop.insert(E.host); // Error or disconnect.
 				}
-				hosts.erase(P);
+			} break;
+			default:
+				break;
+		}
+	}
+	for (const int &P : to_drop) {
+		if (peers.has(P)) {
+			emit_signal(SNAME("peer_disconnected"), P);
+			peers.erase(P);
+		}
+		hosts.erase(P);
+	}
+}
+
+void ENetMultiplayerPeer::poll() {
+	ERR_FAIL_COND_MSG(!_is_active(), "The multiplayer instance isn't currently active.");
+	MutexLock lock(mutex);
+
+	_pop_current_packet();
+
+	_disconnect_inactive_peers();
+
+	if (active_mode == MODE_CLIENT && !peers.has(1)) {
+		close();
+		return;
+	}
+
+	if (poll_thread.is_started()) {
+		// Processing might close the peer (clearing the queue), so take the events first.
+		LocalVector<HostEvent> events = thread_events;
+		thread_events.clear();
+		_process_events(events);
+	} else {
+		LocalVector<HostEvent> events;
+		_service_hosts(events);
+		_process_events(events);
+	}
+}
+
+void ENetMultiplayerPeer::_poll_thread_func(void *p_user) {
+	ENetMultiplayerPeer *mp = static_cast<ENetMultiplayerPeer *>(p_user);
+	while (!mp->poll_thread_exit.is_set()) {
+		// Never block on the mutex, the main thread might be waiting for this thread to exit while holding it.
+		if (mp->mutex.try_lock()) {
+			if (mp->_is_active()) {
+				mp->_service_hosts(mp->thread_events);
 			}
-		} break;
-		default:
-			return;
+			mp->mutex.unlock();
+		}
+		OS::get_singleton()->delay_usec(POLL_THREAD_INTERVAL_USEC);
+	}
+}
+
+void ENetMultiplayerPeer::_start_poll_thread() {
+	if (poll_thread.is_started()) {
+		return;
+	}
+	poll_thread_exit.clear();
+	poll_thread.start(_poll_thread_func, this);
+}
+
+void ENetMultiplayerPeer::_stop_poll_thread() {
+	if (!poll_thread.is_started()) {
+		return;
+	}
+	poll_thread_exit.set();
+	poll_thread.wait_to_finish();
+	for (const HostEvent &E : thread_events) {
+		if (E.type == ENetConnection::EVENT_RECEIVE) {
+			_destroy_unused(E.event.packet);
+		}
+	}
+	thread_events.clear();
+}
+
+void ENetMultiplayerPeer::set_threaded_polling_enabled(bool p_enabled) {
+	MutexLock lock(mutex);
+	threaded_polling = p_enabled;
+	if (threaded_polling && _is_active()) {
+		_start_poll_thread();
+	} else if (!threaded_polling) {
+		_stop_poll_thread();
 	}
 }
 
+bool ENetMultiplayerPeer::is_threaded_polling_enabled() const {
+	return threaded_polling;
+}
+
 bool ENetMultiplayerPeer::is_server() const {
 	return active_mode == MODE_SERVER;
 }
@@ -271,6 +358,7 @@ bool ENetMultiplayerPeer::is_server_relay_supported() const {
 
 void ENetMultiplayerPeer::disconnect_peer(int p_peer, bool p_force) {
 	ERR_FAIL_COND(!_is_active() || !peers.has(p_peer));
+	MutexLock lock(mutex);
 	peers[p_peer]->peer_disconnect(0); // Will be removed during next poll.
 	if (active_mode == MODE_CLIENT || active_mode == MODE_SERVER) {
 		hosts[0]->flush();
@@ -295,6 +383,9 @@ void ENetMultiplayerPeer::close() {
 		return;
 	}
 
+	MutexLock lock(mutex);
+	_stop_poll_thread();
+
 	_pop_current_packet();
 
 	for (KeyValue<int, Ref<ENetPacketPeer>> &E : peers) {
@@ -338,6 +429,7 @@ Error ENetMultiplayerPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size
 	ERR_FAIL_COND_V_MSG(connection_status != CONNECTION_CONNECTED, ERR_UNCONFIGURED, "The multiplayer instance isn't currently connected to any server or client.");
 	ERR_FAIL_COND_V_MSG(target_peer != 0 && !peers.has(ABS(target_peer)), ERR_INVALID_PARAMETER, vformat("Invalid target peer: %d", target_peer));
 	ERR_FAIL_COND_V(active_mode == MODE_CLIENT && !peers.has(1), ERR_BUG);
+	MutexLock lock(mutex);
 
 	int packet_flags = 0;
 	int channel = SYSCH_RELIABLE;
@@ -442,6 +534,7 @@ int ENetMultiplayerPeer::get_unique_id() const {
 
 void ENetMultiplayerPeer::set_refuse_new_connections(bool p_enabled) {
 #ifdef GODOT_ENET
+	MutexLock lock(mutex);
 	if (_is_active()) {
 		for (KeyValue<int, Ref<ENetConnection>> &E : hosts) {
 			E.value->refuse_new_connections(p_enabled);
@@ -480,7 +573,11 @@ void ENetMultiplayerPeer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_host"), &ENetMultiplayerPeer::get_host);
 	ClassDB::bind_method(D_METHOD("get_peer", "id"), &ENetMultiplayerPeer::get_peer);
 
+	ClassDB::bind_method(D_METHOD("set_threaded_polling_enabled", "enabled"), &ENetMultiplayerPeer::set_threaded_polling_enabled);
+	ClassDB::bind_method(D_METHOD("is_threaded_polling_enabled"), &ENetMultiplayerPeer::is_threaded_polling_enabled);
+
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "host", PROPERTY_HINT_RESOURCE_TYPE, "ENetConnection", PROPERTY_USAGE_NONE), "", "get_host");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "threaded_polling"), "set_threaded_polling_enabled", "is_threaded_polling_enabled");
 }
 
 ENetMultiplayerPeer::ENetMultiplayerPeer() {
@@ -491,6 +588,7 @@ ENetMultiplayerPeer::~ENetMultiplayerPeer() {
 	if (_is_active()) {
 		close();
 	}
+	_stop_poll_thread();
 }
 
 // Sets IP for ENet to bind when using create_server or create_client
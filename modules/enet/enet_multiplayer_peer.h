@@ -32,6 +32,9 @@
 #define ENET_MULTIPLAYER_PEER_H
 
 #include "core/crypto/crypto.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
 #include "scene/main/multiplayer_peer.h"
 
 #include "enet_connection.h"
@@ -77,11 +80,32 @@ private:
 		TransferMode transfer_mode = TRANSFER_MODE_RELIABLE;
 	};
 
+	struct HostEvent {
+		int host = 0;
+		ENetConnection::EventType type = ENetConnection::EVENT_NONE;
+		ENetConnection::Event event;
+	};
+
 	List<Packet> incoming_packets;
 
 	Packet current_packet;
 
-	void _store_packet(int32_t p_source, ENetConnection::Event &p_event);
+	// Threaded polling, the hosts are serviced by the polling thread and the events are processed on poll.
+	enum {
+		POLL_THREAD_INTERVAL_USEC = 1000,
+	};
+	bool threaded_polling = false;
+	Thread poll_thread;
+	SafeFlag poll_thread_exit;
+	Mutex mutex; // Guards the hosts and peers while the polling thread is running.
+	LocalVector<HostEvent> thread_events;
+
+	static void _poll_thread_func(void *p_user);
+	void _start_poll_thread();
+	void _stop_poll_thread();
+	void _service_hosts(LocalVector<HostEvent> &r_events);
+	void _process_events(const LocalVector<HostEvent> &p_events);
+	void _store_packet(int32_t p_source, const ENetConnection::Event &p_event);
 	void _pop_current_packet();
 	void _disconnect_inactive_peers();
 	void _destroy_unused(ENetPacket *p_packet);
@@ -125,6 +149,9 @@ public:
 
 	void set_bind_ip(const IPAddress &p_ip);
 
+	void set_threaded_polling_enabled(bool p_enabled);
+	bool is_threaded_polling_enabled() const;
+
 	Ref<ENetConnection> get_host() const;
 	Ref<ENetPacketPeer> get_peer(int p_id) const;
 
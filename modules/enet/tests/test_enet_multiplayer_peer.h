@@ -0,0 +1,149 @@
+/**************************************************************************/
+/*  test_enet_multiplayer_peer.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_ENET_MULTIPLAYER_PEER_H
+#define TEST_ENET_MULTIPLAYER_PEER_H
+
+#include "modules/enet/enet_multiplayer_peer.h"
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestENetMultiplayerPeer {
+
+static const int TEST_PORT = 27415;
+
+// Records the connection signals, and whether they were emitted outside the main thread.
+class ENetEventRecorder : public Object {
+	GDCLASS(ENetEventRecorder, Object);
+
+public:
+	Vector<int> connected;
+	bool emitted_off_main_thread = false;
+
+	void peer_connected(int p_id) {
+		connected.push_back(p_id);
+		if (Thread::get_caller_id() != Thread::get_main_id()) {
+			emitted_off_main_thread = true;
+		}
+	}
+};
+
+// Polls both peers until a packet is available on p_to, for about two seconds at most.
+static bool poll_until_packet(Ref<ENetMultiplayerPeer> &p_from, Ref<ENetMultiplayerPeer> &p_to) {
+	for (int i = 0; i < 2000; i++) {
+		p_from->poll();
+		p_to->poll();
+		if (p_to->get_available_packet_count() > 0) {
+			return true;
+		}
+		OS::get_singleton()->delay_usec(1000);
+	}
+	return false;
+}
+
+TEST_CASE("[ENetMultiplayerPeer] Threaded polling services the hosts and dispatches the events on poll") {
+	ENetEventRecorder server_events;
+	ENetEventRecorder client_events;
+	Ref<ENetMultiplayerPeer> server;
+	server.instantiate();
+	Ref<ENetMultiplayerPeer> client;
+	client.instantiate();
+	server->connect(SNAME("peer_connected"), callable_mp(&server_events, &ENetEventRecorder::peer_connected));
+	client->connect(SNAME("peer_connected"), callable_mp(&client_events, &ENetEventRecorder::peer_connected));
+
+	// The polling threads start with the hosts.
+	server->set_threaded_polling_enabled(true);
+	client->set_threaded_polling_enabled(true);
+	REQUIRE(server->create_server(TEST_PORT) == OK);
+	REQUIRE(client->create_client("127.0.0.1", TEST_PORT) == OK);
+	CHECK(server->is_threaded_polling_enabled());
+
+	// The handshake completes on the polling threads, nobody polls meanwhile.
+	OS::get_singleton()->delay_usec(500000);
+	CHECK(client->get_connection_status() == MultiplayerPeer::CONNECTION_CONNECTING);
+	CHECK(server_events.connected.is_empty());
+	CHECK(client_events.connected.is_empty());
+
+	// The queued events are dispatched on the thread calling poll.
+	server->poll();
+	client->poll();
+	CHECK(client->get_connection_status() == MultiplayerPeer::CONNECTION_CONNECTED);
+	REQUIRE(server_events.connected.size() == 1);
+	REQUIRE(client_events.connected.size() == 1);
+	CHECK(client_events.connected[0] == 1);
+	const int client_id = server_events.connected[0];
+	CHECK(client_id == client->get_unique_id());
+
+	const uint8_t threaded_data[3] = { 1, 2, 3 };
+	client->set_transfer_mode(MultiplayerPeer::TRANSFER_MODE_RELIABLE);
+	CHECK(client->put_packet(threaded_data, 3) == OK);
+	REQUIRE(poll_until_packet(client, server));
+	CHECK(server->get_packet_peer() == client_id);
+	const uint8_t *buffer = nullptr;
+	int size = 0;
+	CHECK(server->get_packet(&buffer, size) == OK);
+	REQUIRE(size == 3);
+	CHECK(buffer[0] == 1);
+	CHECK(buffer[2] == 3);
+
+	// Stopping the threads keeps the peers connected, polling services the hosts again.
+	server->set_threaded_polling_enabled(false);
+	client->set_threaded_polling_enabled(false);
+	CHECK_FALSE(server->is_threaded_polling_enabled());
+	const uint8_t polled_data[2] = { 4, 5 };
+	CHECK(client->put_packet(polled_data, 2) == OK);
+	REQUIRE(poll_until_packet(client, server));
+	CHECK(server->get_packet(&buffer, size) == OK);
+	REQUIRE(size == 2);
+	CHECK(buffer[0] == 4);
+	CHECK(client->get_connection_status() == MultiplayerPeer::CONNECTION_CONNECTED);
+
+	// Restarting on an active peer works too.
+	server->set_threaded_polling_enabled(true);
+	CHECK(client->put_packet(threaded_data, 3) == OK);
+	REQUIRE(poll_until_packet(client, server));
+	CHECK(server->get_packet(&buffer, size) == OK);
+	CHECK(size == 3);
+
+	CHECK_FALSE(server_events.emitted_off_main_thread);
+	CHECK_FALSE(client_events.emitted_off_main_thread);
+
+	// Closing stops the polling thread.
+	client->close();
+	server->close();
+	CHECK(server->get_connection_status() == MultiplayerPeer::CONNECTION_DISCONNECTED);
+}
+
+} // namespace TestENetMultiplayerPeer
+
+#endif // TEST_ENET_MULTIPLAYER_PEER_H
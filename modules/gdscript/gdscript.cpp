@@ -44,6 +44,7 @@
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 #include "gdscript_rpc_callable.h"
+#include "gdscript_tokenizer_buffer.h"
 #include "gdscript_warning.h"
 
 #ifdef TESTS_ENABLED
@@ -859,7 +860,12 @@ Error GDScript::reload(bool p_keep_state) {
 
 	valid = false;
 	GDScriptParser parser;
-	Error err = parser.parse(source, path, false);
+	Error err;
+	if (binary_tokens.is_empty()) {
+		err = parser.parse(source, path, false);
+	} else {
+		err = parser.parse_binary(binary_tokens, path);
+	}
 	if (err) {
 		if (EngineDebugger::is_active()) {
 			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
@@ -1067,6 +1073,18 @@ Error GDScript::load_source_code(const String &p_path) {
 	return OK;
 }
 
+void GDScript::set_binary_tokens_source(const Vector<uint8_t> &p_binary_tokens) {
+	binary_tokens = p_binary_tokens;
+}
+
+uint64_t GDScript::get_source_hash() const {
+	// Binary tokens keep the hash of the source they were exported from.
+	if (!binary_tokens.is_empty()) {
+		return GDScriptTokenizerBuffer::get_source_hash(binary_tokens);
+	}
+	return source.hash64();
+}
+
 const HashMap<StringName, GDScriptFunction *> &GDScript::debug_get_member_functions() const {
 	return member_functions;
 }
@@ -1442,6 +1460,7 @@ void GDScript::clear(GDScript::ClearData *p_clear_data) {
 		clear_data->functions.insert(E.value);
 	}
 	member_functions.clear();
+	GDScriptInlineCache::invalidate_all();
 
 	for (KeyValue<StringName, GDScript::MemberInfo> &E : member_indices) {
 		clear_data->scripts.insert(E.value.data_type.script_type_ref);
@@ -2573,6 +2592,11 @@ GDScriptLanguage::GDScriptLanguage() {
 		_call_stack = nullptr;
 	}
 
+#ifdef TOOLS_ENABLED
+	GLOBAL_DEF("editor/export/convert_gdscript_to_binary_tokens", false);
+	GLOBAL_DEF(PropertyInfo(Variant::STRING, "editor/export/gdscript_native_code_path", PROPERTY_HINT_GLOBAL_SAVE_FILE, "*.cpp"), "");
+#endif
+
 #ifdef DEBUG_ENABLED
 	GLOBAL_DEF("debug/gdscript/warnings/enable", true);
 	GLOBAL_DEF("debug/gdscript/warnings/exclude_addons", true);
@@ -2635,7 +2659,9 @@ Ref<Resource> ResourceFormatLoaderGDScript::load(const String &p_path, const Str
 	}
 
 	Error err;
-	Ref<GDScript> scr = GDScriptCache::get_full_script(p_path, err, "", p_cache_mode == CACHE_MODE_IGNORE);
+	// Exported scripts are remapped to their binary tokens, but they are still cached and referenced by their original path.
+	const String &script_path = p_original_path.is_empty() ? p_path : p_original_path;
+	Ref<GDScript> scr = GDScriptCache::get_full_script(script_path, err, "", p_cache_mode == CACHE_MODE_IGNORE);
 
 	if (scr.is_null()) {
 		// Don't fail loading because of parsing error.
@@ -2651,6 +2677,7 @@ Ref<Resource> ResourceFormatLoaderGDScript::load(const String &p_path, const Str
 
 void ResourceFormatLoaderGDScript::get_recognized_extensions(List<String> *p_extensions) const {
 	p_extensions->push_back("gd");
+	p_extensions->push_back("gdc");
 }
 
 bool ResourceFormatLoaderGDScript::handles_type(const String &p_type) const {
@@ -2659,7 +2686,7 @@ bool ResourceFormatLoaderGDScript::handles_type(const String &p_type) const {
 
 String ResourceFormatLoaderGDScript::get_resource_type(const String &p_path) const {
 	String el = p_path.get_extension().to_lower();
-	if (el == "gd") {
+	if (el == "gd" || el == "gdc") {
 		return "GDScript";
 	}
 	return "";
@@ -2669,14 +2696,20 @@ void ResourceFormatLoaderGDScript::get_dependencies(const String &p_path, List<S
 	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ);
 	ERR_FAIL_COND_MSG(file.is_null(), "Cannot open file '" + p_path + "'.");
 
-	String source = file->get_as_utf8_string();
-	if (source.is_empty()) {
-		return;
-	}
-
 	GDScriptParser parser;
-	if (OK != parser.parse(source, p_path, false)) {
-		return;
+	if (p_path.get_extension().to_lower() == "gdc") {
+		if (OK != parser.parse_binary(file->get_buffer(file->get_length()), p_path)) {
+			return;
+		}
+	} else {
+		String source = file->get_as_utf8_string();
+		if (source.is_empty()) {
+			return;
+		}
+
+		if (OK != parser.parse(source, p_path, false)) {
+			return;
+		}
 	}
 
 	for (const String &E : parser.get_dependencies()) {
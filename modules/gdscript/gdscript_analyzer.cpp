@@ -2682,6 +2682,36 @@ const char *check_for_renamed_identifier(String identifier, GDScriptParser::Node
 }
 #endif // SUGGEST_GODOT4_RENAMES
 
+// Values of these types are stored by reference or tied to runtime objects,
+// so a folded result could be shared between evaluations or go stale.
+static bool is_type_foldable(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::OBJECT:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL:
+			return false;
+		default:
+			return !Variant::is_type_shared(p_type) && p_type < Variant::PACKED_BYTE_ARRAY;
+	}
+}
+
+// General utility functions whose result only depends on their arguments.
+static bool is_utility_function_pure(const StringName &p_function, const Vector<GDScriptParser::ExpressionNode *> &p_arguments) {
+	if (Variant::get_utility_function_type(p_function) == Variant::UTILITY_FUNC_TYPE_MATH) {
+		return true;
+	}
+	if (p_function != SNAME("typeof") && p_function != SNAME("str") && p_function != SNAME("error_string") && p_function != SNAME("var_to_str") && p_function != SNAME("hash")) {
+		return false;
+	}
+	for (const GDScriptParser::ExpressionNode *argument : p_arguments) {
+		// Object strings and hashes contain instance IDs, which differ between runs.
+		if (argument->reduced_value.get_type() == Variant::OBJECT) {
+			return false;
+		}
+	}
+	return true;
+}
+
 void GDScriptAnalyzer::reduce_call(GDScriptParser::CallNode *p_call, bool p_is_await, bool p_is_root) {
 	bool all_is_constant = true;
 	HashMap<int, GDScriptParser::ArrayNode *> arrays; // For array literal to potentially type when passing.
@@ -2901,7 +2931,7 @@ void GDScriptAnalyzer::reduce_call(GDScriptParser::CallNode *p_call, bool p_is_a
 				push_error(vformat(R"*(Cannot get return value of call to "%s()" because it returns "void".)*", function_name), p_call);
 			}
 
-			if (all_is_constant && Variant::get_utility_function_type(function_name) == Variant::UTILITY_FUNC_TYPE_MATH) {
+			if (all_is_constant && is_utility_function_pure(function_name, p_call->arguments)) {
 				// Can call on compilation.
 				Vector<const Variant *> args;
 				for (int i = 0; i < p_call->arguments.size(); i++) {
@@ -3065,6 +3095,34 @@ void GDScriptAnalyzer::reduce_call(GDScriptParser::CallNode *p_call, bool p_is_a
 #endif // DEBUG_ENABLED
 
 		call_type = return_type;
+
+		if (all_is_constant && !is_vararg && callee_type == GDScriptParser::Node::SUBSCRIPT && base_type.kind == GDScriptParser::DataType::BUILTIN && is_type_foldable(base_type.builtin_type) && Variant::has_builtin_method_return_value(base_type.builtin_type, p_call->function_name)) {
+			// Pure builtin method on a constant base, e.g. `Vector2.RIGHT.rotated(PI)` or `Vector2.from_angle(0.5)`.
+			const GDScriptParser::ExpressionNode *base = static_cast<GDScriptParser::SubscriptNode *>(p_call->callee)->base;
+			bool can_fold = base_type.is_meta_type ? Variant::is_builtin_method_static(base_type.builtin_type, p_call->function_name) : (base->is_constant && Variant::is_builtin_method_const(base_type.builtin_type, p_call->function_name));
+
+			if (can_fold) {
+				Vector<const Variant *> args;
+				for (int i = 0; i < p_call->arguments.size(); i++) {
+					args.push_back(&(p_call->arguments[i]->reduced_value));
+				}
+
+				Variant value;
+				Callable::CallError err;
+				if (base_type.is_meta_type) {
+					Variant::call_static(base_type.builtin_type, p_call->function_name, (const Variant **)args.ptr(), args.size(), value, err);
+				} else {
+					Variant base_value = base->reduced_value;
+					base_value.callp(p_call->function_name, (const Variant **)args.ptr(), args.size(), value, err);
+				}
+
+				// Errors are reported at runtime as usual, only fold successful calls.
+				if (err.error == Callable::CallError::CALL_OK && is_type_foldable(value.get_type())) {
+					p_call->is_constant = true;
+					p_call->reduced_value = value;
+				}
+			}
+		}
 	} else {
 		bool found = false;
 
@@ -4141,12 +4199,12 @@ void GDScriptAnalyzer::reduce_ternary_op(GDScriptParser::TernaryOpNode *p_ternar
 
 	GDScriptParser::DataType result;
 
-	if (p_ternary_op->condition && p_ternary_op->condition->is_constant && p_ternary_op->true_expr->is_constant && p_ternary_op->false_expr && p_ternary_op->false_expr->is_constant) {
-		p_ternary_op->is_constant = true;
-		if (p_ternary_op->condition->reduced_value.booleanize()) {
-			p_ternary_op->reduced_value = p_ternary_op->true_expr->reduced_value;
-		} else {
-			p_ternary_op->reduced_value = p_ternary_op->false_expr->reduced_value;
+	if (p_ternary_op->condition && p_ternary_op->condition->is_constant && p_ternary_op->true_expr && p_ternary_op->false_expr) {
+		// Only the selected branch has to be constant, the other one is never evaluated.
+		GDScriptParser::ExpressionNode *selected = p_ternary_op->condition->reduced_value.booleanize() ? p_ternary_op->true_expr : p_ternary_op->false_expr;
+		if (selected->is_constant) {
+			p_ternary_op->is_constant = true;
+			p_ternary_op->reduced_value = selected->reduced_value;
 		}
 	}
 
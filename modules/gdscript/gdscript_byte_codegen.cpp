@@ -190,6 +190,8 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 #endif
 	append_opcode(GDScriptFunction::OPCODE_END);
 
+	thread_jumps();
+
 	for (int i = 0; i < temporaries.size(); i++) {
 		int stack_index = i + max_locals + RESERVED_STACK;
 		for (int j = 0; j < temporaries[i].bytecode_indices.size(); j++) {
@@ -406,6 +408,11 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 	function->_instruction_args_size = instr_args_max;
 	function->_ptrcall_args_size = ptrcall_max;
 
+	if (inline_cache_count) {
+		function->_inline_caches_ptr = memnew_arr(GDScriptInlineCache, inline_cache_count);
+		function->_inline_caches_count = inline_cache_count;
+	}
+
 #ifdef DEBUG_ENABLED
 	function->operator_names = operator_names;
 	function->setter_names = setter_names;
@@ -561,11 +568,7 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, Variant::NIL);
 
-		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
-		append(p_left_operand);
-		append(Address());
-		append(p_target);
-		append(op_func);
+		append_operator_validated(p_target, p_left_operand, Address(), op_func, Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, Variant::NIL));
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
@@ -594,11 +597,7 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
-		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
-		append(p_left_operand);
-		append(p_right_operand);
-		append(p_target);
-		append(op_func);
+		append_operator_validated(p_target, p_left_operand, p_right_operand, op_func, Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type));
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
@@ -653,16 +652,64 @@ void GDScriptByteCodeGenerator::write_type_test(const Address &p_target, const A
 	}
 }
 
-void GDScriptByteCodeGenerator::write_and_left_operand(const Address &p_left_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+void GDScriptByteCodeGenerator::append_operator_validated(const Address &p_target, const Address &p_left_operand, const Address &p_right_operand, Variant::ValidatedOperatorEvaluator p_operator_func, Variant::Type p_result_type) {
+	int pos = opcodes.size();
+	append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 	append(p_left_operand);
+	append(p_right_operand);
+	append(p_target);
+	append(p_operator_func);
+
+	last_operator_pos = pos;
+	last_operator_target = p_target;
+	last_operator_result = p_result_type;
+}
+
+void GDScriptByteCodeGenerator::append_assign(const Address &p_target, const Address &p_source) {
+	if (p_source.mode == Address::TEMPORARY && can_fuse_operator(p_source)) {
+		// Operator into a temporary, then copied: do both in one instruction.
+		opcodes.write[last_operator_pos] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN;
+		last_operator_pos = -1;
+		append(p_target);
+		return;
+	}
+	append_opcode(GDScriptFunction::OPCODE_ASSIGN);
+	append(p_target);
+	append(p_source);
+}
+
+void GDScriptByteCodeGenerator::append_jump_if_not(const Address &p_condition) {
+	if (last_operator_result == Variant::BOOL && can_fuse_operator(p_condition)) {
+		// Comparison directly followed by the branch on its result.
+		opcodes.write[last_operator_pos] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+		last_operator_pos = -1;
+		jump_operands.push_back(opcodes.size()); // The caller appends the target.
+		return;
+	}
+	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+	append(p_condition);
+}
+
+void GDScriptByteCodeGenerator::thread_jumps() {
+	// Jumps landing on an unconditional jump go straight to its destination,
+	// which is common at the end of branches nested in loops.
+	for (int operand : jump_operands) {
+		int to = opcodes[operand];
+		for (int i = 0; i < 8 && jump_instructions.has(to); i++) {
+			to = opcodes[to + 1];
+		}
+		opcodes.write[operand] = to;
+	}
+}
+
+void GDScriptByteCodeGenerator::write_and_left_operand(const Address &p_left_operand) {
+	append_jump_if_not(p_left_operand);
 	logic_op_jump_pos1.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
 
 void GDScriptByteCodeGenerator::write_and_right_operand(const Address &p_right_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_right_operand);
+	append_jump_if_not(p_right_operand);
 	logic_op_jump_pos2.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
@@ -718,16 +765,13 @@ void GDScriptByteCodeGenerator::write_start_ternary(const Address &p_target) {
 }
 
 void GDScriptByteCodeGenerator::write_ternary_condition(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	append_jump_if_not(p_condition);
 	ternary_jump_fail_pos.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
 
 void GDScriptByteCodeGenerator::write_ternary_true_expr(const Address &p_expr) {
-	append_opcode(GDScriptFunction::OPCODE_ASSIGN);
-	append(ternary_result.back()->get());
-	append(p_expr);
+	append_assign(ternary_result.back()->get(), p_expr);
 	// Jump away from the false path.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
 	ternary_jump_skip_pos.push_back(opcodes.size());
@@ -738,9 +782,7 @@ void GDScriptByteCodeGenerator::write_ternary_true_expr(const Address &p_expr) {
 }
 
 void GDScriptByteCodeGenerator::write_ternary_false_expr(const Address &p_expr) {
-	append_opcode(GDScriptFunction::OPCODE_ASSIGN);
-	append(ternary_result.back()->get());
-	append(p_expr);
+	append_assign(ternary_result.back()->get(), p_expr);
 }
 
 void GDScriptByteCodeGenerator::write_end_ternary() {
@@ -822,6 +864,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -840,6 +883,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -918,9 +962,7 @@ void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Addr
 		append(p_source);
 		append(p_target.type.builtin_type);
 	} else {
-		append_opcode(GDScriptFunction::OPCODE_ASSIGN);
-		append(p_target);
-		append(p_source);
+		append_assign(p_target, p_source);
 	}
 }
 
@@ -941,6 +983,7 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 		write_assign(p_dst, p_src);
 	}
 	function->default_arguments.push_back(opcodes.size());
+	last_operator_pos = -1; // Entry point for the next default argument.
 }
 
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
@@ -1011,6 +1054,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1036,6 +1080,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1284,6 +1329,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1297,6 +1343,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1310,6 +1357,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1427,8 +1475,7 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	append_jump_if_not(p_condition);
 	if_jmp_addrs.push_back(opcodes.size());
 	append(0); // Jump destination, will be patched.
 }
@@ -1622,12 +1669,12 @@ void GDScriptByteCodeGenerator::write_endfor() {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	last_operator_pos = -1; // Loop start, jumped back to.
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	append_jump_if_not(p_condition);
 	while_jmp_addrs.push_back(opcodes.size());
 	append(0); // End of loop address, will be patched.
 }
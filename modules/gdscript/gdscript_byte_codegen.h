@@ -36,6 +36,8 @@
 #include "gdscript_function.h"
 #include "gdscript_utility_functions.h"
 
+#include "core/templates/hash_set.h"
+
 class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	struct StackSlot {
 		Variant::Type type = Variant::NIL;
@@ -98,6 +100,16 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int current_line = 0;
 	int instr_args_max = 0;
 	int ptrcall_max = 0;
+	int inline_cache_count = 0;
+
+	// Peephole state. The last instruction, if it is a validated operator
+	// that can be fused with the assignment or conditional jump using its
+	// result, and the jumps that get threaded when the function ends.
+	int last_operator_pos = -1;
+	Address last_operator_target;
+	Variant::Type last_operator_result = Variant::NIL;
+	Vector<int> jump_operands;
+	HashSet<int> jump_instructions;
 
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
@@ -378,10 +390,18 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	}
 
 	void append_opcode(GDScriptFunction::Opcode p_code) {
+		last_operator_pos = -1;
+		if (p_code == GDScriptFunction::OPCODE_JUMP) {
+			jump_instructions.insert(opcodes.size());
+			jump_operands.push_back(opcodes.size() + 1);
+		} else if (p_code == GDScriptFunction::OPCODE_JUMP_IF || p_code == GDScriptFunction::OPCODE_JUMP_IF_NOT) {
+			jump_operands.push_back(opcodes.size() + 2);
+		}
 		opcodes.push_back(p_code);
 	}
 
 	void append_opcode_and_argcount(GDScriptFunction::Opcode p_code, int p_argument_count) {
+		last_operator_pos = -1;
 		opcodes.push_back(p_code);
 		opcodes.push_back(p_argument_count);
 		instr_args_max = MAX(instr_args_max, p_argument_count);
@@ -399,6 +419,10 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(get_name_map_pos(p_name));
 	}
 
+	void append_inline_cache() {
+		opcodes.push_back(inline_cache_count++);
+	}
+
 	void append(const Variant::ValidatedOperatorEvaluator p_operation) {
 		opcodes.push_back(get_operation_pos(p_operation));
 	}
@@ -453,8 +477,18 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		last_operator_pos = -1; // Something jumps between it and the next instruction.
+	}
+
+	bool can_fuse_operator(const Address &p_result) const {
+		return last_operator_pos >= 0 && last_operator_pos + 5 == opcodes.size() && last_operator_target.mode == p_result.mode && last_operator_target.address == p_result.address;
 	}
 
+	void append_operator_validated(const Address &p_target, const Address &p_left_operand, const Address &p_right_operand, Variant::ValidatedOperatorEvaluator p_operator_func, Variant::Type p_result_type);
+	void append_assign(const Address &p_target, const Address &p_source);
+	void append_jump_if_not(const Address &p_condition);
+	void thread_jumps();
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
@@ -31,6 +31,7 @@
 #include "gdscript_cache.h"
 
 #include "core/io/file_access.h"
+#include "core/io/resource_loader.h"
 #include "core/templates/vector.h"
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
@@ -68,7 +69,14 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 		switch (status) {
 			case EMPTY:
 				status = PARSED;
-				result = parser->parse(GDScriptCache::get_source_code(path), path, false);
+				{
+					String remapped_path = ResourceLoader::path_remap(path);
+					if (remapped_path.get_extension().to_lower() == "gdc") {
+						result = parser->parse_binary(GDScriptCache::get_binary_tokens(remapped_path), path);
+					} else {
+						result = parser->parse(GDScriptCache::get_source_code(remapped_path), path, false);
+					}
+				}
 				break;
 			case PARSED: {
 				status = INHERITANCE_SOLVED;
@@ -238,6 +246,32 @@ String GDScriptCache::get_source_code(const String &p_path) {
 	return source;
 }
 
+Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
+	Vector<uint8_t> buffer;
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(err, buffer, "Failed to open binary GDScript file '" + p_path + "'.");
+
+	uint64_t len = f->get_length();
+	buffer.resize(len);
+	uint64_t r = f->get_buffer(buffer.ptrw(), len);
+	ERR_FAIL_COND_V(r != len, Vector<uint8_t>());
+
+	return buffer;
+}
+
+Error GDScriptCache::load_script_source(GDScript *p_script, const String &p_path) {
+	// Exported projects can remap scripts to their binary tokens.
+	String remapped_path = ResourceLoader::path_remap(p_path);
+	if (remapped_path.get_extension().to_lower() == "gdc") {
+		Vector<uint8_t> buffer = get_binary_tokens(remapped_path);
+		ERR_FAIL_COND_V(buffer.is_empty(), ERR_FILE_CANT_OPEN);
+		p_script->set_binary_tokens_source(buffer);
+		return OK;
+	}
+	return p_script->load_source_code(p_path);
+}
+
 Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_error, const String &p_owner) {
 	MutexLock lock(singleton->mutex);
 	if (!p_owner.is_empty()) {
@@ -253,7 +287,7 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 	Ref<GDScript> script;
 	script.instantiate();
 	script->set_path(p_path, true);
-	script->load_source_code(p_path);
+	load_script_source(script.ptr(), p_path);
 
 	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
 	if (r_error == OK) {
@@ -288,7 +322,7 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 	}
 
 	if (p_update_from_disk) {
-		r_error = script->load_source_code(p_path);
+		r_error = load_script_source(script.ptr(), p_path);
 	}
 
 	if (r_error) {
@@ -33,10 +33,12 @@
 #include "gdscript.h"
 #include "gdscript_byte_codegen.h"
 #include "gdscript_cache.h"
+#include "gdscript_cpp_codegen.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
+#include "core/debugger/engine_debugger.h"
 
 bool GDScriptCompiler::_is_class_member_property(CodeGen &codegen, const StringName &p_name) {
 	if (codegen.function_node && codegen.function_node->is_static) {
@@ -826,6 +828,15 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 		case GDScriptParser::Node::TERNARY_OPERATOR: {
 			// x IF a ELSE y operator with early out on failure.
 			const GDScriptParser::TernaryOpNode *ternary = static_cast<const GDScriptParser::TernaryOpNode *>(p_expression);
+
+			if (ternary->condition->is_constant) {
+				// Only evaluate the selected branch, as long as its type matches what the caller expects.
+				const GDScriptParser::ExpressionNode *selected = ternary->condition->reduced_value.booleanize() ? ternary->true_expr : ternary->false_expr;
+				if (!ternary->get_datatype().is_hard_type() || selected->get_datatype() == ternary->get_datatype()) {
+					return _parse_expression(codegen, r_error, selected);
+				}
+			}
+
 			GDScriptCodeGenerator::Address result = codegen.add_temporary(_gdtype_from_datatype(ternary->get_datatype(), codegen.script));
 
 			gen->write_start_ternary(result);
@@ -1761,6 +1772,19 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 			} break;
 			case GDScriptParser::Node::IF: {
 				const GDScriptParser::IfNode *if_n = static_cast<const GDScriptParser::IfNode *>(s);
+
+				if (if_n->condition->is_constant) {
+					// Condition is known at compile time, so only the taken branch is emitted.
+					const GDScriptParser::SuiteNode *taken = if_n->condition->reduced_value.booleanize() ? if_n->true_block : if_n->false_block;
+					if (taken) {
+						err = _parse_block(codegen, taken);
+						if (err) {
+							return err;
+						}
+					}
+					break;
+				}
+
 				GDScriptCodeGenerator::Address condition = _parse_expression(codegen, err, if_n->condition);
 				if (err) {
 					return err;
@@ -1821,6 +1845,11 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 			case GDScriptParser::Node::WHILE: {
 				const GDScriptParser::WhileNode *while_n = static_cast<const GDScriptParser::WhileNode *>(s);
 
+				if (while_n->condition->is_constant && !while_n->condition->reduced_value.booleanize()) {
+					// Loop body can never run.
+					break;
+				}
+
 				gen->start_while_condition();
 
 				GDScriptCodeGenerator::Address condition = _parse_expression(codegen, err, while_n->condition);
@@ -1977,6 +2006,11 @@ GDScriptFunction *GDScriptCompiler::_parse_function(Error &r_error, GDScript *p_
 	r_error = OK;
 	CodeGen codegen;
 	codegen.generator = memnew(GDScriptByteCodeGenerator);
+#ifdef TOOLS_ENABLED
+	if (native_code_unit && p_func && !p_for_lambda) {
+		codegen.generator = memnew(GDScriptCppCodeGenerator(codegen.generator, native_code_unit, native_source_hash));
+	}
+#endif
 
 	codegen.class_node = p_class;
 	codegen.script = p_script;
@@ -2164,6 +2198,11 @@ GDScriptFunction *GDScriptCompiler::_parse_function(Error &r_error, GDScript *p_
 
 	GDScriptFunction *gd_function = codegen.generator->write_end();
 
+	if (p_func && !p_for_lambda && GDScriptNativeFunctions::has_functions() && !EngineDebugger::is_active()) {
+		// Use the C++ translation made at export time, if the source still matches.
+		gd_function->native_call = GDScriptNativeFunctions::get_function(p_script->fully_qualified_name, func_name, native_source_hash);
+	}
+
 	if (is_initializer) {
 		p_script->initializer = gd_function;
 	} else if (is_implicit_initializer) {
@@ -2249,6 +2288,12 @@ Error GDScriptCompiler::_populate_class_members(GDScript *p_script, const GDScri
 	p_script->_base = nullptr;
 	p_script->members.clear();
 
+	// Cached member indices and functions of this script are about to become invalid. A script compiled
+	// for the first time has no instances the caches could have seen, so loading scripts keeps them.
+	if (p_script->implicit_initializer || !p_script->member_functions.is_empty() || !p_script->member_indices.is_empty()) {
+		GDScriptInlineCache::invalidate_all();
+	}
+
 	// This makes possible to clear script constants and member_functions without heap-use-after-free errors.
 	HashMap<StringName, Variant> constants;
 	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
@@ -2708,6 +2753,14 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 
 	source = p_script->get_path();
 
+	bool uses_native_code = GDScriptNativeFunctions::has_functions();
+#ifdef TOOLS_ENABLED
+	uses_native_code = uses_native_code || native_code_unit;
+#endif
+	if (uses_native_code) {
+		native_source_hash = p_script->get_source_hash();
+	}
+
 	// Create scripts for subclasses beforehand so they can be referenced
 	make_scripts(p_script, root, p_keep_state);
 
@@ -37,6 +37,8 @@
 #include "gdscript_function.h"
 #include "gdscript_parser.h"
 
+class GDScriptNativeCodeUnit;
+
 class GDScriptCompiler {
 	const GDScriptParser *parser = nullptr;
 	HashSet<GDScript *> parsed_classes;
@@ -138,6 +140,10 @@ class GDScriptCompiler {
 	StringName source;
 	String error;
 	GDScriptParser::ExpressionNode *awaited_node = nullptr;
+	uint64_t native_source_hash = 0;
+#ifdef TOOLS_ENABLED
+	GDScriptNativeCodeUnit *native_code_unit = nullptr;
+#endif
 
 public:
 	static void convert_to_initializer_type(Variant &p_variant, const GDScriptParser::VariableNode *p_node);
@@ -148,6 +154,11 @@ public:
 	int get_error_line() const;
 	int get_error_column() const;
 
+#ifdef TOOLS_ENABLED
+	// Also translate the functions to C++ into the given unit while compiling.
+	void set_native_code_unit(GDScriptNativeCodeUnit *p_unit) { native_code_unit = p_unit; }
+#endif
+
 	GDScriptCompiler();
 };
 
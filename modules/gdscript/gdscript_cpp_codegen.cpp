@@ -0,0 +1,958 @@
+/**************************************************************************/
+/*  gdscript_cpp_codegen.cpp                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_cpp_codegen.h"
+
+#ifdef TOOLS_ENABLED
+
+#include "gdscript.h"
+#include "gdscript_analyzer.h"
+#include "gdscript_compiler.h"
+#include "gdscript_parser.h"
+
+#include "core/io/file_access.h"
+
+Error GDScriptNativeCodeUnit::add_script(const String &p_path) {
+	Error err = OK;
+	String source = FileAccess::get_file_as_string(p_path, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Cannot read GDScript file '" + p_path + "'.");
+
+	GDScriptParser parser;
+	err = parser.parse(source, p_path, false);
+	if (err == OK) {
+		GDScriptAnalyzer analyzer(&parser);
+		err = analyzer.analyze();
+	}
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Cannot translate GDScript file '" + p_path + "' to C++: it has errors.");
+
+	// Compile into a throwaway script, the one in the cache must not be touched.
+	Ref<GDScript> script;
+	script.instantiate();
+	script->path = p_path;
+	script->set_source_code(source);
+
+	GDScriptCompiler compiler;
+	compiler.set_native_code_unit(this);
+	err = compiler.compile(&parser, script.ptr(), false);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Cannot translate GDScript file '" + p_path + "' to C++: " + compiler.get_error());
+
+	return OK;
+}
+
+void GDScriptNativeCodeUnit::add_function(const String &p_class, const StringName &p_function, uint64_t p_source_hash, const String &p_body) {
+	String symbol = "_gdscript_native_" + itos(function_count++);
+	String name = p_class + "::" + String(p_function);
+
+	functions_code += "// " + name + "\n";
+	functions_code += "static Variant " + symbol + "(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {\n";
+	functions_code += p_body;
+	functions_code += "}\n\n";
+
+	registrations += vformat("\tGDScriptNativeFunctions::register_function(\"%s\", \"%s\", %sULL, &%s);\n", p_class.c_escape(), String(p_function).c_escape(), String::num_uint64(p_source_hash), symbol);
+}
+
+String GDScriptNativeCodeUnit::get_source() const {
+	String source;
+	source += "/* THIS FILE IS GENERATED BY THE GDSCRIPT EXPORTER, DO NOT EDIT. */\n\n";
+	source += "#include \"core/math/math_funcs.h\"\n";
+	source += "#include \"modules/gdscript/gdscript_native_functions.h\"\n\n";
+	source += functions_code;
+	source += "void register_gdscript_native_functions() {\n";
+	source += registrations;
+	source += "}\n";
+	return source;
+}
+
+bool GDScriptCppCodeGenerator::_is_native_type(const GDScriptDataType &p_type) {
+	if (!p_type.has_type || p_type.kind != GDScriptDataType::BUILTIN) {
+		return false;
+	}
+	return p_type.builtin_type == Variant::BOOL || p_type.builtin_type == Variant::INT || p_type.builtin_type == Variant::FLOAT;
+}
+
+String GDScriptCppCodeGenerator::_get_type_name(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::BOOL:
+			return "bool";
+		case Variant::INT:
+			return "int64_t";
+		case Variant::FLOAT:
+			return "double";
+		default:
+			ERR_FAIL_V_MSG(String(), "Type can't be translated to C++.");
+	}
+}
+
+String GDScriptCppCodeGenerator::_get_literal(const Variant &p_value) {
+	switch (p_value.get_type()) {
+		case Variant::BOOL:
+			return bool(p_value) ? "true" : "false";
+		case Variant::INT: {
+			int64_t value = p_value;
+			if (value == INT64_MIN) {
+				return "INT64_MIN";
+			}
+			return "int64_t(" + itos(value) + "LL)";
+		}
+		case Variant::FLOAT: {
+			double value = p_value;
+			if (Math::is_nan(value)) {
+				return "double(NAN)";
+			}
+			if (Math::is_inf(value)) {
+				return value > 0 ? "double(INFINITY)" : "-double(INFINITY)";
+			}
+			// Hexadecimal notation round-trips exactly.
+			char buffer[64];
+			snprintf(buffer, sizeof(buffer), "%a", value);
+			return String(buffer);
+		}
+		default:
+			ERR_FAIL_V_MSG(String(), "Value can't be translated to C++.");
+	}
+}
+
+String GDScriptCppCodeGenerator::_get_default_literal(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::BOOL:
+			return _get_literal(false);
+		case Variant::INT:
+			return _get_literal(int64_t(0));
+		case Variant::FLOAT:
+			return _get_literal(0.0);
+		default:
+			ERR_FAIL_V_MSG(String(), "Type can't be translated to C++.");
+	}
+}
+
+String GDScriptCppCodeGenerator::_get_variable(const String &p_prefix, uint32_t p_index, Variant::Type p_type) {
+	String name = p_prefix + itos(p_index) + "_" + Variant::get_type_name(p_type).to_lower();
+	variables[name] = p_type;
+	return name;
+}
+
+String GDScriptCppCodeGenerator::_get_address(const Address &p_address, Variant::Type &r_type) {
+	r_type = Variant::NIL;
+
+	switch (p_address.mode) {
+		case Address::CONSTANT: {
+			HashMap<uint32_t, Variant>::ConstIterator E = constants.find(p_address.address);
+			if (!E) {
+				break;
+			}
+			r_type = E->value.get_type();
+			if (r_type != Variant::BOOL && r_type != Variant::INT && r_type != Variant::FLOAT) {
+				break;
+			}
+			return _get_literal(E->value);
+		}
+		case Address::LOCAL_VARIABLE:
+		case Address::FUNCTION_PARAMETER:
+			if (!_is_native_type(p_address.type)) {
+				break;
+			}
+			r_type = p_address.type.builtin_type;
+			return _get_variable("s", p_address.address, r_type);
+		case Address::TEMPORARY:
+			if (!_is_native_type(p_address.type)) {
+				break;
+			}
+			r_type = p_address.type.builtin_type;
+			return _get_variable("t", p_address.address, r_type);
+		default:
+			break;
+	}
+
+	_unsupported();
+	return String();
+}
+
+String GDScriptCppCodeGenerator::_get_address_as(const Address &p_address, Variant::Type p_type) {
+	Variant::Type type;
+	String expression = _get_address(p_address, type);
+	if (type == p_type) {
+		return expression;
+	}
+	return _get_type_name(p_type) + "(" + expression + ")";
+}
+
+void GDScriptCppCodeGenerator::_write_line(const String &p_line) {
+	for (int i = 0; i < indent; i++) {
+		code += "\t";
+	}
+	code += p_line + "\n";
+}
+
+void GDScriptCppCodeGenerator::_write_assign(const Address &p_target, const String &p_expression, Variant::Type p_type) {
+	Variant::Type target_type;
+	String target = _get_address(p_target, target_type);
+	if (!supported || p_target.mode == Address::CONSTANT) {
+		_unsupported();
+		return;
+	}
+	if (target_type == p_type) {
+		_write_line(target + " = " + p_expression + ";");
+	} else {
+		_write_line(target + " = " + _get_type_name(target_type) + "(" + p_expression + ");");
+	}
+}
+
+uint32_t GDScriptCppCodeGenerator::add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) {
+	uint32_t address = bytecode->add_parameter(p_name, p_is_optional, p_type);
+	if (p_is_optional || !_is_native_type(p_type)) {
+		_unsupported();
+	} else {
+		String name = _get_variable("s", address, p_type.builtin_type);
+		parameters_code += vformat("\t%s = p_args[%d]->operator %s();\n", name, parameter_count, _get_type_name(p_type.builtin_type));
+	}
+	parameter_count++;
+	return address;
+}
+
+uint32_t GDScriptCppCodeGenerator::add_local(const StringName &p_name, const GDScriptDataType &p_type) {
+	return bytecode->add_local(p_name, p_type);
+}
+
+uint32_t GDScriptCppCodeGenerator::add_local_constant(const StringName &p_name, const Variant &p_constant) {
+	uint32_t index = bytecode->add_local_constant(p_name, p_constant);
+	constants[index] = p_constant;
+	return index;
+}
+
+uint32_t GDScriptCppCodeGenerator::add_or_get_constant(const Variant &p_constant) {
+	uint32_t index = bytecode->add_or_get_constant(p_constant);
+	constants[index] = p_constant;
+	return index;
+}
+
+uint32_t GDScriptCppCodeGenerator::add_or_get_name(const StringName &p_name) {
+	return bytecode->add_or_get_name(p_name);
+}
+
+uint32_t GDScriptCppCodeGenerator::add_temporary(const GDScriptDataType &p_type) {
+	return bytecode->add_temporary(p_type);
+}
+
+void GDScriptCppCodeGenerator::pop_temporary() {
+	bytecode->pop_temporary();
+}
+
+void GDScriptCppCodeGenerator::start_parameters() {
+	bytecode->start_parameters();
+}
+
+void GDScriptCppCodeGenerator::end_parameters() {
+	bytecode->end_parameters();
+}
+
+void GDScriptCppCodeGenerator::start_block() {
+	// Variables are all declared at the top of the C++ function, no scope needed.
+	bytecode->start_block();
+}
+
+void GDScriptCppCodeGenerator::end_block() {
+	bytecode->end_block();
+}
+
+void GDScriptCppCodeGenerator::write_start(GDScript *p_script, const StringName &p_function_name, bool p_static, Variant p_rpc_config, const GDScriptDataType &p_return_type) {
+	bytecode->write_start(p_script, p_function_name, p_static, p_rpc_config, p_return_type);
+	class_name = p_script->get_fully_qualified_name();
+	function_name = p_function_name;
+	return_type = p_return_type;
+}
+
+GDScriptFunction *GDScriptCppCodeGenerator::write_end() {
+	GDScriptFunction *function = bytecode->write_end();
+	if (!supported) {
+		return function;
+	}
+
+	String body;
+	for (const KeyValue<String, Variant::Type> &E : variables) {
+		body += vformat("\t%s %s = %s;\n", _get_type_name(E.value), E.key, _get_default_literal(E.value));
+	}
+	body += "\t(void)p_instance;\n";
+	body += "\t(void)p_args;\n";
+	body += "\t(void)p_argcount;\n";
+	body += "\t(void)r_error;\n";
+	body += parameters_code;
+	body += code;
+	body += "\treturn Variant();\n";
+
+	unit->add_function(class_name, function_name, source_hash, body);
+	return function;
+}
+
+#ifdef DEBUG_ENABLED
+void GDScriptCppCodeGenerator::set_signature(const String &p_signature) {
+	bytecode->set_signature(p_signature);
+}
+#endif
+
+void GDScriptCppCodeGenerator::set_initial_line(int p_line) {
+	bytecode->set_initial_line(p_line);
+}
+
+void GDScriptCppCodeGenerator::write_type_adjust(const Address &p_target, Variant::Type p_new_type) {
+	bytecode->write_type_adjust(p_target, p_new_type);
+	// C++ variables always hold a value of their type.
+	if (!_is_native_type(p_target.type) || p_target.type.builtin_type != p_new_type) {
+		_unsupported();
+	}
+}
+
+void GDScriptCppCodeGenerator::write_unary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand) {
+	bytecode->write_unary_operator(p_target, p_operator, p_left_operand);
+	if (!supported) {
+		return;
+	}
+
+	Variant::Type left_type;
+	String left = _get_address(p_left_operand, left_type);
+	Variant::Type result_type = Variant::get_operator_return_type(p_operator, left_type, Variant::NIL);
+	if (!supported || (result_type != Variant::BOOL && result_type != Variant::INT && result_type != Variant::FLOAT)) {
+		_unsupported();
+		return;
+	}
+
+	String expression;
+	switch (p_operator) {
+		case Variant::OP_NEGATE:
+			expression = "-(" + left + ")";
+			break;
+		case Variant::OP_POSITIVE:
+			expression = left;
+			break;
+		case Variant::OP_NOT:
+			expression = "!(" + left + ")";
+			break;
+		case Variant::OP_BIT_NEGATE:
+			expression = "~(" + left + ")";
+			break;
+		default:
+			_unsupported();
+			return;
+	}
+	_write_assign(p_target, expression, result_type);
+}
+
+void GDScriptCppCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
+	bytecode->write_binary_operator(p_target, p_operator, p_left_operand, p_right_operand);
+	if (!supported) {
+		return;
+	}
+
+	Variant::Type left_type;
+	Variant::Type right_type;
+	String left = _get_address(p_left_operand, left_type);
+	String right = _get_address(p_right_operand, right_type);
+	Variant::Type result_type = Variant::get_operator_return_type(p_operator, left_type, right_type);
+	if (!supported || (result_type != Variant::BOOL && result_type != Variant::INT && result_type != Variant::FLOAT)) {
+		_unsupported();
+		return;
+	}
+
+	String expression;
+	switch (p_operator) {
+		case Variant::OP_EQUAL:
+			expression = left + " == " + right;
+			break;
+		case Variant::OP_NOT_EQUAL:
+			expression = left + " != " + right;
+			break;
+		case Variant::OP_LESS:
+			expression = left + " < " + right;
+			break;
+		case Variant::OP_LESS_EQUAL:
+			expression = left + " <= " + right;
+			break;
+		case Variant::OP_GREATER:
+			expression = left + " > " + right;
+			break;
+		case Variant::OP_GREATER_EQUAL:
+			expression = left + " >= " + right;
+			break;
+		case Variant::OP_ADD:
+			expression = left + " + " + right;
+			break;
+		case Variant::OP_SUBTRACT:
+			expression = left + " - " + right;
+			break;
+		case Variant::OP_MULTIPLY:
+			expression = left + " * " + right;
+			break;
+		case Variant::OP_DIVIDE:
+		case Variant::OP_MODULE: {
+			const char *symbol = p_operator == Variant::OP_DIVIDE ? "/" : "%";
+			if (result_type == Variant::INT) {
+				// Integer division by zero is a script error, not a crash.
+				_write_line("if (unlikely(" + right + " == 0)) {");
+				indent++;
+				_write_line(vformat("ERR_FAIL_V_MSG(Variant(), \"%s by zero error in operator '%s'.\");", p_operator == Variant::OP_DIVIDE ? "Division" : "Modulo", symbol));
+				indent--;
+				_write_line("}");
+			} else if (p_operator == Variant::OP_MODULE) {
+				_unsupported();
+				return;
+			}
+			expression = left + " " + symbol + " " + right;
+		} break;
+		case Variant::OP_POWER:
+			expression = "Math::pow(double(" + left + "), double(" + right + "))";
+			break;
+		case Variant::OP_SHIFT_LEFT:
+			expression = left + " << " + right;
+			break;
+		case Variant::OP_SHIFT_RIGHT:
+			expression = left + " >> " + right;
+			break;
+		case Variant::OP_BIT_AND:
+			expression = left + " & " + right;
+			break;
+		case Variant::OP_BIT_OR:
+			expression = left + " | " + right;
+			break;
+		case Variant::OP_BIT_XOR:
+			expression = left + " ^ " + right;
+			break;
+		case Variant::OP_AND:
+			expression = "bool(" + left + ") && bool(" + right + ")";
+			break;
+		case Variant::OP_OR:
+			expression = "bool(" + left + ") || bool(" + right + ")";
+			break;
+		case Variant::OP_XOR:
+			expression = "bool(" + left + ") != bool(" + right + ")";
+			break;
+		default:
+			_unsupported();
+			return;
+	}
+	_write_assign(p_target, expression, p_operator == Variant::OP_POWER ? Variant::FLOAT : result_type);
+}
+
+void GDScriptCppCodeGenerator::write_type_test(const Address &p_target, const Address &p_source, const GDScriptDataType &p_type) {
+	bytecode->write_type_test(p_target, p_source, p_type);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_and_left_operand(const Address &p_left_operand) {
+	bytecode->write_and_left_operand(p_left_operand);
+	if (!supported) {
+		return;
+	}
+	String result = _get_variable("c", condition_count++, Variant::BOOL);
+	_write_line(result + " = " + _get_address_as(p_left_operand, Variant::BOOL) + ";");
+	_write_line("if (" + result + ") {");
+	indent++;
+	logic_results.push_back(result);
+}
+
+void GDScriptCppCodeGenerator::write_and_right_operand(const Address &p_right_operand) {
+	bytecode->write_and_right_operand(p_right_operand);
+	if (!supported) {
+		return;
+	}
+	_write_line(logic_results.back()->get() + " = " + _get_address_as(p_right_operand, Variant::BOOL) + ";");
+	indent--;
+	_write_line("}");
+}
+
+void GDScriptCppCodeGenerator::write_end_and(const Address &p_target) {
+	bytecode->write_end_and(p_target);
+	if (!supported) {
+		return;
+	}
+	_write_assign(p_target, logic_results.back()->get(), Variant::BOOL);
+	logic_results.pop_back();
+}
+
+void GDScriptCppCodeGenerator::write_or_left_operand(const Address &p_left_operand) {
+	bytecode->write_or_left_operand(p_left_operand);
+	if (!supported) {
+		return;
+	}
+	String result = _get_variable("c", condition_count++, Variant::BOOL);
+	_write_line(result + " = " + _get_address_as(p_left_operand, Variant::BOOL) + ";");
+	_write_line("if (!" + result + ") {");
+	indent++;
+	logic_results.push_back(result);
+}
+
+void GDScriptCppCodeGenerator::write_or_right_operand(const Address &p_right_operand) {
+	bytecode->write_or_right_operand(p_right_operand);
+	if (!supported) {
+		return;
+	}
+	_write_line(logic_results.back()->get() + " = " + _get_address_as(p_right_operand, Variant::BOOL) + ";");
+	indent--;
+	_write_line("}");
+}
+
+void GDScriptCppCodeGenerator::write_end_or(const Address &p_target) {
+	bytecode->write_end_or(p_target);
+	if (!supported) {
+		return;
+	}
+	_write_assign(p_target, logic_results.back()->get(), Variant::BOOL);
+	logic_results.pop_back();
+}
+
+void GDScriptCppCodeGenerator::write_start_ternary(const Address &p_target) {
+	bytecode->write_start_ternary(p_target);
+	ternary_targets.push_back(p_target);
+}
+
+void GDScriptCppCodeGenerator::write_ternary_condition(const Address &p_condition) {
+	bytecode->write_ternary_condition(p_condition);
+	if (!supported) {
+		return;
+	}
+	_write_line("if (" + _get_address_as(p_condition, Variant::BOOL) + ") {");
+	indent++;
+}
+
+void GDScriptCppCodeGenerator::write_ternary_true_expr(const Address &p_expr) {
+	bytecode->write_ternary_true_expr(p_expr);
+	if (!supported) {
+		return;
+	}
+	Variant::Type type;
+	String expression = _get_address(p_expr, type);
+	_write_assign(ternary_targets.back()->get(), expression, type);
+	indent--;
+	_write_line("} else {");
+	indent++;
+}
+
+void GDScriptCppCodeGenerator::write_ternary_false_expr(const Address &p_expr) {
+	bytecode->write_ternary_false_expr(p_expr);
+	if (!supported) {
+		return;
+	}
+	Variant::Type type;
+	String expression = _get_address(p_expr, type);
+	_write_assign(ternary_targets.back()->get(), expression, type);
+}
+
+void GDScriptCppCodeGenerator::write_end_ternary() {
+	bytecode->write_end_ternary();
+	ternary_targets.pop_back();
+	if (!supported) {
+		return;
+	}
+	indent--;
+	_write_line("}");
+}
+
+void GDScriptCppCodeGenerator::write_set(const Address &p_target, const Address &p_index, const Address &p_source) {
+	bytecode->write_set(p_target, p_index, p_source);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_get(const Address &p_target, const Address &p_index, const Address &p_source) {
+	bytecode->write_get(p_target, p_index, p_source);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_set_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
+	bytecode->write_set_named(p_target, p_name, p_source);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
+	bytecode->write_get_named(p_target, p_name, p_source);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
+	bytecode->write_set_member(p_value, p_name);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_get_member(const Address &p_target, const StringName &p_name) {
+	bytecode->write_get_member(p_target, p_name);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_assign(const Address &p_target, const Address &p_source) {
+	bytecode->write_assign(p_target, p_source);
+	if (!supported) {
+		return;
+	}
+	Variant::Type type;
+	String expression = _get_address(p_source, type);
+	_write_assign(p_target, expression, type);
+}
+
+void GDScriptCppCodeGenerator::write_assign_with_conversion(const Address &p_target, const Address &p_source) {
+	bytecode->write_assign_with_conversion(p_target, p_source);
+	if (!supported) {
+		return;
+	}
+	Variant::Type type;
+	String expression = _get_address(p_source, type);
+	_write_assign(p_target, expression, type);
+}
+
+void GDScriptCppCodeGenerator::write_assign_true(const Address &p_target) {
+	bytecode->write_assign_true(p_target);
+	if (!supported) {
+		return;
+	}
+	_write_assign(p_target, "true", Variant::BOOL);
+}
+
+void GDScriptCppCodeGenerator::write_assign_false(const Address &p_target) {
+	bytecode->write_assign_false(p_target);
+	if (!supported) {
+		return;
+	}
+	_write_assign(p_target, "false", Variant::BOOL);
+}
+
+void GDScriptCppCodeGenerator::write_assign_default_parameter(const Address &p_dst, const Address &p_src, bool p_use_conversion) {
+	bytecode->write_assign_default_parameter(p_dst, p_src, p_use_conversion);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
+	bytecode->write_store_global(p_dst, p_global_index);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_store_named_global(const Address &p_dst, const StringName &p_global) {
+	bytecode->write_store_named_global(p_dst, p_global);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_cast(const Address &p_target, const Address &p_source, const GDScriptDataType &p_type) {
+	bytecode->write_cast(p_target, p_source, p_type);
+	if (!supported) {
+		return;
+	}
+	if (!_is_native_type(p_type)) {
+		_unsupported();
+		return;
+	}
+	_write_assign(p_target, _get_address_as(p_source, p_type.builtin_type), p_type.builtin_type);
+}
+
+void GDScriptCppCodeGenerator::write_call(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) {
+	bytecode->write_call(p_target, p_base, p_function_name, p_arguments);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_super_call(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) {
+	bytecode->write_super_call(p_target, p_function_name, p_arguments);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_call_async(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) {
+	bytecode->write_call_async(p_target, p_base, p_function_name, p_arguments);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_call_utility(const Address &p_target, const StringName &p_function, const Vector<Address> &p_arguments) {
+	bytecode->write_call_utility(p_target, p_function, p_arguments);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_call_gdscript_utility(const Address &p_target, const StringName &p_function, const Vector<Address> &p_arguments) {
+	bytecode->write_call_gdscript_utility(p_target, p_function, p_arguments);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_call_builtin_type(const Address &p_target, const Address &p_base, Variant::Type p_type, const StringName &p_method, const Vector<Address> &p_arguments) {
+	bytecode->write_call_builtin_type(p_target, p_base, p_type, p_method, p_arguments);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_call_builtin_type_static(const Address &p_target, Variant::Type p_type, const StringName &p_method, const Vector<Address> &p_arguments) {
+	bytecode->write_call_builtin_type_static(p_target, p_type, p_method, p_arguments);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_call_native_static(const Address &p_target, const StringName &p_class, const StringName &p_method, const Vector<Address> &p_arguments) {
+	bytecode->write_call_native_static(p_target, p_class, p_method, p_arguments);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_call_method_bind(const Address &p_target, const Address &p_base, MethodBind *p_method, const Vector<Address> &p_arguments) {
+	bytecode->write_call_method_bind(p_target, p_base, p_method, p_arguments);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_call_ptrcall(const Address &p_target, const Address &p_base, MethodBind *p_method, const Vector<Address> &p_arguments) {
+	bytecode->write_call_ptrcall(p_target, p_base, p_method, p_arguments);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_call_self(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) {
+	bytecode->write_call_self(p_target, p_function_name, p_arguments);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_call_self_async(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) {
+	bytecode->write_call_self_async(p_target, p_function_name, p_arguments);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_call_script_function(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) {
+	bytecode->write_call_script_function(p_target, p_base, p_function_name, p_arguments);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_lambda(const Address &p_target, GDScriptFunction *p_function, const Vector<Address> &p_captures, bool p_use_self) {
+	bytecode->write_lambda(p_target, p_function, p_captures, p_use_self);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_construct(const Address &p_target, Variant::Type p_type, const Vector<Address> &p_arguments) {
+	bytecode->write_construct(p_target, p_type, p_arguments);
+	if (!supported) {
+		return;
+	}
+	if (p_type != Variant::BOOL && p_type != Variant::INT && p_type != Variant::FLOAT) {
+		_unsupported();
+		return;
+	}
+	if (p_arguments.is_empty()) {
+		_write_assign(p_target, _get_default_literal(p_type), p_type);
+	} else if (p_arguments.size() == 1) {
+		_write_assign(p_target, _get_address_as(p_arguments[0], p_type), p_type);
+	} else {
+		_unsupported();
+	}
+}
+
+void GDScriptCppCodeGenerator::write_construct_array(const Address &p_target, const Vector<Address> &p_arguments) {
+	bytecode->write_construct_array(p_target, p_arguments);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_construct_typed_array(const Address &p_target, const GDScriptDataType &p_element_type, const Vector<Address> &p_arguments) {
+	bytecode->write_construct_typed_array(p_target, p_element_type, p_arguments);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_construct_dictionary(const Address &p_target, const Vector<Address> &p_arguments) {
+	bytecode->write_construct_dictionary(p_target, p_arguments);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_await(const Address &p_target, const Address &p_operand) {
+	bytecode->write_await(p_target, p_operand);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_if(const Address &p_condition) {
+	bytecode->write_if(p_condition);
+	if (!supported) {
+		return;
+	}
+	_write_line("if (" + _get_address_as(p_condition, Variant::BOOL) + ") {");
+	indent++;
+}
+
+void GDScriptCppCodeGenerator::write_else() {
+	bytecode->write_else();
+	if (!supported) {
+		return;
+	}
+	indent--;
+	_write_line("} else {");
+	indent++;
+}
+
+void GDScriptCppCodeGenerator::write_endif() {
+	bytecode->write_endif();
+	if (!supported) {
+		return;
+	}
+	indent--;
+	_write_line("}");
+}
+
+void GDScriptCppCodeGenerator::write_jump_if_shared(const Address &p_value) {
+	bytecode->write_jump_if_shared(p_value);
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::write_end_jump_if_shared() {
+	bytecode->write_end_jump_if_shared();
+	_unsupported();
+}
+
+void GDScriptCppCodeGenerator::start_for(const GDScriptDataType &p_iterator_type, const GDScriptDataType &p_list_type) {
+	bytecode->start_for(p_iterator_type, p_list_type);
+}
+
+void GDScriptCppCodeGenerator::write_for_assignment(const Address &p_variable, const Address &p_list) {
+	bytecode->write_for_assignment(p_variable, p_list);
+	if (!supported) {
+		return;
+	}
+
+	// Only integer ranges, which behave like a counted C loop.
+	Variant::Type list_type;
+	String list = _get_address(p_list, list_type);
+	if (!supported || list_type != Variant::INT || !_is_native_type(p_variable.type)) {
+		_unsupported();
+		return;
+	}
+
+	String counter = "f" + itos(for_count++);
+	_write_line("{");
+	indent++;
+	_write_line("const int64_t " + counter + "_size = " + list + ";");
+	for_loops.push_back(Pair<Address, String>(p_variable, counter));
+}
+
+void GDScriptCppCodeGenerator::write_for() {
+	bytecode->write_for();
+	if (!supported) {
+		return;
+	}
+	const Pair<Address, String> &loop = for_loops.back()->get();
+	_write_line(vformat("for (int64_t %s = 0; %s < %s_size; %s++) {", loop.second, loop.second, loop.second, loop.second));
+	indent++;
+	_write_assign(loop.first, loop.second, Variant::INT);
+}
+
+void GDScriptCppCodeGenerator::write_endfor() {
+	bytecode->write_endfor();
+	if (!supported) {
+		return;
+	}
+	for_loops.pop_back();
+	indent--;
+	_write_line("}");
+	indent--;
+	_write_line("}");
+}
+
+void GDScriptCppCodeGenerator::start_while_condition() {
+	bytecode->start_while_condition();
+	if (!supported) {
+		return;
+	}
+	// The condition is evaluated inside the loop so `continue` re-evaluates it.
+	_write_line("while (true) {");
+	indent++;
+}
+
+void GDScriptCppCodeGenerator::write_while(const Address &p_condition) {
+	bytecode->write_while(p_condition);
+	if (!supported) {
+		return;
+	}
+	_write_line("if (!" + _get_address_as(p_condition, Variant::BOOL) + ") {");
+	indent++;
+	_write_line("break;");
+	indent--;
+	_write_line("}");
+}
+
+void GDScriptCppCodeGenerator::write_endwhile() {
+	bytecode->write_endwhile();
+	if (!supported) {
+		return;
+	}
+	indent--;
+	_write_line("}");
+}
+
+void GDScriptCppCodeGenerator::write_break() {
+	bytecode->write_break();
+	if (!supported) {
+		return;
+	}
+	_write_line("break;");
+}
+
+void GDScriptCppCodeGenerator::write_continue() {
+	bytecode->write_continue();
+	if (!supported) {
+		return;
+	}
+	_write_line("continue;");
+}
+
+void GDScriptCppCodeGenerator::write_breakpoint() {
+	bytecode->write_breakpoint();
+}
+
+void GDScriptCppCodeGenerator::write_newline(int p_line) {
+	bytecode->write_newline(p_line);
+}
+
+void GDScriptCppCodeGenerator::write_return(const Address &p_return_value) {
+	bytecode->write_return(p_return_value);
+	if (!supported) {
+		return;
+	}
+
+	if (p_return_value.mode == Address::NIL) {
+		_write_line("return Variant();");
+		return;
+	}
+
+	Variant::Type type;
+	String value = _get_address(p_return_value, type);
+	if (!supported) {
+		return;
+	}
+	if (_is_native_type(return_type)) {
+		// Typed returns convert, like the typed return opcodes do.
+		_write_line("return Variant(" + _get_address_as(p_return_value, return_type.builtin_type) + ");");
+	} else if (!return_type.has_type) {
+		_write_line("return Variant(" + value + ");");
+	} else {
+		_unsupported();
+	}
+}
+
+void GDScriptCppCodeGenerator::write_assert(const Address &p_test, const Address &p_message) {
+	bytecode->write_assert(p_test, p_message);
+	_unsupported();
+}
+
+GDScriptCppCodeGenerator::GDScriptCppCodeGenerator(GDScriptCodeGenerator *p_bytecode, GDScriptNativeCodeUnit *p_unit, uint64_t p_source_hash) {
+	bytecode = p_bytecode;
+	unit = p_unit;
+	source_hash = p_source_hash;
+}
+
+GDScriptCppCodeGenerator::~GDScriptCppCodeGenerator() {
+	memdelete(bytecode);
+}
+
+#endif // TOOLS_ENABLED
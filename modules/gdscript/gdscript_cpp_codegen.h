@@ -0,0 +1,196 @@
+/**************************************************************************/
+/*  gdscript_cpp_codegen.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_CPP_CODEGEN_H
+#define GDSCRIPT_CPP_CODEGEN_H
+
+#ifdef TOOLS_ENABLED
+
+#include "gdscript_codegen.h"
+
+#include "core/templates/hash_map.h"
+#include "core/templates/list.h"
+#include "core/templates/pair.h"
+
+// Collects the C++ translation of GDScript functions for a whole project.
+// The result is a single translation unit that registers every function in
+// `GDScriptNativeFunctions` from `register_gdscript_native_functions()`.
+class GDScriptNativeCodeUnit {
+	String functions_code;
+	String registrations;
+	int function_count = 0;
+
+public:
+	Error add_script(const String &p_path);
+	void add_function(const String &p_class, const StringName &p_function, uint64_t p_source_hash, const String &p_body);
+
+	int get_function_count() const { return function_count; }
+	String get_source() const;
+};
+
+// Wraps the bytecode generator and, on the side, translates the function to
+// C++. Only a small statically typed subset is supported: `bool`, `int` and
+// `float` parameters, locals and temporaries, operators, assignments, casts,
+// branches and loops (`while` and `for` over an integer). Anything else, such
+// as calls, members, `self`, containers or default arguments, makes the
+// function keep running as bytecode. The bytecode is always generated too,
+// since it is what runs under the debugger or when the source changed.
+class GDScriptCppCodeGenerator : public GDScriptCodeGenerator {
+	GDScriptCodeGenerator *bytecode = nullptr;
+	GDScriptNativeCodeUnit *unit = nullptr;
+	uint64_t source_hash = 0;
+
+	String class_name;
+	StringName function_name;
+	GDScriptDataType return_type;
+	bool supported = true;
+	int parameter_count = 0;
+
+	HashMap<uint32_t, Variant> constants;
+	HashMap<String, Variant::Type> variables;
+	String parameters_code;
+	String code;
+	int indent = 1;
+	int condition_count = 0;
+	int for_count = 0;
+
+	List<String> logic_results;
+	List<Address> ternary_targets;
+	List<Pair<Address, String>> for_loops;
+
+	static bool _is_native_type(const GDScriptDataType &p_type);
+	static String _get_type_name(Variant::Type p_type);
+	static String _get_literal(const Variant &p_value);
+	static String _get_default_literal(Variant::Type p_type);
+
+	void _unsupported() { supported = false; }
+	String _get_variable(const String &p_prefix, uint32_t p_index, Variant::Type p_type);
+	String _get_address(const Address &p_address, Variant::Type &r_type);
+	String _get_address_as(const Address &p_address, Variant::Type p_type);
+	void _write_line(const String &p_line);
+	void _write_assign(const Address &p_target, const String &p_expression, Variant::Type p_type);
+
+public:
+	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
+	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
+	virtual uint32_t add_local_constant(const StringName &p_name, const Variant &p_constant) override;
+	virtual uint32_t add_or_get_constant(const Variant &p_constant) override;
+	virtual uint32_t add_or_get_name(const StringName &p_name) override;
+	virtual uint32_t add_temporary(const GDScriptDataType &p_type) override;
+	virtual void pop_temporary() override;
+
+	virtual void start_parameters() override;
+	virtual void end_parameters() override;
+
+	virtual void start_block() override;
+	virtual void end_block() override;
+
+	virtual void write_start(GDScript *p_script, const StringName &p_function_name, bool p_static, Variant p_rpc_config, const GDScriptDataType &p_return_type) override;
+	virtual GDScriptFunction *write_end() override;
+
+#ifdef DEBUG_ENABLED
+	virtual void set_signature(const String &p_signature) override;
+#endif
+	virtual void set_initial_line(int p_line) override;
+
+	virtual void write_type_adjust(const Address &p_target, Variant::Type p_new_type) override;
+	virtual void write_unary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand) override;
+	virtual void write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) override;
+	virtual void write_type_test(const Address &p_target, const Address &p_source, const GDScriptDataType &p_type) override;
+	virtual void write_and_left_operand(const Address &p_left_operand) override;
+	virtual void write_and_right_operand(const Address &p_right_operand) override;
+	virtual void write_end_and(const Address &p_target) override;
+	virtual void write_or_left_operand(const Address &p_left_operand) override;
+	virtual void write_or_right_operand(const Address &p_right_operand) override;
+	virtual void write_end_or(const Address &p_target) override;
+	virtual void write_start_ternary(const Address &p_target) override;
+	virtual void write_ternary_condition(const Address &p_condition) override;
+	virtual void write_ternary_true_expr(const Address &p_expr) override;
+	virtual void write_ternary_false_expr(const Address &p_expr) override;
+	virtual void write_end_ternary() override;
+	virtual void write_set(const Address &p_target, const Address &p_index, const Address &p_source) override;
+	virtual void write_get(const Address &p_target, const Address &p_index, const Address &p_source) override;
+	virtual void write_set_named(const Address &p_target, const StringName &p_name, const Address &p_source) override;
+	virtual void write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) override;
+	virtual void write_set_member(const Address &p_value, const StringName &p_name) override;
+	virtual void write_get_member(const Address &p_target, const StringName &p_name) override;
+	virtual void write_assign(const Address &p_target, const Address &p_source) override;
+	virtual void write_assign_with_conversion(const Address &p_target, const Address &p_source) override;
+	virtual void write_assign_true(const Address &p_target) override;
+	virtual void write_assign_false(const Address &p_target) override;
+	virtual void write_assign_default_parameter(const Address &dst, const Address &src, bool p_use_conversion) override;
+	virtual void write_store_global(const Address &p_dst, int p_global_index) override;
+	virtual void write_store_named_global(const Address &p_dst, const StringName &p_global) override;
+	virtual void write_cast(const Address &p_target, const Address &p_source, const GDScriptDataType &p_type) override;
+	virtual void write_call(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) override;
+	virtual void write_super_call(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) override;
+	virtual void write_call_async(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) override;
+	virtual void write_call_utility(const Address &p_target, const StringName &p_function, const Vector<Address> &p_arguments) override;
+	virtual void write_call_gdscript_utility(const Address &p_target, const StringName &p_function, const Vector<Address> &p_arguments) override;
+	virtual void write_call_builtin_type(const Address &p_target, const Address &p_base, Variant::Type p_type, const StringName &p_method, const Vector<Address> &p_arguments) override;
+	virtual void write_call_builtin_type_static(const Address &p_target, Variant::Type p_type, const StringName &p_method, const Vector<Address> &p_arguments) override;
+	virtual void write_call_native_static(const Address &p_target, const StringName &p_class, const StringName &p_method, const Vector<Address> &p_arguments) override;
+	virtual void write_call_method_bind(const Address &p_target, const Address &p_base, MethodBind *p_method, const Vector<Address> &p_arguments) override;
+	virtual void write_call_ptrcall(const Address &p_target, const Address &p_base, MethodBind *p_method, const Vector<Address> &p_arguments) override;
+	virtual void write_call_self(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) override;
+	virtual void write_call_self_async(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) override;
+	virtual void write_call_script_function(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) override;
+	virtual void write_lambda(const Address &p_target, GDScriptFunction *p_function, const Vector<Address> &p_captures, bool p_use_self) override;
+	virtual void write_construct(const Address &p_target, Variant::Type p_type, const Vector<Address> &p_arguments) override;
+	virtual void write_construct_array(const Address &p_target, const Vector<Address> &p_arguments) override;
+	virtual void write_construct_typed_array(const Address &p_target, const GDScriptDataType &p_element_type, const Vector<Address> &p_arguments) override;
+	virtual void write_construct_dictionary(const Address &p_target, const Vector<Address> &p_arguments) override;
+	virtual void write_await(const Address &p_target, const Address &p_operand) override;
+	virtual void write_if(const Address &p_condition) override;
+	virtual void write_else() override;
+	virtual void write_endif() override;
+	virtual void write_jump_if_shared(const Address &p_value) override;
+	virtual void write_end_jump_if_shared() override;
+	virtual void start_for(const GDScriptDataType &p_iterator_type, const GDScriptDataType &p_list_type) override;
+	virtual void write_for_assignment(const Address &p_variable, const Address &p_list) override;
+	virtual void write_for() override;
+	virtual void write_endfor() override;
+	virtual void start_while_condition() override;
+	virtual void write_while(const Address &p_condition) override;
+	virtual void write_endwhile() override;
+	virtual void write_break() override;
+	virtual void write_continue() override;
+	virtual void write_breakpoint() override;
+	virtual void write_newline(int p_line) override;
+	virtual void write_return(const Address &p_return_value) override;
+	virtual void write_assert(const Address &p_test, const Address &p_message) override;
+
+	GDScriptCppCodeGenerator(GDScriptCodeGenerator *p_bytecode, GDScriptNativeCodeUnit *p_unit, uint64_t p_source_hash);
+	~GDScriptCppCodeGenerator();
+};
+
+#endif // TOOLS_ENABLED
+
+#endif // GDSCRIPT_CPP_CODEGEN_H
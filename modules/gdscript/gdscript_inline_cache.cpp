@@ -0,0 +1,417 @@
+/**************************************************************************/
+/*  gdscript_inline_cache.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_inline_cache.h"
+
+#include "gdscript.h"
+#include "gdscript_function.h"
+
+#include "core/config/engine.h"
+#include "core/core_string_names.h"
+#include "core/object/class_db.h"
+#include "core/variant/variant_internal.h"
+
+SafeNumeric<uint32_t> GDScriptInlineCache::epoch(1);
+
+GDScriptFunction *GDScriptInlineCache::_find_script_function(const GDScript *p_script, const StringName &p_name) {
+	while (p_script) {
+		GDScriptFunction *const *function = p_script->member_functions.getptr(p_name);
+		if (function) {
+			return *function;
+		}
+		p_script = p_script->_base;
+	}
+	return nullptr;
+}
+
+bool GDScriptInlineCache::_script_has_name(const GDScript *p_script, const StringName &p_name) {
+	while (p_script) {
+		if (p_script->constants.has(p_name) || p_script->_signals.has(p_name) || p_script->member_functions.has(p_name)) {
+			return true;
+		}
+		p_script = p_script->_base;
+	}
+	return false;
+}
+
+bool GDScriptInlineCache::_make_key(const Variant *p_base, Key &r_key) const {
+	r_key.type = p_base->get_type();
+	if (r_key.type != Variant::OBJECT) {
+		return true;
+	}
+
+#ifdef DEBUG_ENABLED
+	r_key.object = p_base->get_validated_object();
+#else
+	r_key.object = p_base->operator Object *();
+#endif
+	if (!r_key.object) {
+		return false; // Let the generic path report it.
+	}
+	r_key.native_class = &r_key.object->get_class_name();
+
+	ScriptInstance *script_instance = r_key.object->get_script_instance();
+	if (script_instance) {
+		if (script_instance->get_language() != GDScriptLanguage::get_singleton() || script_instance->is_placeholder()) {
+			return false;
+		}
+		r_key.instance = static_cast<GDScriptInstance *>(script_instance);
+		r_key.script = r_key.instance->script->get_instance_id();
+	}
+	return true;
+}
+
+const GDScriptInlineCache::Entry *GDScriptInlineCache::_find(const Key &p_key, uint32_t p_epoch) const {
+	for (int i = 0; i < MAX_ENTRIES; i++) {
+		const Entry *entry = entries[i].load(std::memory_order_acquire);
+		if (!entry) {
+			break; // Slots are filled in order.
+		}
+		if (entry->epoch != p_epoch || entry->base_type != p_key.type) {
+			continue;
+		}
+		if (p_key.type != Variant::OBJECT || (entry->native_class == *p_key.native_class && entry->script == p_key.script)) {
+			return entry;
+		}
+	}
+	return nullptr;
+}
+
+const GDScriptInlineCache::Entry *GDScriptInlineCache::_insert(Entry *p_entry, uint32_t p_epoch) {
+	for (int i = 0; i < MAX_ENTRIES; i++) {
+		Entry *current = entries[i].load(std::memory_order_acquire);
+		while (!current || current->epoch != p_epoch) {
+			if (entries[i].compare_exchange_weak(current, p_entry, std::memory_order_acq_rel, std::memory_order_acquire)) {
+				if (current) {
+					// Another thread might still be reading it, keep it until the cache is destroyed.
+					Entry *head = retired.load(std::memory_order_relaxed);
+					do {
+						current->next_retired = head;
+					} while (!retired.compare_exchange_weak(head, current, std::memory_order_release, std::memory_order_relaxed));
+				}
+				return p_entry;
+			}
+		}
+	}
+
+	// Too many receiver types, stop caching until the scripts change.
+	megamorphic_epoch.set(p_epoch);
+	memdelete(p_entry);
+	return nullptr;
+}
+
+GDScriptInlineCache::Entry *GDScriptInlineCache::_resolve(const Key &p_key, const StringName &p_name, Operation p_operation) const {
+	Entry *entry = memnew(Entry);
+	entry->base_type = p_key.type;
+
+	if (p_key.type != Variant::OBJECT) {
+		switch (p_operation) {
+			case OP_GET: {
+				entry->getter = Variant::get_member_validated_getter(p_key.type, p_name);
+				if (entry->getter) {
+					entry->kind = KIND_BUILTIN_MEMBER;
+					entry->value_type = Variant::get_member_type(p_key.type, p_name);
+				}
+			} break;
+			case OP_SET: {
+				entry->setter = Variant::get_member_validated_setter(p_key.type, p_name);
+				if (entry->setter) {
+					entry->kind = KIND_BUILTIN_MEMBER;
+					entry->value_type = Variant::get_member_type(p_key.type, p_name);
+				}
+			} break;
+			case OP_CALL: {
+				if (!Variant::has_builtin_method(p_key.type, p_name) || Variant::is_builtin_method_static(p_key.type, p_name) || Variant::is_builtin_method_vararg(p_key.type, p_name)) {
+					break;
+				}
+				entry->kind = KIND_BUILTIN_METHOD;
+				entry->builtin_method = Variant::get_validated_builtin_method(p_key.type, p_name);
+				int argument_count = Variant::get_builtin_method_argument_count(p_key.type, p_name);
+				entry->argument_types.resize(argument_count);
+				for (int i = 0; i < argument_count; i++) {
+					entry->argument_types[i] = Variant::get_builtin_method_argument_type(p_key.type, p_name, i);
+				}
+				if (Variant::has_builtin_method_return_value(p_key.type, p_name)) {
+					entry->value_type = Variant::get_builtin_method_return_type(p_key.type, p_name);
+				}
+			} break;
+		}
+		return entry;
+	}
+
+	entry->native_class = *p_key.native_class;
+	entry->script = p_key.script;
+
+	const GDScript *script = p_key.instance ? p_key.instance->script.ptr() : nullptr;
+	const ClassDB::ClassInfo *class_info = ClassDB::classes.getptr(*p_key.native_class);
+	const ObjectGDExtension *extension = class_info ? class_info->gdextension : nullptr;
+
+	// Mirrors the lookup order of Object::get/set/callp and GDScriptInstance, anything
+	// that could be handled before the native class is left to the generic path.
+	switch (p_operation) {
+		case OP_GET: {
+			if (script) {
+				const GDScript::MemberInfo *member = script->member_indices.getptr(p_name);
+				if (member) {
+					if (!member->getter) {
+						entry->kind = KIND_SCRIPT_MEMBER;
+						entry->member_index = member->index;
+					}
+					break;
+				}
+				if (_script_has_name(script, p_name) || _find_script_function(script, GDScriptLanguage::get_singleton()->strings._get)) {
+					break;
+				}
+			}
+			if (extension && extension->get) {
+				break;
+			}
+			const ClassDB::ClassInfo *check = class_info;
+			while (check) {
+				const ClassDB::PropertySetGet *psg = check->property_setget.getptr(p_name);
+				if (psg) {
+					if (psg->index < 0 && psg->_getptr) {
+						entry->kind = KIND_METHOD_BIND;
+						entry->method = psg->_getptr;
+					}
+					break;
+				}
+				if (check->constant_map.has(p_name) || check->method_map.has(p_name) || check->signal_map.has(p_name)) {
+					break;
+				}
+				check = check->inherits_ptr;
+			}
+		} break;
+		case OP_SET: {
+			if (script) {
+				const GDScript::MemberInfo *member = script->member_indices.getptr(p_name);
+				if (member) {
+					if (!member->setter) {
+						entry->kind = KIND_SCRIPT_MEMBER;
+						entry->member_index = member->index;
+						entry->member_type = &member->data_type;
+					}
+					break;
+				}
+				if (_find_script_function(script, GDScriptLanguage::get_singleton()->strings._set)) {
+					break;
+				}
+			}
+			if (extension && extension->set) {
+				break;
+			}
+#ifdef TOOLS_ENABLED
+			if (Engine::get_singleton()->is_editor_hint()) {
+				break; // Object::set also flags the object as edited.
+			}
+#endif
+			const ClassDB::ClassInfo *check = class_info;
+			while (check) {
+				const ClassDB::PropertySetGet *psg = check->property_setget.getptr(p_name);
+				if (psg) {
+					if (psg->index < 0 && psg->_setptr) {
+						entry->kind = KIND_METHOD_BIND;
+						entry->method = psg->_setptr;
+					}
+					break;
+				}
+				check = check->inherits_ptr;
+			}
+		} break;
+		case OP_CALL: {
+			if (p_name == CoreStringNames::get_singleton()->_free) {
+				break;
+			}
+			if (Object::cast_to<Script>(p_key.object) || Object::cast_to<GDScriptNativeClass>(p_key.object)) {
+				break; // Override callp to reach their static functions.
+			}
+			if (script) {
+				GDScriptFunction *function = _find_script_function(script, p_name);
+				if (function) {
+					if (p_name != SNAME("_ready")) { // Also runs the implicit ready functions.
+						entry->kind = KIND_SCRIPT_FUNCTION;
+						entry->function = function;
+					}
+					break;
+				}
+			}
+			entry->method = ClassDB::get_method(*p_key.native_class, p_name);
+			if (entry->method) {
+				entry->kind = KIND_METHOD_BIND;
+			}
+		} break;
+	}
+	return entry;
+}
+
+const GDScriptInlineCache::Entry *GDScriptInlineCache::_lookup(const Variant *p_base, const StringName &p_name, Operation p_operation, Key &r_key) {
+	uint32_t current_epoch = epoch.get();
+	if (megamorphic_epoch.get() == current_epoch) {
+		return nullptr;
+	}
+	if (!_make_key(p_base, r_key)) {
+		return nullptr;
+	}
+	const Entry *entry = _find(r_key, current_epoch);
+	if (!entry) {
+		Entry *resolved = _resolve(r_key, p_name, p_operation);
+		resolved->epoch = current_epoch;
+		entry = _insert(resolved, current_epoch);
+	}
+	return entry;
+}
+
+bool GDScriptInlineCache::get_named(const Variant *p_base, const StringName &p_name, Variant *r_ret) {
+	Key key;
+	const Entry *entry = _lookup(p_base, p_name, OP_GET, key);
+	if (!entry) {
+		return false;
+	}
+
+	switch (entry->kind) {
+		case KIND_SCRIPT_MEMBER: {
+			*r_ret = key.instance->members[entry->member_index];
+		} break;
+		case KIND_METHOD_BIND: {
+			Callable::CallError ce;
+			*r_ret = entry->method->call(key.object, nullptr, 0, ce);
+		} break;
+		case KIND_BUILTIN_MEMBER: {
+			// The base and the result may share the same stack slot.
+			Variant ret;
+			VariantInternal::initialize(&ret, entry->value_type);
+			entry->getter(p_base, &ret);
+			*r_ret = ret;
+		} break;
+		default: {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptInlineCache::set_named(Variant *p_base, const StringName &p_name, const Variant *p_value, bool &r_valid) {
+	Key key;
+	const Entry *entry = _lookup(p_base, p_name, OP_SET, key);
+	if (!entry) {
+		return false;
+	}
+
+	switch (entry->kind) {
+		case KIND_SCRIPT_MEMBER: {
+			if (entry->member_type->has_type && !entry->member_type->is_type(*p_value)) {
+				return false; // Needs a conversion.
+			}
+			key.instance->members.write[entry->member_index] = *p_value;
+			r_valid = true;
+		} break;
+		case KIND_METHOD_BIND: {
+			Callable::CallError ce;
+			entry->method->call(key.object, &p_value, 1, ce);
+			r_valid = ce.error == Callable::CallError::CALL_OK;
+		} break;
+		case KIND_BUILTIN_MEMBER: {
+			if (p_value->get_type() != entry->value_type) {
+				return false; // Needs a conversion.
+			}
+			entry->setter(p_base, p_value);
+			r_valid = true;
+		} break;
+		default: {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptInlineCache::call(Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
+	Key key;
+	const Entry *entry = _lookup(p_base, p_method, OP_CALL, key);
+	if (!entry) {
+		return false;
+	}
+
+	r_error.error = Callable::CallError::CALL_OK;
+	switch (entry->kind) {
+		case KIND_SCRIPT_FUNCTION: {
+#ifdef DEBUG_ENABLED
+			// Same as Object::callp(), which this skips.
+			_ObjectDebugLock debug_lock(key.object);
+#endif
+			r_ret = entry->function->call(key.instance, p_args, p_argcount, r_error);
+		} break;
+		case KIND_METHOD_BIND: {
+#ifdef DEBUG_ENABLED
+			_ObjectDebugLock debug_lock(key.object);
+#endif
+			r_ret = entry->method->call(key.object, p_args, p_argcount, r_error);
+		} break;
+		case KIND_BUILTIN_METHOD: {
+			if (p_argcount != (int)entry->argument_types.size()) {
+				return false; // Default arguments or errors are handled by the generic path.
+			}
+			for (int i = 0; i < p_argcount; i++) {
+				if (entry->argument_types[i] != Variant::NIL && p_args[i]->get_type() != entry->argument_types[i]) {
+					return false;
+				}
+			}
+			Variant ret;
+			VariantInternal::initialize(&ret, entry->value_type);
+			entry->builtin_method(p_base, p_args, p_argcount, &ret);
+			r_ret = ret;
+		} break;
+		default: {
+			return false;
+		}
+	}
+	return true;
+}
+
+GDScriptInlineCache::GDScriptInlineCache() {
+	for (int i = 0; i < MAX_ENTRIES; i++) {
+		entries[i].store(nullptr, std::memory_order_relaxed);
+	}
+	retired.store(nullptr, std::memory_order_relaxed);
+}
+
+GDScriptInlineCache::~GDScriptInlineCache() {
+	for (int i = 0; i < MAX_ENTRIES; i++) {
+		Entry *entry = entries[i].load(std::memory_order_relaxed);
+		if (entry) {
+			memdelete(entry);
+		}
+	}
+	Entry *entry = retired.load(std::memory_order_relaxed);
+	while (entry) {
+		Entry *next = entry->next_retired;
+		memdelete(entry);
+		entry = next;
+	}
+}
@@ -0,0 +1,129 @@
+/**************************************************************************/
+/*  gdscript_inline_cache.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_INLINE_CACHE_H
+#define GDSCRIPT_INLINE_CACHE_H
+
+#include "core/object/object.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/variant/variant.h"
+
+#include <atomic>
+
+class GDScript;
+class GDScriptDataType;
+class GDScriptFunction;
+class GDScriptInstance;
+
+// Per-instruction cache used by the untyped named access and call opcodes.
+// Remembers how the name was resolved for the last few receiver types
+// (built-in type, or native class plus GDScript), so repeated executions
+// can skip the Object/ClassDB/script lookups. Entries are immutable once
+// published, so the VM can read them from any thread without locking.
+class GDScriptInlineCache {
+public:
+	enum {
+		MAX_ENTRIES = 4,
+	};
+
+	enum Kind {
+		KIND_NONE, // Resolved, but must go through the generic path.
+		KIND_SCRIPT_MEMBER,
+		KIND_SCRIPT_FUNCTION,
+		KIND_METHOD_BIND,
+		KIND_BUILTIN_MEMBER,
+		KIND_BUILTIN_METHOD,
+	};
+
+	struct Entry {
+		uint32_t epoch = 0;
+		Variant::Type base_type = Variant::NIL;
+		StringName native_class;
+		ObjectID script;
+
+		Kind kind = KIND_NONE;
+		int member_index = -1;
+		const GDScriptDataType *member_type = nullptr;
+		GDScriptFunction *function = nullptr;
+		MethodBind *method = nullptr;
+		Variant::ValidatedGetter getter = nullptr;
+		Variant::ValidatedSetter setter = nullptr;
+		Variant::ValidatedBuiltInMethod builtin_method = nullptr;
+		Variant::Type value_type = Variant::NIL; // Member type, or return type of built-in methods.
+		LocalVector<Variant::Type> argument_types;
+
+		Entry *next_retired = nullptr;
+	};
+
+private:
+	struct Key {
+		Variant::Type type = Variant::NIL;
+		Object *object = nullptr;
+		GDScriptInstance *instance = nullptr;
+		const StringName *native_class = nullptr;
+		ObjectID script;
+	};
+
+	enum Operation {
+		OP_GET,
+		OP_SET,
+		OP_CALL,
+	};
+
+	static SafeNumeric<uint32_t> epoch;
+
+	std::atomic<Entry *> entries[MAX_ENTRIES];
+	std::atomic<Entry *> retired;
+	SafeNumeric<uint32_t> megamorphic_epoch;
+
+	static GDScriptFunction *_find_script_function(const GDScript *p_script, const StringName &p_name);
+	static bool _script_has_name(const GDScript *p_script, const StringName &p_name);
+
+	bool _make_key(const Variant *p_base, Key &r_key) const;
+	const Entry *_find(const Key &p_key, uint32_t p_epoch) const;
+	const Entry *_insert(Entry *p_entry, uint32_t p_epoch);
+	Entry *_resolve(const Key &p_key, const StringName &p_name, Operation p_operation) const;
+	_FORCE_INLINE_ const Entry *_lookup(const Variant *p_base, const StringName &p_name, Operation p_operation, Key &r_key);
+
+public:
+	// Each returns false when the access must go through the generic Variant path.
+	bool get_named(const Variant *p_base, const StringName &p_name, Variant *r_ret);
+	bool set_named(Variant *p_base, const StringName &p_name, const Variant *p_value, bool &r_valid);
+	bool call(Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error);
+
+	// Must be called whenever the members or functions of a script that could already be cached are rebuilt.
+	static void invalidate_all() { epoch.increment(); }
+
+	GDScriptInlineCache();
+	~GDScriptInlineCache();
+};
+
+#endif // GDSCRIPT_INLINE_CACHE_H
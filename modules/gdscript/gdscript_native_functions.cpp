@@ -0,0 +1,58 @@
+/**************************************************************************/
+/*  gdscript_native_functions.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_native_functions.h"
+
+HashMap<String, GDScriptNativeFunctions::Function> GDScriptNativeFunctions::functions;
+
+void GDScriptNativeFunctions::register_function(const String &p_class, const StringName &p_function, uint64_t p_source_hash, GDScriptNativeFunctionPtr p_ptr) {
+	ERR_FAIL_NULL(p_ptr);
+
+	Function function;
+	function.source_hash = p_source_hash;
+	function.function = p_ptr;
+	functions[p_class + "::" + String(p_function)] = function;
+}
+
+GDScriptNativeFunctionPtr GDScriptNativeFunctions::get_function(const String &p_class, const StringName &p_function, uint64_t p_source_hash) {
+	HashMap<String, Function>::ConstIterator E = functions.find(p_class + "::" + String(p_function));
+	if (!E || E->value.source_hash != p_source_hash) {
+		return nullptr;
+	}
+	return E->value.function;
+}
+
+void GDScriptNativeFunctions::unregister_function(const String &p_class, const StringName &p_function) {
+	functions.erase(p_class + "::" + String(p_function));
+}
+
+void GDScriptNativeFunctions::clear() {
+	functions.clear();
+}
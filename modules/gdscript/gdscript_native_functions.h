@@ -0,0 +1,65 @@
+/**************************************************************************/
+/*  gdscript_native_functions.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_NATIVE_FUNCTIONS_H
+#define GDSCRIPT_NATIVE_FUNCTIONS_H
+
+#include "core/string/string_name.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/variant/callable.h"
+#include "core/variant/variant.h"
+
+class GDScriptInstance;
+
+typedef Variant (*GDScriptNativeFunctionPtr)(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+
+// Registry of GDScript functions that were translated to C++ at export time
+// and compiled into the engine (see `GDScriptCppCodeGenerator`). Functions are
+// keyed by the fully qualified name of their class and only handed out if the
+// hash of the script source matches the one they were generated from, so a
+// script changed after the build keeps running as bytecode.
+class GDScriptNativeFunctions {
+	struct Function {
+		uint64_t source_hash = 0;
+		GDScriptNativeFunctionPtr function = nullptr;
+	};
+
+	static HashMap<String, Function> functions;
+
+public:
+	static void register_function(const String &p_class, const StringName &p_function, uint64_t p_source_hash, GDScriptNativeFunctionPtr p_ptr);
+	static GDScriptNativeFunctionPtr get_function(const String &p_class, const StringName &p_function, uint64_t p_source_hash);
+	static void unregister_function(const String &p_class, const StringName &p_function);
+	static bool has_functions() { return !functions.is_empty(); }
+	static void clear();
+};
+
+#endif // GDSCRIPT_NATIVE_FUNCTIONS_H
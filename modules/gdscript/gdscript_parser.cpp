@@ -35,6 +35,7 @@
 #include "core/io/resource_loader.h"
 #include "core/math/math_defs.h"
 #include "gdscript.h"
+#include "gdscript_tokenizer_buffer.h"
 #include "scene/main/multiplayer_api.h"
 
 #ifdef DEBUG_ENABLED
@@ -304,6 +305,27 @@ Error GDScriptParser::parse(const String &p_source_code, const String &p_script_
 	tokenizer.set_source_code(source);
 	tokenizer.set_cursor_position(cursor_line, cursor_column);
 	script_path = p_script_path;
+
+	return parse_tokens();
+}
+
+Error GDScriptParser::parse_binary(const Vector<uint8_t> &p_binary, const String &p_script_path) {
+	clear();
+
+	Vector<GDScriptTokenizer::Token> tokens;
+	Error err = GDScriptTokenizerBuffer::deserialize(p_binary, tokens);
+	if (err != OK) {
+		push_error(vformat(R"(Invalid binary tokens for script "%s".)", p_script_path));
+		return err;
+	}
+
+	tokenizer.set_token_buffer(tokens);
+	script_path = p_script_path;
+
+	return parse_tokens();
+}
+
+Error GDScriptParser::parse_tokens() {
 	current = tokenizer.scan();
 	// Avoid error or newline as the first token.
 	// The latter can mess with the parser when opening files filled exclusively with comments and newlines.
@@ -1376,6 +1376,7 @@ private:
 		return node;
 	}
 	void clear();
+	Error parse_tokens();
 	void push_error(const String &p_message, const Node *p_origin = nullptr);
 #ifdef DEBUG_ENABLED
 	void push_warning(const Node *p_source, GDScriptWarning::Code p_code, const Vector<String> &p_symbols);
@@ -1487,6 +1488,11 @@ private:
 
 public:
 	Error parse(const String &p_source_code, const String &p_script_path, bool p_for_completion);
+	Error parse_binary(const Vector<uint8_t> &p_binary, const String &p_script_path);
+#ifdef TOOLS_ENABLED
+	void set_record_tokens(bool p_enabled) { tokenizer.set_record_tokens(p_enabled); }
+	const Vector<GDScriptTokenizer::Token> &get_recorded_tokens() const { return tokenizer.get_recorded_tokens(); }
+#endif // TOOLS_ENABLED
 	ClassNode *get_tree() const { return head; }
 	bool is_tool() const { return _is_tool; }
 	ClassNode *find_class(const String &p_qualified_name) const;
@@ -248,6 +248,18 @@ void GDScriptTokenizer::set_source_code(const String &p_source_code) {
 	position = 0;
 }
 
+void GDScriptTokenizer::set_token_buffer(const Vector<Token> &p_tokens) {
+	token_buffer = p_tokens;
+	token_buffer_position = 0;
+}
+
+#ifdef TOOLS_ENABLED
+void GDScriptTokenizer::set_record_tokens(bool p_enabled) {
+	record_tokens = p_enabled;
+	recorded_tokens.clear();
+}
+#endif // TOOLS_ENABLED
+
 void GDScriptTokenizer::set_cursor_position(int p_line, int p_column) {
 	cursor_line = p_line;
 	cursor_column = p_column;
@@ -258,10 +270,16 @@ void GDScriptTokenizer::set_multiline_mode(bool p_state) {
 }
 
 void GDScriptTokenizer::push_expression_indented_block() {
+	if (token_buffer_position >= 0) {
+		return; // Indentation was already resolved when the tokens were recorded.
+	}
 	indent_stack_stack.push_back(indent_stack);
 }
 
 void GDScriptTokenizer::pop_expression_indented_block() {
+	if (token_buffer_position >= 0) {
+		return;
+	}
 	ERR_FAIL_COND(indent_stack_stack.size() == 0);
 	indent_stack = indent_stack_stack.back()->get();
 	indent_stack_stack.pop_back();
@@ -1282,6 +1300,24 @@ void GDScriptTokenizer::_skip_whitespace() {
 }
 
 GDScriptTokenizer::Token GDScriptTokenizer::scan() {
+	if (token_buffer_position >= 0) {
+		// The multiline mode and indentation were applied when recording, so the parser gets the same stream back.
+		if (token_buffer_position < token_buffer.size()) {
+			return token_buffer[token_buffer_position++];
+		}
+		return token_buffer.is_empty() ? Token(Token::TK_EOF) : token_buffer[token_buffer.size() - 1];
+	}
+
+	Token token = scan_source();
+#ifdef TOOLS_ENABLED
+	if (record_tokens) {
+		recorded_tokens.push_back(token);
+	}
+#endif // TOOLS_ENABLED
+	return token;
+}
+
+GDScriptTokenizer::Token GDScriptTokenizer::scan_source() {
 	if (has_error()) {
 		return pop_error();
 	}
@@ -1346,7 +1382,7 @@ GDScriptTokenizer::Token GDScriptTokenizer::scan() {
 		_advance();
 		newline(false);
 		line_continuation = true;
-		return scan(); // Recurse to get next token.
+		return scan_source(); // Recurse to get next token.
 	}
 
 	line_continuation = false;
@@ -232,6 +232,14 @@ private:
 	HashMap<int, CommentData> comments;
 #endif // TOOLS_ENABLED
 
+	// Pre-scanned tokens, replayed instead of scanning the source (see GDScriptTokenizerBuffer).
+	Vector<Token> token_buffer;
+	int token_buffer_position = -1;
+#ifdef TOOLS_ENABLED
+	bool record_tokens = false;
+	Vector<Token> recorded_tokens;
+#endif // TOOLS_ENABLED
+
 	_FORCE_INLINE_ bool _is_at_end() { return position >= length; }
 	_FORCE_INLINE_ char32_t _peek(int p_offset = 0) { return position + p_offset >= 0 && position + p_offset < length ? _current[p_offset] : '\0'; }
 	int indent_level() const { return indent_stack.size(); }
@@ -262,11 +270,17 @@ private:
 	Token potential_identifier();
 	Token string();
 	Token annotation();
+	Token scan_source();
 
 public:
 	Token scan();
 
 	void set_source_code(const String &p_source_code);
+	void set_token_buffer(const Vector<Token> &p_tokens);
+#ifdef TOOLS_ENABLED
+	void set_record_tokens(bool p_enabled);
+	const Vector<Token> &get_recorded_tokens() const { return recorded_tokens; }
+#endif // TOOLS_ENABLED
 
 	int get_cursor_line() const;
 	int get_cursor_column() const;
@@ -0,0 +1,170 @@
+/**************************************************************************/
+/*  gdscript_tokenizer_buffer.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_tokenizer_buffer.h"
+
+#include "core/io/compression.h"
+#include "core/io/marshalls.h"
+#include "core/io/stream_peer.h"
+
+static const char *TOKEN_BUFFER_MAGIC = "GDSC";
+
+Vector<uint8_t> GDScriptTokenizerBuffer::serialize(const Vector<GDScriptTokenizer::Token> &p_tokens, uint64_t p_source_hash) {
+	// Token sources repeat a lot (identifiers, keywords, punctuation), so they are stored once in a table.
+	HashMap<String, uint32_t> string_map;
+	Vector<String> strings;
+
+	Ref<StreamPeerBuffer> token_data;
+	token_data.instantiate();
+	for (const GDScriptTokenizer::Token &token : p_tokens) {
+		const uint32_t *string_index = string_map.getptr(token.source);
+		if (!string_index) {
+			string_index = &string_map.insert(token.source, strings.size())->value;
+			strings.push_back(token.source);
+		}
+
+		token_data->put_u8(token.type);
+		token_data->put_u32(*string_index);
+		if (token.type == GDScriptTokenizer::Token::LITERAL) {
+			token_data->put_var(token.literal);
+		}
+		token_data->put_u32(token.start_line);
+		token_data->put_u32(token.end_line);
+		token_data->put_u32(token.start_column);
+		token_data->put_u32(token.end_column);
+		token_data->put_u32(token.leftmost_column);
+		token_data->put_u32(token.rightmost_column);
+	}
+
+	Ref<StreamPeerBuffer> payload;
+	payload.instantiate();
+	payload->put_u32(strings.size());
+	for (const String &string : strings) {
+		payload->put_utf8_string(string);
+	}
+	payload->put_u32(p_tokens.size());
+	const Vector<uint8_t> token_bytes = token_data->get_data_array();
+	payload->put_data(token_bytes.ptr(), token_bytes.size());
+	const Vector<uint8_t> data = payload->get_data_array();
+
+	Vector<uint8_t> buffer;
+	buffer.resize(HEADER_SIZE + Compression::get_max_compressed_buffer_size(data.size()));
+	uint8_t *w = buffer.ptrw();
+	memcpy(w, TOKEN_BUFFER_MAGIC, 4);
+	encode_uint32(TOKEN_BUFFER_VERSION, w + 4);
+	encode_uint64(p_source_hash, w + 8);
+	encode_uint32(data.size(), w + 16);
+	int compressed_size = Compression::compress(w + HEADER_SIZE, data.ptr(), data.size());
+	ERR_FAIL_COND_V(compressed_size < 0, Vector<uint8_t>());
+	buffer.resize(HEADER_SIZE + compressed_size);
+
+	return buffer;
+}
+
+Error GDScriptTokenizerBuffer::deserialize(const Vector<uint8_t> &p_buffer, Vector<GDScriptTokenizer::Token> &r_tokens) {
+	ERR_FAIL_COND_V_MSG(!is_valid_buffer(p_buffer), ERR_INVALID_DATA, "Invalid or incompatible binary GDScript tokens.");
+
+	// A zstd block of at most 128 KiB takes at least 4 bytes, which bounds the size it can decompress to.
+	const uint8_t *r = p_buffer.ptr();
+	const uint64_t compressed_size = p_buffer.size() - HEADER_SIZE;
+	const uint32_t data_size = decode_uint32(r + 16);
+	ERR_FAIL_COND_V(data_size > INT32_MAX || data_size > compressed_size * 32768, ERR_FILE_CORRUPT);
+
+	Vector<uint8_t> data;
+	data.resize(data_size);
+	int decompressed_size = Compression::decompress(data.ptrw(), data.size(), r + HEADER_SIZE, compressed_size);
+	ERR_FAIL_COND_V(decompressed_size != data.size(), ERR_FILE_CORRUPT);
+
+	Ref<StreamPeerBuffer> payload;
+	payload.instantiate();
+	payload->set_data_array(data);
+
+	// Counts are checked against the smallest size their entries can take, so corrupt ones can't make huge allocations.
+	ERR_FAIL_COND_V(payload->get_available_bytes() < 4, ERR_FILE_CORRUPT);
+	uint32_t string_count = payload->get_u32();
+	ERR_FAIL_COND_V(string_count > uint32_t(payload->get_available_bytes()) / 4, ERR_FILE_CORRUPT);
+	Vector<String> strings;
+	strings.resize(string_count);
+	for (uint32_t i = 0; i < string_count; i++) {
+		ERR_FAIL_COND_V(payload->get_available_bytes() < 4, ERR_FILE_CORRUPT);
+		uint32_t length = payload->get_u32();
+		ERR_FAIL_COND_V(length > uint32_t(payload->get_available_bytes()), ERR_FILE_CORRUPT);
+		strings.write[i] = payload->get_utf8_string(length);
+	}
+
+	// Type, source and the six line and column numbers.
+	const int token_min_size = 1 + 4 + 6 * 4;
+	ERR_FAIL_COND_V(payload->get_available_bytes() < 4, ERR_FILE_CORRUPT);
+	uint32_t token_count = payload->get_u32();
+	ERR_FAIL_COND_V(token_count == 0 || token_count > uint32_t(payload->get_available_bytes()) / token_min_size, ERR_FILE_CORRUPT);
+	r_tokens.resize(token_count);
+	GDScriptTokenizer::Token *w = r_tokens.ptrw();
+	for (uint32_t i = 0; i < token_count; i++) {
+		ERR_FAIL_COND_V(payload->get_available_bytes() < token_min_size, ERR_FILE_CORRUPT);
+		uint8_t type = payload->get_u8();
+		ERR_FAIL_COND_V(type >= GDScriptTokenizer::Token::TK_MAX, ERR_FILE_CORRUPT);
+		uint32_t string_index = payload->get_u32();
+		ERR_FAIL_UNSIGNED_INDEX_V(string_index, string_count, ERR_FILE_CORRUPT);
+
+		GDScriptTokenizer::Token &token = w[i];
+		token.type = GDScriptTokenizer::Token::Type(type);
+		token.source = strings[string_index];
+		if (token.type == GDScriptTokenizer::Token::LITERAL) {
+			uint32_t literal_size = payload->get_u32();
+			ERR_FAIL_COND_V(literal_size > uint32_t(payload->get_available_bytes()), ERR_FILE_CORRUPT);
+			const int position = payload->get_position();
+			Error err = decode_variant(token.literal, data.ptr() + position, literal_size);
+			ERR_FAIL_COND_V(err != OK, ERR_FILE_CORRUPT);
+			payload->seek(position + literal_size);
+			ERR_FAIL_COND_V(payload->get_available_bytes() < 6 * 4, ERR_FILE_CORRUPT);
+		}
+		token.start_line = payload->get_u32();
+		token.end_line = payload->get_u32();
+		token.start_column = payload->get_u32();
+		token.end_column = payload->get_u32();
+		token.leftmost_column = payload->get_u32();
+		token.rightmost_column = payload->get_u32();
+	}
+	ERR_FAIL_COND_V(w[token_count - 1].type != GDScriptTokenizer::Token::TK_EOF, ERR_FILE_CORRUPT);
+
+	return OK;
+}
+
+bool GDScriptTokenizerBuffer::is_valid_buffer(const Vector<uint8_t> &p_buffer) {
+	if (p_buffer.size() < HEADER_SIZE || memcmp(p_buffer.ptr(), TOKEN_BUFFER_MAGIC, 4) != 0) {
+		return false;
+	}
+	return decode_uint32(p_buffer.ptr() + 4) == TOKEN_BUFFER_VERSION;
+}
+
+uint64_t GDScriptTokenizerBuffer::get_source_hash(const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_COND_V(!is_valid_buffer(p_buffer), 0);
+	return decode_uint64(p_buffer.ptr() + 8);
+}
@@ -30,6 +30,7 @@
 
 #include "register_types.h"
 
+#include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
@@ -37,7 +38,9 @@
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
 #include "gdscript_cache.h"
+#include "gdscript_native_functions.h"
 #include "gdscript_tokenizer.h"
+#include "gdscript_tokenizer_buffer.h"
 #include "gdscript_utility_functions.h"
 
 #ifdef TESTS_ENABLED
@@ -50,14 +53,21 @@ Ref<ResourceFormatLoaderGDScript> resource_loader_gd;
 Ref<ResourceFormatSaverGDScript> resource_saver_gd;
 GDScriptCache *gdscript_cache = nullptr;
 
+#ifdef GDSCRIPT_NATIVE_CODE_ENABLED
+// Defined in the C++ file written when exporting with native code enabled.
+void register_gdscript_native_functions();
+#endif
+
 #ifdef TOOLS_ENABLED
 
+#include "editor/editor_file_system.h"
 #include "editor/editor_node.h"
 #include "editor/editor_settings.h"
 #include "editor/editor_translation_parser.h"
 #include "editor/export/editor_export.h"
 #include "editor/gdscript_highlighter.h"
 #include "editor/gdscript_translation_parser_plugin.h"
+#include "gdscript_cpp_codegen.h"
 
 #ifndef GDSCRIPT_NO_LSP
 #include "core/config/engine.h"
@@ -69,21 +79,53 @@ Ref<GDScriptEditorTranslationParserPlugin> gdscript_translation_parser_plugin;
 class EditorExportGDScript : public EditorExportPlugin {
 	GDCLASS(EditorExportGDScript, EditorExportPlugin);
 
+	void _add_native_code_scripts(EditorFileSystemDirectory *p_dir, GDScriptNativeCodeUnit &r_unit) {
+		for (int i = 0; i < p_dir->get_subdir_count(); i++) {
+			_add_native_code_scripts(p_dir->get_subdir(i), r_unit);
+		}
+		for (int i = 0; i < p_dir->get_file_count(); i++) {
+			if (p_dir->get_file_type(i) == "GDScript") {
+				r_unit.add_script(p_dir->get_file_path(i));
+			}
+		}
+	}
+
 public:
-	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
-		String script_key;
+	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
+		String native_code_path = GLOBAL_GET("editor/export/gdscript_native_code_path");
+		if (native_code_path.is_empty()) {
+			return;
+		}
+
+		GDScriptNativeCodeUnit unit;
+		_add_native_code_scripts(EditorFileSystem::get_singleton()->get_filesystem(), unit);
 
-		const Ref<EditorExportPreset> &preset = get_export_preset();
+		Error err;
+		Ref<FileAccess> f = FileAccess::open(native_code_path, FileAccess::WRITE, &err);
+		ERR_FAIL_COND_MSG(err != OK, "Cannot write GDScript native code to '" + native_code_path + "'.");
+		f->store_string(unit.get_source());
+		print_verbose(vformat("GDScript: Translated %d functions to C++ in '%s'.", unit.get_function_count(), native_code_path));
+	}
 
-		if (preset.is_valid()) {
-			script_key = preset->get_script_encryption_key().to_lower();
+	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
+		if (!p_path.ends_with(".gd") || !GLOBAL_GET("editor/export/convert_gdscript_to_binary_tokens")) {
+			return;
 		}
 
-		if (!p_path.ends_with(".gd")) {
+		String source = GDScriptCache::get_source_code(p_path);
+		GDScriptParser parser;
+		parser.set_record_tokens(true);
+		if (parser.parse(source, p_path, false) != OK) {
+			// Keep the source so the error is reported when the script is loaded.
+			WARN_PRINT(vformat("GDScript: Failed to parse '%s', exporting it as text.", p_path));
 			return;
 		}
 
-		return;
+		// The source hash is kept so translated native functions still match the script.
+		Vector<uint8_t> binary_tokens = GDScriptTokenizerBuffer::serialize(parser.get_recorded_tokens(), source.hash64());
+		ERR_FAIL_COND_MSG(binary_tokens.is_empty(), "Cannot convert GDScript '" + p_path + "' to binary tokens.");
+		add_file(p_path.get_basename() + ".gdc", binary_tokens, true);
+		skip();
 	}
 
 	virtual String _get_name() const override { return "GDScript"; }
@@ -126,6 +168,10 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 		gdscript_cache = memnew(GDScriptCache);
 
 		GDScriptUtilityFunctions::register_functions();
+
+#ifdef GDSCRIPT_NATIVE_CODE_ENABLED
+		register_gdscript_native_functions();
+#endif
 	}
 
 #ifdef TOOLS_ENABLED
@@ -158,6 +204,7 @@ void uninitialize_gdscript_module(ModuleInitializationLevel p_level) {
 
 		GDScriptParser::cleanup();
 		GDScriptUtilityFunctions::unregister_functions();
+		GDScriptNativeFunctions::clear();
 	}
 
 #ifdef TOOLS_ENABLED
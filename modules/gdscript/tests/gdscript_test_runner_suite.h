@@ -31,7 +31,13 @@
 #ifndef GDSCRIPT_TEST_RUNNER_SUITE_H
 #define GDSCRIPT_TEST_RUNNER_SUITE_H
 
+#include "../gdscript_parser.h"
+#include "../gdscript_tokenizer_buffer.h"
 #include "gdscript_test_runner.h"
+
+#include "core/io/compression.h"
+#include "core/io/marshalls.h"
+#include "core/io/stream_peer.h"
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -70,6 +76,97 @@ func _init():
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+#ifdef TOOLS_ENABLED
+TEST_CASE("[Modules][GDScript] Load binary tokens and run them") {
+	const String source = R"(
+extends RefCounted
+
+func _init():
+	var values := [
+		1,
+		2,
+	]
+	var sum := func(total, value):
+		return total + value
+	set_meta("result", values.reduce(sum, 39))
+)";
+
+	GDScriptParser parser;
+	parser.set_record_tokens(true);
+	REQUIRE_MESSAGE(parser.parse(source, "", false) == OK, "The script should parse successfully.");
+
+	const Vector<uint8_t> binary_tokens = GDScriptTokenizerBuffer::serialize(parser.get_recorded_tokens(), source.hash64());
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_binary_tokens_source(binary_tokens);
+	CHECK_MESSAGE(gdscript->get_source_hash() == source.hash64(), "The binary tokens should keep the source hash.");
+
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(error == OK, "The binary tokens should parse successfully.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
+}
+#endif // TOOLS_ENABLED
+
+// Builds a binary token buffer around the given (uncompressed) payload.
+static Vector<uint8_t> make_token_buffer(const Vector<uint8_t> &p_payload, uint32_t p_decompressed_size) {
+	Vector<uint8_t> buffer;
+	buffer.resize(GDScriptTokenizerBuffer::HEADER_SIZE + Compression::get_max_compressed_buffer_size(p_payload.size()));
+	uint8_t *w = buffer.ptrw();
+	memcpy(w, "GDSC", 4);
+	encode_uint32(GDScriptTokenizerBuffer::TOKEN_BUFFER_VERSION, w + 4);
+	encode_uint64(0, w + 8);
+	encode_uint32(p_decompressed_size, w + 16);
+	const int compressed_size = Compression::compress(w + GDScriptTokenizerBuffer::HEADER_SIZE, p_payload.ptr(), p_payload.size());
+	buffer.resize(GDScriptTokenizerBuffer::HEADER_SIZE + compressed_size);
+	return buffer;
+}
+
+TEST_CASE("[Modules][GDScript] Reject corrupted binary tokens") {
+	Vector<GDScriptTokenizer::Token> tokens;
+	Vector<uint8_t> payload;
+	payload.resize(8);
+
+	ERR_PRINT_OFF;
+	SUBCASE("Decompressed size larger than the data can hold") {
+		encode_uint32(0, payload.ptrw());
+		encode_uint32(1, payload.ptrw() + 4);
+		CHECK(GDScriptTokenizerBuffer::deserialize(make_token_buffer(payload, 0xFFFFFFF0), tokens) == ERR_FILE_CORRUPT);
+	}
+
+	SUBCASE("String count larger than the payload") {
+		encode_uint32(0x10000000, payload.ptrw());
+		encode_uint32(1, payload.ptrw() + 4);
+		CHECK(GDScriptTokenizerBuffer::deserialize(make_token_buffer(payload, payload.size()), tokens) == ERR_FILE_CORRUPT);
+	}
+
+	SUBCASE("Token count larger than the payload") {
+		encode_uint32(0, payload.ptrw());
+		encode_uint32(0x10000000, payload.ptrw() + 4);
+		CHECK(GDScriptTokenizerBuffer::deserialize(make_token_buffer(payload, payload.size()), tokens) == ERR_FILE_CORRUPT);
+	}
+
+	SUBCASE("Literal larger than the payload") {
+		Ref<StreamPeerBuffer> stream;
+		stream.instantiate();
+		stream->put_u32(1); // One empty string.
+		stream->put_u32(0);
+		stream->put_u32(1); // One literal token, whose value isn't there.
+		stream->put_u8(GDScriptTokenizer::Token::LITERAL);
+		stream->put_u32(0);
+		stream->put_u32(1000);
+		for (int i = 0; i < 6; i++) {
+			stream->put_u32(0);
+		}
+		payload = stream->get_data_array();
+		CHECK(GDScriptTokenizerBuffer::deserialize(make_token_buffer(payload, payload.size()), tokens) == ERR_FILE_CORRUPT);
+	}
+	ERR_PRINT_ON;
+}
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
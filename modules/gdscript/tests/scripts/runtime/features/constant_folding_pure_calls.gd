@@ -0,0 +1,44 @@
+# Pure builtin calls with constant arguments are folded at compile time,
+# and branches guarded by constant conditions are dropped.
+
+const LENGTH = Vector2(3, 4).length()
+const ABSOLUTE = Vector2i(3, -4).abs()
+const DIRECTION = Vector2.from_angle(0.0)
+const SHOUT = "hello".to_upper()
+const LABEL = str("level ", clamp(15, 0, 10))
+const IS_FLOAT = typeof(1.5) == TYPE_FLOAT
+const PICKED = 2 if true else randi()
+const TABLE = { "a": 1, "b": 2 }
+
+const VERBOSE = false
+const MODE = 1
+
+func describe() -> String:
+	if MODE == 0:
+		return "zero"
+	elif MODE == 1:
+		return "one"
+	else:
+		return "other"
+
+func scale(count: int) -> int:
+	while VERBOSE:
+		print("never printed")
+	var result := count if VERBOSE else count * 2
+	if VERBOSE:
+		print("never printed")
+	else:
+		result += 1
+	return result
+
+func test():
+	print(LENGTH)
+	print(ABSOLUTE)
+	print(DIRECTION)
+	print(SHOUT)
+	print(LABEL)
+	print(IS_FLOAT)
+	print(PICKED)
+	print(TABLE["b"])
+	print(describe())
+	print(scale(20))
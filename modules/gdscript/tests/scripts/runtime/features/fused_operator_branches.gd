@@ -0,0 +1,51 @@
+# Typed comparisons feeding a branch and operators assigned to a local are
+# fused into single instructions. Make sure the results are unchanged.
+
+func classify(n: int) -> String:
+	if n < 0:
+		return "negative"
+	elif n == 0:
+		return "zero"
+	elif n > 0 and n < 10:
+		return "small"
+	return "large"
+
+func sum_odd_until(limit: int) -> int:
+	var total := 0
+	var i := 0
+	while i < limit:
+		i += 1
+		if i % 2 == 0:
+			continue
+		if total > 50:
+			break
+		total += i
+	return total
+
+func test():
+	for n in [-5, 0, 3, 42]:
+		print(classify(n))
+
+	print(sum_odd_until(10))
+	print(sum_odd_until(100))
+
+	var a := 3
+	var b := 4
+	var c := a * b + 1
+	print(c)
+	var f := 1.5
+	var g := f * 3.0
+	print(g)
+
+	var bigger := a if a > b else b
+	print(bigger)
+	print(not (a < b))
+	print(a < b or b < a)
+
+	var count := 0
+	for i in 6:
+		if i < 2:
+			count += 10
+		else:
+			count += 1
+	print(count)
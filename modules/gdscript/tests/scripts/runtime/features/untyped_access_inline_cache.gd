@@ -0,0 +1,59 @@
+# Untyped named accesses and calls are cached per instruction,
+# results must not change when the receiver type changes.
+
+class A:
+	var value = 1
+
+	func describe():
+		return "A %s" % value
+
+class B extends A:
+	func describe():
+		return "B %s" % value
+
+class WithGetter:
+	var value:
+		get:
+			return 10
+
+	func describe():
+		return "WithGetter %s" % value
+
+class Dynamic:
+	func _get(property):
+		if property == &"value":
+			return 20
+		return null
+
+	func describe():
+		return "Dynamic"
+
+func get_value(base):
+	return base.value
+
+func set_value(base, value):
+	base.value = value
+
+func test():
+	var receivers = [A.new(), B.new(), WithGetter.new(), Dynamic.new(), A.new()]
+	for _i in 2:
+		for receiver in receivers:
+			print(receiver.describe(), " ", get_value(receiver))
+
+	var a = A.new()
+	for value in [5, "text", 7.5]:
+		set_value(a, value)
+		print(get_value(a))
+
+	var vectors = [Vector2(1, 2), Vector3(3, 4, 5), Vector2i(6, 7)]
+	for _i in 2:
+		for vector in vectors:
+			var copy = vector
+			copy.x = 8
+			print(vector.x, " ", vector.abs(), " ", copy)
+
+	var nodes = [Node.new(), Node2D.new()]
+	for node in nodes:
+		node.name = "Cached"
+		print(node.name, " ", node.get_child_count())
+		node.free()
@@ -0,0 +1,284 @@
+/**************************************************************************/
+/*  test_gdscript_cpp_codegen.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GDSCRIPT_CPP_CODEGEN_H
+#define TEST_GDSCRIPT_CPP_CODEGEN_H
+
+#include "../gdscript.h"
+#include "../gdscript_cpp_codegen.h"
+#include "../gdscript_native_functions.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+#ifdef TOOLS_ENABLED
+
+// Writes `p_code` to a script file and translates it, returning the generated C++ source.
+static String translate_script_to_cpp(const String &p_name, const String &p_code, int &r_function_count) {
+	const String path = OS::get_singleton()->get_cache_path().path_join(p_name + ".gd");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(p_code);
+	}
+
+	GDScriptNativeCodeUnit unit;
+	REQUIRE_MESSAGE(unit.add_script(path) == OK, "The script should be translated successfully.");
+	r_function_count = unit.get_function_count();
+	return unit.get_source();
+}
+
+TEST_CASE("[Modules][GDScript] C++ translation of typed functions") {
+	int function_count = 0;
+
+	SUBCASE("Integers are promoted to floats") {
+		const String source = translate_script_to_cpp("cpp_codegen_promotion", R"(
+func promote(a: int) -> float:
+	var f: float = a
+	return f
+
+func mix(a: int) -> float:
+	return a + 0.5
+)",
+				function_count);
+		CHECK(function_count == 2);
+		CHECK_MESSAGE(source.contains("_float = double(s"), "Assigning an int to a float variable should convert it.");
+		CHECK_MESSAGE(source.contains("_int + 0x1p-1;"), "Float literals should be written exactly.");
+	}
+
+	SUBCASE("Integer division and modulo check for zero") {
+		const String source = translate_script_to_cpp("cpp_codegen_division", R"(
+func divide(a: int, b: int) -> int:
+	return a / b
+
+func modulo(a: int, b: int) -> int:
+	return a % b
+
+func divide_float(a: float, b: float) -> float:
+	return a / b
+)",
+				function_count);
+		CHECK(function_count == 3);
+		CHECK(source.contains("== 0)) {"));
+		CHECK(source.contains("Division by zero error in operator '/'."));
+		CHECK(source.contains("Modulo by zero error in operator '%'."));
+		const int float_division = source.find("::divide_float\n");
+		REQUIRE(float_division != -1);
+		CHECK_MESSAGE(!source.substr(float_division, source.find("}\n\n", float_division) - float_division).contains("by zero"), "Float division by zero is allowed.");
+	}
+
+	SUBCASE("Power of integers goes through floats") {
+		const String source = translate_script_to_cpp("cpp_codegen_power", R"(
+func power(a: int, b: int) -> int:
+	return a ** b
+)",
+				function_count);
+		CHECK(function_count == 1);
+		CHECK(source.contains("= int64_t(Math::pow(double(s"));
+	}
+
+	SUBCASE("Loops over an integer become counted loops") {
+		const String source = translate_script_to_cpp("cpp_codegen_for", R"(
+func sum(n: int) -> int:
+	var total := 0
+	for i in n:
+		total += i
+	return total
+)",
+				function_count);
+		CHECK(function_count == 1);
+		CHECK(source.contains("const int64_t f0_size = s"));
+		CHECK(source.contains("for (int64_t f0 = 0; f0 < f0_size; f0++) {"));
+		CHECK(source.contains("_int = f0;"));
+	}
+
+	SUBCASE("While loops keep break and continue") {
+		const String source = translate_script_to_cpp("cpp_codegen_while", R"(
+func count(n: int) -> int:
+	var i := 0
+	var total := 0
+	while i < n:
+		i += 1
+		if i % 2 == 0:
+			continue
+		if i > 7:
+			break
+		total += i
+	return total
+)",
+				function_count);
+		CHECK(function_count == 1);
+		CHECK(source.contains("while (true) {"));
+		CHECK_MESSAGE(source.contains("_bool) {\n\t\t\tbreak;\n\t\t}"), "The loop condition should be checked inside the loop.");
+		CHECK(source.contains("continue;"));
+		CHECK(source.contains("break;"));
+	}
+
+	SUBCASE("Logical operators short-circuit") {
+		const String source = translate_script_to_cpp("cpp_codegen_logic", R"(
+func both(a: bool, b: bool) -> bool:
+	return a and b
+
+func either(a: bool, b: bool) -> bool:
+	return a or b
+)",
+				function_count);
+		CHECK(function_count == 2);
+		CHECK_MESSAGE(source.contains("if (c0) {"), "The right operand of `and` should only be evaluated if the left one is true.");
+		CHECK_MESSAGE(source.contains("if (!c0) {"), "The right operand of `or` should only be evaluated if the left one is false.");
+	}
+
+	SUBCASE("Ternaries become branches") {
+		const String source = translate_script_to_cpp("cpp_codegen_ternary", R"(
+func pick(a: int, b: int) -> int:
+	return a if a > b else b
+)",
+				function_count);
+		CHECK(function_count == 1);
+		CHECK(source.contains("if (t"));
+		CHECK(source.contains("} else {"));
+	}
+}
+
+TEST_CASE("[Modules][GDScript] C++ translation falls back to bytecode") {
+	int function_count = 0;
+	const String source = translate_script_to_cpp("cpp_codegen_fallback", R"(
+var value: int = 1
+
+func translated(a: int) -> int:
+	return a + 1
+
+func with_call(a: int) -> int:
+	return absi(a)
+
+func with_member() -> int:
+	return value
+
+func with_default(a: int = 1) -> int:
+	return a
+)",
+			function_count);
+	CHECK_MESSAGE(function_count == 1, "Only the function without calls, members or default arguments should be translated.");
+	CHECK(source.contains("::translated\n"));
+	CHECK_FALSE(source.contains("::with_call\n"));
+	CHECK_FALSE(source.contains("::with_member\n"));
+	CHECK_FALSE(source.contains("::with_default\n"));
+	CHECK(source.contains("GDScriptNativeFunctions::register_function("));
+}
+
+#endif // TOOLS_ENABLED
+
+// Written like the translator would write `a * 100 + b`, so the result tells it apart from the bytecode `a + b`.
+static Variant native_add_stub(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+	int64_t s0_int = p_args[0]->operator int64_t();
+	int64_t s1_int = p_args[1]->operator int64_t();
+	return Variant(int64_t(s0_int * int64_t(100LL) + s1_int));
+}
+
+TEST_CASE("[Modules][GDScript] Native function registry checks the source hash") {
+	const String class_name = "res://test_native_function_registry.gd";
+	GDScriptNativeFunctions::register_function(class_name, "run", 1234, &native_add_stub);
+	CHECK(GDScriptNativeFunctions::has_functions());
+	CHECK((GDScriptNativeFunctions::get_function(class_name, "run", 1234) == &native_add_stub));
+	CHECK_MESSAGE((GDScriptNativeFunctions::get_function(class_name, "run", 4321) == nullptr), "A changed script should keep running as bytecode.");
+	CHECK((GDScriptNativeFunctions::get_function(class_name, "other", 1234) == nullptr));
+
+	GDScriptNativeFunctions::unregister_function(class_name, "run");
+	CHECK((GDScriptNativeFunctions::get_function(class_name, "run", 1234) == nullptr));
+}
+
+TEST_CASE("[Modules][GDScript] Registered native functions are called by the VM") {
+	const String source = R"(
+extends RefCounted
+
+func add(a: int, b: int) -> int:
+	return a + b
+
+func sub(a: int, b: int) -> int:
+	return a - b
+)";
+	const String path = "res://test_native_call.gd";
+	GDScriptNativeFunctions::register_function(path, "add", source.hash64(), &native_add_stub);
+	// Registered for another version of the source, so it must be ignored.
+	GDScriptNativeFunctions::register_function(path, "sub", source.hash64() + 1, &native_add_stub);
+
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_path(path, true);
+	gdscript->set_source_code(source);
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	Callable::CallError ce;
+	Variant a = 2;
+	Variant b = 3;
+	const Variant *args[2] = { &a, &b };
+
+	CHECK_MESSAGE(int(ref_counted->callp("add", args, 2, ce)) == 203, "The native function should be called instead of the bytecode.");
+	CHECK(ce.error == Callable::CallError::CALL_OK);
+	CHECK_MESSAGE(int(ref_counted->callp("sub", args, 2, ce)) == -1, "A native function for another source should not be used.");
+
+	SUBCASE("Arguments are converted to the parameter types") {
+		a = 2.0;
+		CHECK(int(ref_counted->callp("add", args, 2, ce)) == 203);
+		CHECK(ce.error == Callable::CallError::CALL_OK);
+	}
+
+	SUBCASE("Wrong argument count") {
+		ref_counted->callp("add", args, 1, ce);
+		CHECK(ce.error == Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS);
+		ref_counted->callp("add", args, 3, ce);
+		CHECK(ce.error == Callable::CallError::CALL_ERROR_TOO_MANY_ARGUMENTS);
+	}
+
+	SUBCASE("Wrong argument type") {
+		b = "three";
+		ref_counted->callp("add", args, 2, ce);
+		CHECK(ce.error == Callable::CallError::CALL_ERROR_INVALID_ARGUMENT);
+		CHECK(ce.argument == 1);
+		CHECK(ce.expected == Variant::INT);
+	}
+
+	ref_counted.unref();
+	gdscript.unref();
+	GDScriptNativeFunctions::unregister_function(path, "add");
+	GDScriptNativeFunctions::unregister_function(path, "sub");
+}
+
+} // namespace GDScriptTests
+
+#endif // TEST_GDSCRIPT_CPP_CODEGEN_H
@@ -107,6 +107,9 @@ void MultiplayerSynchronizer::reset() {
 	net_id = 0;
 	last_sync_msec = 0;
 	last_inbound_sync = 0;
+	watchers.clear();
+	last_watch_usec = 0;
+	last_change_usec = 0;
 }
 
 uint32_t MultiplayerSynchronizer::get_net_id() const {
@@ -137,6 +140,79 @@ bool MultiplayerSynchronizer::update_inbound_sync_time(uint16_t p_network_time)
 	return true;
 }
 
+void MultiplayerSynchronizer::_watch_changes(uint64_t p_usec) {
+	if (last_watch_usec == p_usec) {
+		return; // Already gathered on this frame.
+	}
+	if (last_watch_usec && p_usec < last_watch_usec + delta_interval_msec * 1000) {
+		return;
+	}
+	Node *node = get_root_node();
+	if (node == nullptr || replication_config.is_null()) {
+		return;
+	}
+	const List<NodePath> &props = replication_config->get_watch_properties();
+	ERR_FAIL_COND_MSG(props.size() > SceneReplicationConfig::MAX_WATCHED_PROPERTIES, vformat("A MultiplayerSynchronizer can watch at most %d properties.", SceneReplicationConfig::MAX_WATCHED_PROPERTIES));
+	last_watch_usec = p_usec;
+	if (uint32_t(props.size()) != watchers.size()) {
+		watchers.resize(props.size());
+	}
+	int idx = 0;
+	for (const NodePath &prop : props) {
+		Watcher &w = watchers[idx++];
+		const Object *obj = _get_prop_target(node, prop);
+		ERR_CONTINUE(!obj);
+		bool valid = false;
+		Variant v = obj->get(prop.get_concatenated_subnames(), &valid);
+		ERR_CONTINUE_MSG(!valid, vformat("Property '%s' not found.", prop));
+		if (delta_quantize_floats && v.get_type() == Variant::FLOAT) {
+			// Single precision floats are encoded in half the bytes.
+			v = double(float(v.operator double()));
+		}
+		if (w.prop != prop) {
+			// New watcher (or the configuration changed), always send the first value.
+			w.prop = prop;
+		} else if (w.last_change_usec && v.hash_compare(w.value)) {
+			continue;
+		}
+		w.value = v;
+		w.last_change_usec = p_usec;
+		last_change_usec = p_usec;
+	}
+}
+
+uint64_t MultiplayerSynchronizer::get_delta_state(uint64_t p_cur_usec, uint64_t p_last_usec, Vector<const Variant *> &r_variant_ptrs) {
+	r_variant_ptrs.clear();
+	_watch_changes(p_cur_usec);
+	if (last_change_usec <= p_last_usec) {
+		return 0; // Nothing changed since the peer baseline.
+	}
+	uint64_t indexes = 0;
+	for (uint32_t i = 0; i < watchers.size(); i++) {
+		if (watchers[i].last_change_usec > p_last_usec) {
+			indexes |= 1ULL << i;
+			r_variant_ptrs.push_back(&watchers[i].value);
+		}
+	}
+	return indexes;
+}
+
+List<NodePath> MultiplayerSynchronizer::get_delta_properties(uint64_t p_indexes) {
+	List<NodePath> out;
+	ERR_FAIL_COND_V(replication_config.is_null(), out);
+	int idx = 0;
+	for (const NodePath &prop : replication_config->get_watch_properties()) {
+		if (idx >= SceneReplicationConfig::MAX_WATCHED_PROPERTIES) {
+			break;
+		}
+		if (p_indexes & (1ULL << idx)) {
+			out.push_back(prop);
+		}
+		idx++;
+	}
+	return out;
+}
+
 PackedStringArray MultiplayerSynchronizer::get_configuration_warnings() const {
 	PackedStringArray warnings = Node::get_configuration_warnings();
 
@@ -236,6 +312,20 @@ MultiplayerSynchronizer::VisibilityUpdateMode MultiplayerSynchronizer::get_visib
 	return visibility_update_mode;
 }
 
+void MultiplayerSynchronizer::set_spatial_interest_enabled(bool p_enabled) {
+	if (spatial_interest == p_enabled) {
+		return;
+	}
+	// The replication interface only tracks spatial synchronizers on configuration, restart it.
+	_stop();
+	spatial_interest = p_enabled;
+	_start();
+}
+
+bool MultiplayerSynchronizer::is_spatial_interest_enabled() const {
+	return spatial_interest;
+}
+
 void MultiplayerSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_root_path", "path"), &MultiplayerSynchronizer::set_root_path);
 	ClassDB::bind_method(D_METHOD("get_root_path"), &MultiplayerSynchronizer::get_root_path);
@@ -243,6 +333,15 @@ void MultiplayerSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_replication_interval", "milliseconds"), &MultiplayerSynchronizer::set_replication_interval);
 	ClassDB::bind_method(D_METHOD("get_replication_interval"), &MultiplayerSynchronizer::get_replication_interval);
 
+	ClassDB::bind_method(D_METHOD("set_replication_priority", "priority"), &MultiplayerSynchronizer::set_replication_priority);
+	ClassDB::bind_method(D_METHOD("get_replication_priority"), &MultiplayerSynchronizer::get_replication_priority);
+
+	ClassDB::bind_method(D_METHOD("set_delta_interval", "seconds"), &MultiplayerSynchronizer::set_delta_interval);
+	ClassDB::bind_method(D_METHOD("get_delta_interval"), &MultiplayerSynchronizer::get_delta_interval);
+
+	ClassDB::bind_method(D_METHOD("set_delta_quantize_floats", "enabled"), &MultiplayerSynchronizer::set_delta_quantize_floats);
+	ClassDB::bind_method(D_METHOD("is_delta_quantize_floats_enabled"), &MultiplayerSynchronizer::is_delta_quantize_floats_enabled);
+
 	ClassDB::bind_method(D_METHOD("set_replication_config", "config"), &MultiplayerSynchronizer::set_replication_config);
 	ClassDB::bind_method(D_METHOD("get_replication_config"), &MultiplayerSynchronizer::get_replication_config);
 
@@ -256,19 +355,26 @@ void MultiplayerSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_visibility_filter", "filter"), &MultiplayerSynchronizer::add_visibility_filter);
 	ClassDB::bind_method(D_METHOD("remove_visibility_filter", "filter"), &MultiplayerSynchronizer::remove_visibility_filter);
 	ClassDB::bind_method(D_METHOD("set_visibility_for", "peer", "visible"), &MultiplayerSynchronizer::set_visibility_for);
+	ClassDB::bind_method(D_METHOD("set_spatial_interest_enabled", "enabled"), &MultiplayerSynchronizer::set_spatial_interest_enabled);
+	ClassDB::bind_method(D_METHOD("is_spatial_interest_enabled"), &MultiplayerSynchronizer::is_spatial_interest_enabled);
 	ClassDB::bind_method(D_METHOD("get_visibility_for", "peer"), &MultiplayerSynchronizer::get_visibility_for);
 
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_path"), "set_root_path", "get_root_path");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "replication_interval", PROPERTY_HINT_RANGE, "0,5,0.001,suffix:s"), "set_replication_interval", "get_replication_interval");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "replication_priority", PROPERTY_HINT_RANGE, "0.01,100,0.01,or_greater"), "set_replication_priority", "get_replication_priority");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "delta_interval", PROPERTY_HINT_RANGE, "0,5,0.001,suffix:s"), "set_delta_interval", "get_delta_interval");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "delta_quantize_floats"), "set_delta_quantize_floats", "is_delta_quantize_floats_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "replication_config", PROPERTY_HINT_RESOURCE_TYPE, "SceneReplicationConfig", PROPERTY_USAGE_NO_EDITOR), "set_replication_config", "get_replication_config");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "visibility_update_mode", PROPERTY_HINT_ENUM, "Idle,Physics,None"), "set_visibility_update_mode", "get_visibility_update_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "public_visibility"), "set_visibility_public", "is_visibility_public");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "spatial_interest"), "set_spatial_interest_enabled", "is_spatial_interest_enabled");
 
 	BIND_ENUM_CONSTANT(VISIBILITY_PROCESS_IDLE);
 	BIND_ENUM_CONSTANT(VISIBILITY_PROCESS_PHYSICS);
 	BIND_ENUM_CONSTANT(VISIBILITY_PROCESS_NONE);
 
 	ADD_SIGNAL(MethodInfo("synchronized"));
+	ADD_SIGNAL(MethodInfo("delta_synchronized"));
 	ADD_SIGNAL(MethodInfo("visibility_changed", PropertyInfo(Variant::INT, "for_peer")));
 }
 
@@ -307,8 +413,35 @@ double MultiplayerSynchronizer::get_replication_interval() const {
 	return double(interval_msec) / 1000.0;
 }
 
+void MultiplayerSynchronizer::set_replication_priority(real_t p_priority) {
+	ERR_FAIL_COND_MSG(p_priority <= 0, "Priority must be greater than 0.");
+	replication_priority = p_priority;
+}
+
+real_t MultiplayerSynchronizer::get_replication_priority() const {
+	return replication_priority;
+}
+
+void MultiplayerSynchronizer::set_delta_interval(double p_interval) {
+	ERR_FAIL_COND_MSG(p_interval < 0, "Interval must be greater or equal to 0 (where 0 means default)");
+	delta_interval_msec = uint64_t(p_interval * 1000);
+}
+
+double MultiplayerSynchronizer::get_delta_interval() const {
+	return double(delta_interval_msec) / 1000.0;
+}
+
+void MultiplayerSynchronizer::set_delta_quantize_floats(bool p_enabled) {
+	delta_quantize_floats = p_enabled;
+}
+
+bool MultiplayerSynchronizer::is_delta_quantize_floats_enabled() const {
+	return delta_quantize_floats;
+}
+
 void MultiplayerSynchronizer::set_replication_config(Ref<SceneReplicationConfig> p_config) {
 	replication_config = p_config;
+	watchers.clear();
 }
 
 Ref<SceneReplicationConfig> MultiplayerSynchronizer::get_replication_config() {
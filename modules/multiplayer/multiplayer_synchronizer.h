@@ -46,10 +46,20 @@ public:
 	};
 
 private:
+	struct Watcher {
+		NodePath prop;
+		uint64_t last_change_usec = 0;
+		Variant value;
+	};
+
 	Ref<SceneReplicationConfig> replication_config;
 	NodePath root_path = NodePath(".."); // Start with parent, like with AnimationPlayer.
 	uint64_t interval_msec = 0;
+	real_t replication_priority = 1.0;
+	uint64_t delta_interval_msec = 0;
+	bool delta_quantize_floats = false;
 	VisibilityUpdateMode visibility_update_mode = VISIBILITY_PROCESS_IDLE;
+	bool spatial_interest = false;
 	HashSet<Callable> visibility_filters;
 	HashSet<int> peer_visibility;
 
@@ -58,10 +68,15 @@ private:
 	uint16_t last_inbound_sync = 0;
 	uint32_t net_id = 0;
 
+	LocalVector<Watcher> watchers;
+	uint64_t last_watch_usec = 0;
+	uint64_t last_change_usec = 0;
+
 	static Object *_get_prop_target(Object *p_obj, const NodePath &p_prop);
 	void _start();
 	void _stop();
 	void _update_process();
+	void _watch_changes(uint64_t p_usec);
 
 protected:
 	static void _bind_methods();
@@ -80,11 +95,24 @@ public:
 	bool update_outbound_sync_time(uint64_t p_msec);
 	bool update_inbound_sync_time(uint16_t p_network_time);
 
+	uint64_t get_last_change_usec() const { return last_change_usec; }
+	uint64_t get_delta_state(uint64_t p_cur_usec, uint64_t p_last_usec, Vector<const Variant *> &r_variant_ptrs);
+	List<NodePath> get_delta_properties(uint64_t p_indexes);
+
 	PackedStringArray get_configuration_warnings() const override;
 
 	void set_replication_interval(double p_interval);
 	double get_replication_interval() const;
 
+	void set_replication_priority(real_t p_priority);
+	real_t get_replication_priority() const;
+
+	void set_delta_interval(double p_interval);
+	double get_delta_interval() const;
+
+	void set_delta_quantize_floats(bool p_enabled);
+	bool is_delta_quantize_floats_enabled() const;
+
 	void set_replication_config(Ref<SceneReplicationConfig> p_config);
 	Ref<SceneReplicationConfig> get_replication_config();
 
@@ -103,6 +131,9 @@ public:
 	void remove_visibility_filter(Callable p_callback);
 	VisibilityUpdateMode get_visibility_update_mode() const;
 
+	void set_spatial_interest_enabled(bool p_enabled);
+	bool is_spatial_interest_enabled() const;
+
 	MultiplayerSynchronizer();
 };
 
@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  scene_interest_grid.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "scene_interest_grid.h"
+
+void SceneInterestGrid::_cell_remove(const Vector3i &p_cell, const ObjectID &p_id) {
+	LocalVector<ObjectID> *cell = cells.getptr(p_cell);
+	ERR_FAIL_COND(!cell); // Bug.
+	int64_t idx = cell->find(p_id);
+	ERR_FAIL_COND(idx < 0); // Bug.
+	cell->remove_at_unordered(idx);
+	if (cell->is_empty()) {
+		cells.erase(p_cell);
+	}
+}
+
+void SceneInterestGrid::set_cell_size(real_t p_size) {
+	ERR_FAIL_COND_MSG(p_size <= 0, "Cell size must be greater than 0.");
+	if (cell_size == p_size) {
+		return;
+	}
+	cell_size = p_size;
+	cells.clear();
+	for (KeyValue<ObjectID, Entry> &E : entries) {
+		E.value.cell = _get_cell(E.value.position);
+		cells[E.value.cell].push_back(E.key);
+	}
+}
+
+void SceneInterestGrid::update(const ObjectID &p_id, const Vector3 &p_position) {
+	const Vector3i cell = _get_cell(p_position);
+	Entry *entry = entries.getptr(p_id);
+	if (!entry) {
+		Entry e;
+		e.position = p_position;
+		e.cell = cell;
+		entries.insert(p_id, e);
+		cells[cell].push_back(p_id);
+		return;
+	}
+	entry->position = p_position;
+	if (entry->cell == cell) {
+		return;
+	}
+	_cell_remove(entry->cell, p_id);
+	entry->cell = cell;
+	cells[cell].push_back(p_id);
+}
+
+void SceneInterestGrid::remove(const ObjectID &p_id) {
+	const Entry *entry = entries.getptr(p_id);
+	if (!entry) {
+		return;
+	}
+	_cell_remove(entry->cell, p_id);
+	entries.erase(p_id);
+}
+
+void SceneInterestGrid::clear() {
+	entries.clear();
+	cells.clear();
+}
+
+void SceneInterestGrid::query(const Vector3 &p_origin, real_t p_radius, real_t p_leave_radius, const HashMap<ObjectID, real_t> &p_previous, HashMap<ObjectID, real_t> &r_relevance) const {
+	r_relevance.clear();
+	if (p_radius <= 0 || entries.is_empty()) {
+		return;
+	}
+	const real_t radius_sq = p_radius * p_radius;
+	const real_t search_radius = MAX(p_radius, p_leave_radius);
+	const real_t leave_radius_sq = search_radius * search_radius;
+	const Vector3i from = _get_cell(p_origin - Vector3(search_radius, search_radius, search_radius));
+	const Vector3i to = _get_cell(p_origin + Vector3(search_radius, search_radius, search_radius));
+	for (int x = from.x; x <= to.x; x++) {
+		for (int y = from.y; y <= to.y; y++) {
+			for (int z = from.z; z <= to.z; z++) {
+				const LocalVector<ObjectID> *cell = cells.getptr(Vector3i(x, y, z));
+				if (!cell) {
+					continue;
+				}
+				for (const ObjectID &id : *cell) {
+					const real_t dist_sq = p_origin.distance_squared_to(entries[id].position);
+					if (dist_sq <= radius_sq) {
+						r_relevance.insert(id, 1.0 - Math::sqrt(dist_sq) / p_radius);
+					} else if (dist_sq <= leave_radius_sq && p_previous.has(id)) {
+						r_relevance.insert(id, 0.0);
+					}
+				}
+			}
+		}
+	}
+}
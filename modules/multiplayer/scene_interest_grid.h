@@ -0,0 +1,72 @@
+/**************************************************************************/
+/*  scene_interest_grid.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SCENE_INTEREST_GRID_H
+#define SCENE_INTEREST_GRID_H
+
+#include "core/math/vector3.h"
+#include "core/math/vector3i.h"
+#include "core/object/object_id.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Uniform hash grid used to find the synchronizers relevant to each peer observer.
+class SceneInterestGrid {
+private:
+	struct Entry {
+		Vector3 position;
+		Vector3i cell;
+	};
+
+	real_t cell_size = 100;
+	HashMap<ObjectID, Entry> entries;
+	HashMap<Vector3i, LocalVector<ObjectID>> cells;
+
+	_FORCE_INLINE_ Vector3i _get_cell(const Vector3 &p_position) const {
+		return Vector3i((p_position / cell_size).floor());
+	}
+	void _cell_remove(const Vector3i &p_cell, const ObjectID &p_id);
+
+public:
+	void set_cell_size(real_t p_size);
+	real_t get_cell_size() const { return cell_size; }
+
+	void update(const ObjectID &p_id, const Vector3 &p_position);
+	void remove(const ObjectID &p_id);
+	void clear();
+	bool is_empty() const { return entries.is_empty(); }
+
+	// Fills r_relevance with the entries within p_radius of p_origin, mapped to 1.0 (at the origin) down to 0.0 (at the radius).
+	// The entries of p_previous stay relevant (at 0.0) until they are farther than p_leave_radius, so the ones moving
+	// along the radius don't keep entering and leaving.
+	void query(const Vector3 &p_origin, real_t p_radius, real_t p_leave_radius, const HashMap<ObjectID, real_t> &p_previous, HashMap<ObjectID, real_t> &r_relevance) const;
+};
+
+#endif // SCENE_INTEREST_GRID_H
@@ -72,6 +72,8 @@ Error SceneMultiplayer::poll() {
 		return OK;
 	}
 
+	// Send the RPCs batched since the last poll.
+	rpc->flush_batches();
 	multiplayer_peer->poll();
 
 	_update_status();
@@ -179,6 +181,7 @@ void SceneMultiplayer::clear() {
 	pending_peers.clear();
 	connected_peers.clear();
 	packet_cache.clear();
+	rpc->clear_batches();
 	replicator->on_reset();
 	cache->clear();
 	relay_buffer->clear();
@@ -250,7 +253,11 @@ void SceneMultiplayer::_process_packet(int p_from, const uint8_t *p_packet, int
 			replicator->on_despawn_receive(p_from, p_packet, p_packet_len);
 		} break;
 		case NETWORK_COMMAND_SYNC: {
-			replicator->on_sync_receive(p_from, p_packet, p_packet_len);
+			if (p_packet[0] & (1 << CMD_FLAG_0_SHIFT)) {
+				replicator->on_delta_receive(p_from, p_packet, p_packet_len);
+			} else {
+				replicator->on_sync_receive(p_from, p_packet, p_packet_len);
+			}
 		} break;
 		default: {
 			ERR_FAIL_MSG("Invalid network command from " + itos(p_from));
@@ -266,6 +273,10 @@ _FORCE_INLINE_ Error SceneMultiplayer::_send(const uint8_t *p_packet, int p_pack
 #endif
 
 Error SceneMultiplayer::send_command(int p_to, const uint8_t *p_packet, int p_packet_len) {
+	if (rpc->has_pending_batches()) {
+		// Any other command must go after the RPCs called before it.
+		rpc->flush_batches();
+	}
 	if (server_relay && get_unique_id() != 1 && p_to != 1 && multiplayer_peer->is_server_relay_supported()) {
 		// Send relay packet.
 		relay_buffer->seek(0);
@@ -617,6 +628,46 @@ bool SceneMultiplayer::is_server_relay_enabled() const {
 	return server_relay;
 }
 
+void SceneMultiplayer::set_interest_observer(int p_peer, Node *p_node) {
+	replicator->set_interest_observer(p_peer, p_node);
+}
+
+Node *SceneMultiplayer::get_interest_observer(int p_peer) const {
+	return replicator->get_interest_observer(p_peer);
+}
+
+void SceneMultiplayer::set_interest_radius(double p_radius) {
+	replicator->set_interest_radius(p_radius);
+}
+
+double SceneMultiplayer::get_interest_radius() const {
+	return replicator->get_interest_radius();
+}
+
+void SceneMultiplayer::set_max_sync_packet_size(int p_size) {
+	replicator->set_max_sync_packet_size(p_size);
+}
+
+int SceneMultiplayer::get_max_sync_packet_size() const {
+	return replicator->get_max_sync_packet_size();
+}
+
+void SceneMultiplayer::set_max_sync_bytes_per_frame(int p_bytes) {
+	replicator->set_max_sync_bytes_per_frame(p_bytes);
+}
+
+int SceneMultiplayer::get_max_sync_bytes_per_frame() const {
+	return replicator->get_max_sync_bytes_per_frame();
+}
+
+void SceneMultiplayer::set_rpc_batching_enabled(bool p_enabled) {
+	rpc->set_batching_enabled(p_enabled);
+}
+
+bool SceneMultiplayer::is_rpc_batching_enabled() const {
+	return rpc->is_batching_enabled();
+}
+
 void SceneMultiplayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_root_path", "path"), &SceneMultiplayer::set_root_path);
 	ClassDB::bind_method(D_METHOD("get_root_path"), &SceneMultiplayer::get_root_path);
@@ -639,6 +690,16 @@ void SceneMultiplayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_object_decoding_allowed"), &SceneMultiplayer::is_object_decoding_allowed);
 	ClassDB::bind_method(D_METHOD("set_server_relay_enabled", "enabled"), &SceneMultiplayer::set_server_relay_enabled);
 	ClassDB::bind_method(D_METHOD("is_server_relay_enabled"), &SceneMultiplayer::is_server_relay_enabled);
+	ClassDB::bind_method(D_METHOD("set_rpc_batching_enabled", "enabled"), &SceneMultiplayer::set_rpc_batching_enabled);
+	ClassDB::bind_method(D_METHOD("is_rpc_batching_enabled"), &SceneMultiplayer::is_rpc_batching_enabled);
+	ClassDB::bind_method(D_METHOD("set_interest_observer", "peer", "node"), &SceneMultiplayer::set_interest_observer);
+	ClassDB::bind_method(D_METHOD("get_interest_observer", "peer"), &SceneMultiplayer::get_interest_observer);
+	ClassDB::bind_method(D_METHOD("set_interest_radius", "radius"), &SceneMultiplayer::set_interest_radius);
+	ClassDB::bind_method(D_METHOD("get_interest_radius"), &SceneMultiplayer::get_interest_radius);
+	ClassDB::bind_method(D_METHOD("set_max_sync_packet_size", "size"), &SceneMultiplayer::set_max_sync_packet_size);
+	ClassDB::bind_method(D_METHOD("get_max_sync_packet_size"), &SceneMultiplayer::get_max_sync_packet_size);
+	ClassDB::bind_method(D_METHOD("set_max_sync_bytes_per_frame", "bytes"), &SceneMultiplayer::set_max_sync_bytes_per_frame);
+	ClassDB::bind_method(D_METHOD("get_max_sync_bytes_per_frame"), &SceneMultiplayer::get_max_sync_bytes_per_frame);
 	ClassDB::bind_method(D_METHOD("send_bytes", "bytes", "id", "mode", "channel"), &SceneMultiplayer::send_bytes, DEFVAL(MultiplayerPeer::TARGET_PEER_BROADCAST), DEFVAL(MultiplayerPeer::TRANSFER_MODE_RELIABLE), DEFVAL(0));
 
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_path"), "set_root_path", "get_root_path");
@@ -647,6 +708,10 @@ void SceneMultiplayer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "allow_object_decoding"), "set_allow_object_decoding", "is_object_decoding_allowed");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "refuse_new_connections"), "set_refuse_new_connections", "is_refusing_new_connections");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "server_relay"), "set_server_relay_enabled", "is_server_relay_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "rpc_batching"), "set_rpc_batching_enabled", "is_rpc_batching_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_sync_packet_size", PROPERTY_HINT_RANGE, "128,4096,1,or_greater,suffix:B"), "set_max_sync_packet_size", "get_max_sync_packet_size");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_sync_bytes_per_frame", PROPERTY_HINT_RANGE, "0,65536,1,or_greater,suffix:B"), "set_max_sync_bytes_per_frame", "get_max_sync_bytes_per_frame");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "interest_radius", PROPERTY_HINT_RANGE, "0.01,1000,0.01,or_greater"), "set_interest_radius", "get_interest_radius");
 
 	ADD_PROPERTY_DEFAULT("refuse_new_connections", false);
 
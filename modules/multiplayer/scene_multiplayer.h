@@ -195,6 +195,19 @@ public:
 	void set_server_relay_enabled(bool p_enabled);
 	bool is_server_relay_enabled() const;
 
+	void set_rpc_batching_enabled(bool p_enabled);
+	bool is_rpc_batching_enabled() const;
+
+	void set_interest_observer(int p_peer, Node *p_node);
+	Node *get_interest_observer(int p_peer) const;
+	void set_interest_radius(double p_radius);
+	double get_interest_radius() const;
+
+	void set_max_sync_packet_size(int p_size);
+	int get_max_sync_packet_size() const;
+	void set_max_sync_bytes_per_frame(int p_bytes);
+	int get_max_sync_bytes_per_frame() const;
+
 	Ref<SceneCacheInterface> get_path_cache() { return cache; }
 	Ref<SceneReplicationInterface> get_replicator() { return replicator; }
 
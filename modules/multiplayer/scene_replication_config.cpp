@@ -53,18 +53,21 @@ bool SceneReplicationConfig::_set(const StringName &p_name, const Variant &p_val
 		if (what == "sync") {
 			prop.sync = p_value;
 			if (prop.sync) {
-				sync_props.push_back(prop.name);
-			} else {
-				sync_props.erase(prop.name);
+				prop.watch = false;
 			}
+			_update();
 			return true;
 		} else if (what == "spawn") {
 			prop.spawn = p_value;
-			if (prop.spawn) {
-				spawn_props.push_back(prop.name);
-			} else {
-				spawn_props.erase(prop.name);
+			_update();
+			return true;
+		} else if (what == "watch") {
+			ERR_FAIL_COND_V_MSG(!prop.watch && p_value && watch_props.size() >= MAX_WATCHED_PROPERTIES, false, vformat("Can't watch more than %d properties.", MAX_WATCHED_PROPERTIES));
+			prop.watch = p_value;
+			if (prop.watch) {
+				prop.sync = false;
 			}
+			_update();
 			return true;
 		}
 	}
@@ -88,6 +91,9 @@ bool SceneReplicationConfig::_get(const StringName &p_name, Variant &r_ret) cons
 		} else if (what == "spawn") {
 			r_ret = prop.spawn;
 			return true;
+		} else if (what == "watch") {
+			r_ret = prop.watch;
+			return true;
 		}
 	}
 	return false;
@@ -98,6 +104,7 @@ void SceneReplicationConfig::_get_property_list(List<PropertyInfo> *p_list) cons
 		p_list->push_back(PropertyInfo(Variant::STRING, "properties/" + itos(i) + "/path", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::STRING, "properties/" + itos(i) + "/spawn", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::STRING, "properties/" + itos(i) + "/sync", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		p_list->push_back(PropertyInfo(Variant::STRING, "properties/" + itos(i) + "/watch", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
 	}
 }
 
@@ -128,20 +135,12 @@ void SceneReplicationConfig::add_property(const NodePath &p_path, int p_index) {
 		c++;
 	}
 	properties.insert_before(I, ReplicationProperty(p_path));
-	sync_props.clear();
-	spawn_props.clear();
-	for (const ReplicationProperty &prop : properties) {
-		if (prop.sync) {
-			sync_props.push_back(p_path);
-		}
-		if (prop.spawn) {
-			spawn_props.push_back(p_path);
-		}
-	}
+	_update();
 }
 
 void SceneReplicationConfig::remove_property(const NodePath &p_path) {
 	properties.erase(p_path);
+	_update();
 }
 
 bool SceneReplicationConfig::has_property(const NodePath &p_path) const {
@@ -175,12 +174,7 @@ void SceneReplicationConfig::property_set_spawn(const NodePath &p_path, bool p_e
 		return;
 	}
 	E->get().spawn = p_enabled;
-	spawn_props.clear();
-	for (const ReplicationProperty &prop : properties) {
-		if (prop.spawn) {
-			spawn_props.push_back(p_path);
-		}
-	}
+	_update();
 }
 
 bool SceneReplicationConfig::property_get_sync(const NodePath &p_path) {
@@ -196,10 +190,45 @@ void SceneReplicationConfig::property_set_sync(const NodePath &p_path, bool p_en
 		return;
 	}
 	E->get().sync = p_enabled;
+	if (p_enabled) {
+		E->get().watch = false;
+	}
+	_update();
+}
+
+bool SceneReplicationConfig::property_get_watch(const NodePath &p_path) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND_V(!E, false);
+	return E->get().watch;
+}
+
+void SceneReplicationConfig::property_set_watch(const NodePath &p_path, bool p_enabled) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND(!E);
+	if (E->get().watch == p_enabled) {
+		return;
+	}
+	ERR_FAIL_COND_MSG(p_enabled && watch_props.size() >= MAX_WATCHED_PROPERTIES, vformat("Can't watch more than %d properties.", MAX_WATCHED_PROPERTIES));
+	E->get().watch = p_enabled;
+	if (p_enabled) {
+		// Watched properties are sent as reliable deltas instead of being part of the unreliable sync state.
+		E->get().sync = false;
+	}
+	_update();
+}
+
+void SceneReplicationConfig::_update() {
+	spawn_props.clear();
 	sync_props.clear();
+	watch_props.clear();
 	for (const ReplicationProperty &prop : properties) {
+		if (prop.spawn) {
+			spawn_props.push_back(prop.name);
+		}
 		if (prop.sync) {
-			sync_props.push_back(p_path);
+			sync_props.push_back(prop.name);
+		} else if (prop.watch) {
+			watch_props.push_back(prop.name);
 		}
 	}
 }
@@ -214,4 +243,6 @@ void SceneReplicationConfig::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("property_set_spawn", "path", "enabled"), &SceneReplicationConfig::property_set_spawn);
 	ClassDB::bind_method(D_METHOD("property_get_sync", "path"), &SceneReplicationConfig::property_get_sync);
 	ClassDB::bind_method(D_METHOD("property_set_sync", "path", "enabled"), &SceneReplicationConfig::property_set_sync);
+	ClassDB::bind_method(D_METHOD("property_get_watch", "path"), &SceneReplicationConfig::property_get_watch);
+	ClassDB::bind_method(D_METHOD("property_set_watch", "path", "enabled"), &SceneReplicationConfig::property_set_watch);
 }
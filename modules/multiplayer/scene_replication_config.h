@@ -40,11 +40,16 @@ class SceneReplicationConfig : public Resource {
 	OBJ_SAVE_TYPE(SceneReplicationConfig);
 	RES_BASE_EXTENSION("repl");
 
+public:
+	// The changed watched properties are sent as a 64-bit mask.
+	static const int MAX_WATCHED_PROPERTIES = 64;
+
 private:
 	struct ReplicationProperty {
 		NodePath name;
 		bool spawn = true;
 		bool sync = true;
+		bool watch = false;
 
 		bool operator==(const ReplicationProperty &p_to) {
 			return name == p_to.name;
@@ -60,6 +65,9 @@ private:
 	List<ReplicationProperty> properties;
 	List<NodePath> spawn_props;
 	List<NodePath> sync_props;
+	List<NodePath> watch_props;
+
+	void _update();
 
 protected:
 	static void _bind_methods();
@@ -82,8 +90,12 @@ public:
 	bool property_get_sync(const NodePath &p_path);
 	void property_set_sync(const NodePath &p_path, bool p_enabled);
 
+	bool property_get_watch(const NodePath &p_path);
+	void property_set_watch(const NodePath &p_path, bool p_enabled);
+
 	const List<NodePath> &get_spawn_properties() { return spawn_props; }
 	const List<NodePath> &get_sync_properties() { return sync_props; }
+	const List<NodePath> &get_watch_properties() { return watch_props; }
 
 	SceneReplicationConfig() {}
 };
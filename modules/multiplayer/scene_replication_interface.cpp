@@ -34,9 +34,14 @@
 
 #include "core/debugger/engine_debugger.h"
 #include "core/io/marshalls.h"
+#include "scene/2d/node_2d.h"
 #include "scene/main/node.h"
 #include "scene/scene_string_names.h"
 
+#ifndef _3D_DISABLED
+#include "scene/3d/node_3d.h"
+#endif
+
 #define MAKE_ROOM(m_amount)             \
 	if (packet_cache.size() < m_amount) \
 		packet_cache.resize(m_amount);
@@ -121,6 +126,7 @@ void SceneReplicationInterface::on_reset() {
 		ERR_CONTINUE(!sync);
 		sync->reset();
 	}
+	interest_grid.clear();
 	last_net_id = 0;
 }
 
@@ -138,15 +144,19 @@ void SceneReplicationInterface::on_network_process() {
 		spawn_queue.clear();
 	}
 
-	// Process timed syncs.
-	uint64_t msec = OS::get_singleton()->get_ticks_msec();
+	_update_interest();
+
+	// Process timed syncs and watched property deltas.
+	uint64_t usec = OS::get_singleton()->get_ticks_usec();
+	uint64_t msec = usec / 1000;
 	for (KeyValue<int, PeerInfo> &E : peers_info) {
 		const HashSet<ObjectID> to_sync = E.value.sync_nodes;
 		if (to_sync.is_empty()) {
 			continue; // Nothing to sync
 		}
 		uint16_t sync_net_time = ++E.value.last_sent_sync;
-		_send_sync(E.key, to_sync, sync_net_time, msec);
+		_send_sync(E.key, to_sync, sync_net_time, msec, E.value.sync_priorities);
+		_send_delta(E.key, to_sync, usec, E.value.last_watch_usecs);
 	}
 }
 
@@ -232,6 +242,9 @@ Error SceneReplicationInterface::on_replication_start(Object *p_obj, Variant p_c
 	const ObjectID sid = sync->get_instance_id();
 	tobj.synchronizers.insert(sid);
 	sync_nodes.insert(sid);
+	if (sync->is_spatial_interest_enabled()) {
+		interest_syncs.insert(sid);
+	}
 
 	// Update visibility.
 	sync->connect("visibility_changed", callable_mp(this, &SceneReplicationInterface::_visibility_changed).bind(sync->get_instance_id()));
@@ -278,8 +291,13 @@ Error SceneReplicationInterface::on_replication_stop(Object *p_obj, Variant p_co
 	TrackedNode &tobj = _track(oid);
 	tobj.synchronizers.erase(sid);
 	sync_nodes.erase(sid);
+	interest_syncs.erase(sid);
+	interest_grid.remove(sid);
 	for (KeyValue<int, PeerInfo> &E : peers_info) {
 		E.value.sync_nodes.erase(sid);
+		E.value.sync_priorities.erase(sid);
+		E.value.last_watch_usecs.erase(sid);
+		E.value.interest_relevance.erase(sid);
 		if (sync->get_net_id()) {
 			E.value.recv_sync_ids.erase(sync->get_net_id());
 		}
@@ -299,6 +317,139 @@ void SceneReplicationInterface::_visibility_changed(int p_peer, ObjectID p_sid)
 	_update_sync_visibility(p_peer, sync);
 }
 
+bool SceneReplicationInterface::_get_interest_position(Node *p_node, Vector3 &r_position) {
+	if (!p_node || !p_node->is_inside_tree()) {
+		return false;
+	}
+	if (Node2D *node_2d = Object::cast_to<Node2D>(p_node)) {
+		const Vector2 pos = node_2d->get_global_position();
+		r_position = Vector3(pos.x, pos.y, 0);
+		return true;
+	}
+#ifndef _3D_DISABLED
+	if (Node3D *node_3d = Object::cast_to<Node3D>(p_node)) {
+		r_position = node_3d->get_global_position();
+		return true;
+	}
+#endif
+	return false;
+}
+
+bool SceneReplicationInterface::_is_relevant_to(const MultiplayerSynchronizer *p_sync, int p_peer) const {
+	if (p_peer <= 0 || !p_sync->is_spatial_interest_enabled()) {
+		return true;
+	}
+	const PeerInfo *info = peers_info.getptr(p_peer);
+	if (!info || info->interest_observer.is_null()) {
+		return true; // Peers without an observer are not interest managed.
+	}
+	return info->interest_relevance.has(p_sync->get_instance_id());
+}
+
+void SceneReplicationInterface::_update_interest() {
+	if (interest_syncs.is_empty()) {
+		return;
+	}
+	// Move the authority spatial synchronizers in the grid.
+	for (const ObjectID &sid : interest_syncs) {
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(sid);
+		Node *root = sync && sync->is_multiplayer_authority() ? sync->get_root_node() : nullptr;
+		Vector3 position;
+		if (_get_interest_position(root, position)) {
+			interest_grid.update(sid, position);
+		} else {
+			interest_grid.remove(sid);
+		}
+	}
+	// Query the grid around each peer observer, and update visibility for synchronizers entering or leaving it.
+	HashMap<ObjectID, real_t> relevance;
+	LocalVector<ObjectID> changed;
+	for (KeyValue<int, PeerInfo> &E : peers_info) {
+		PeerInfo &info = E.value;
+		if (info.interest_observer.is_null()) {
+			continue;
+		}
+		// When the observer is freed or leaves the tree, nothing is relevant until a new one is assigned.
+		Vector3 origin;
+		if (_get_interest_position(get_id_as<Node>(info.interest_observer), origin)) {
+			interest_grid.query(origin, interest_radius, interest_radius * INTEREST_LEAVE_RADIUS_RATIO, info.interest_relevance, relevance);
+		} else {
+			relevance.clear();
+		}
+		changed.clear();
+		for (const KeyValue<ObjectID, real_t> &R : relevance) {
+			if (!info.interest_relevance.has(R.key)) {
+				changed.push_back(R.key);
+			}
+		}
+		for (const KeyValue<ObjectID, real_t> &R : info.interest_relevance) {
+			if (!relevance.has(R.key)) {
+				changed.push_back(R.key);
+			}
+		}
+		info.interest_relevance = relevance;
+		for (const ObjectID &sid : changed) {
+			MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(sid);
+			if (sync && sync->is_multiplayer_authority() && sync->get_root_node()) {
+				_visibility_changed(E.key, sid);
+			}
+		}
+	}
+}
+
+void SceneReplicationInterface::set_interest_observer(int p_peer, Node *p_node) {
+	ERR_FAIL_COND(!peers_info.has(p_peer));
+	PeerInfo &info = peers_info[p_peer];
+	const ObjectID oid = p_node ? p_node->get_instance_id() : ObjectID();
+	if (info.interest_observer == oid) {
+		return;
+	}
+	info.interest_observer = oid;
+	info.interest_relevance.clear();
+	// Re-evaluate spatial synchronizers, the next grid query will add back the relevant ones.
+	for (const ObjectID &sid : interest_syncs) {
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(sid);
+		if (sync && sync->is_multiplayer_authority() && sync->get_root_node()) {
+			_visibility_changed(p_peer, sid);
+		}
+	}
+}
+
+Node *SceneReplicationInterface::get_interest_observer(int p_peer) const {
+	const PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_COND_V(!info, nullptr);
+	return get_id_as<Node>(info->interest_observer);
+}
+
+void SceneReplicationInterface::set_interest_radius(real_t p_radius) {
+	ERR_FAIL_COND_MSG(p_radius <= 0, "Interest radius must be greater than 0.");
+	interest_radius = p_radius;
+	// Cells as big as the radius keep each query within 3x3(x3) cells.
+	interest_grid.set_cell_size(p_radius);
+}
+
+real_t SceneReplicationInterface::get_interest_radius() const {
+	return interest_radius;
+}
+
+void SceneReplicationInterface::set_max_sync_packet_size(int p_size) {
+	ERR_FAIL_COND_MSG(p_size < 128, "Sync maximum packet size must be at least 128 bytes.");
+	sync_mtu = p_size;
+}
+
+int SceneReplicationInterface::get_max_sync_packet_size() const {
+	return sync_mtu;
+}
+
+void SceneReplicationInterface::set_max_sync_bytes_per_frame(int p_bytes) {
+	ERR_FAIL_COND_MSG(p_bytes < 0, "Sync budget must be greater or equal to 0 (where 0 means unlimited).");
+	sync_budget = p_bytes;
+}
+
+int SceneReplicationInterface::get_max_sync_bytes_per_frame() const {
+	return sync_budget;
+}
+
 bool SceneReplicationInterface::is_rpc_visible(const ObjectID &p_oid, int p_peer) const {
 	if (!tracked_nodes.has(p_oid)) {
 		return true; // Untracked nodes are always visible to RPCs.
@@ -330,7 +481,7 @@ bool SceneReplicationInterface::is_rpc_visible(const ObjectID &p_oid, int p_peer
 			// RPC visibility is composed using OR when multiple synchronizers are present.
 			// Note that we don't really care about authority here which may lead to unexpected
 			// results when using multiple synchronizers to control the same node.
-			if (sync->is_visible_to(p_peer)) {
+			if (sync->is_visible_to(p_peer) && _is_relevant_to(sync, p_peer)) {
 				return true;
 			}
 		}
@@ -349,7 +500,7 @@ Error SceneReplicationInterface::_update_sync_visibility(int p_peer, Multiplayer
 	if (p_peer == 0) {
 		for (KeyValue<int, PeerInfo> &E : peers_info) {
 			// Might be visible to this specific peer.
-			bool is_visible_to_peer = is_visible || p_sync->is_visible_to(E.key);
+			bool is_visible_to_peer = (is_visible || p_sync->is_visible_to(E.key)) && _is_relevant_to(p_sync, E.key);
 			if (is_visible_to_peer == E.value.sync_nodes.has(sid)) {
 				continue;
 			}
@@ -357,11 +508,14 @@ Error SceneReplicationInterface::_update_sync_visibility(int p_peer, Multiplayer
 				E.value.sync_nodes.insert(sid);
 			} else {
 				E.value.sync_nodes.erase(sid);
+				E.value.sync_priorities.erase(sid);
+				E.value.last_watch_usecs.erase(sid);
 			}
 		}
 		return OK;
 	} else {
 		ERR_FAIL_COND_V(!peers_info.has(p_peer), ERR_INVALID_PARAMETER);
+		is_visible = is_visible && _is_relevant_to(p_sync, p_peer);
 		if (is_visible == peers_info[p_peer].sync_nodes.has(sid)) {
 			return OK;
 		}
@@ -369,6 +523,8 @@ Error SceneReplicationInterface::_update_sync_visibility(int p_peer, Multiplayer
 			peers_info[p_peer].sync_nodes.insert(sid);
 		} else {
 			peers_info[p_peer].sync_nodes.erase(sid);
+			peers_info[p_peer].sync_priorities.erase(sid);
+			peers_info[p_peer].last_watch_usecs.erase(sid);
 		}
 		return OK;
 	}
@@ -383,14 +539,16 @@ Error SceneReplicationInterface::_update_spawn_visibility(int p_peer, const Obje
 	ERR_FAIL_COND_V(!tracked_nodes.has(p_oid), ERR_BUG);
 	const HashSet<ObjectID> synchronizers = tracked_nodes[p_oid].synchronizers;
 	bool is_visible = true;
+	bool is_spatial = false;
 	for (const ObjectID &sid : synchronizers) {
 		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(sid);
 		ERR_CONTINUE(!sync);
 		if (!sync->is_multiplayer_authority()) {
 			continue;
 		}
+		is_spatial = is_spatial || sync->is_spatial_interest_enabled();
 		// Spawn visibility is composed using OR when multiple synchronizers are present.
-		if (sync->is_visible_to(p_peer)) {
+		if (sync->is_visible_to(p_peer) && _is_relevant_to(sync, p_peer)) {
 			is_visible = true;
 			break;
 		}
@@ -412,7 +570,7 @@ Error SceneReplicationInterface::_update_spawn_visibility(int p_peer, const Obje
 	} else {
 		// Check visibility for each peers.
 		for (const KeyValue<int, PeerInfo> &E : peers_info) {
-			if (is_visible) {
+			if (is_visible && !is_spatial) {
 				// This is fast, since the the object is visible to everyone, we don't need to check each peer.
 				if (E.value.spawn_nodes.has(p_oid)) {
 					// Already spawned.
@@ -670,51 +828,114 @@ Error SceneReplicationInterface::on_despawn_receive(int p_from, const uint8_t *p
 	return OK;
 }
 
-void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> p_synchronizers, uint16_t p_sync_net_time, uint64_t p_msec) {
+bool SceneReplicationInterface::_verify_synchronizer(int p_peer, MultiplayerSynchronizer *p_sync, uint32_t &r_net_id) {
+	r_net_id = p_sync->get_net_id();
+	if (r_net_id == 0 || (r_net_id & 0x80000000)) {
+		int path_id = 0;
+		bool verified = multiplayer->get_path_cache()->send_object_cache(p_sync, p_peer, path_id);
+		ERR_FAIL_COND_V_MSG(path_id < 0, false, "This should never happen!");
+		if (r_net_id == 0) {
+			// First time path based ID.
+			r_net_id = path_id | 0x80000000;
+			p_sync->set_net_id(r_net_id | 0x80000000);
+		}
+		return verified;
+	}
+	return true;
+}
+
+MultiplayerSynchronizer *SceneReplicationInterface::_find_synchronizer(int p_peer, uint32_t p_net_id) {
+	MultiplayerSynchronizer *sync = nullptr;
+	if (p_net_id & 0x80000000) {
+		sync = Object::cast_to<MultiplayerSynchronizer>(multiplayer->get_path_cache()->get_cached_object(p_peer, p_net_id & 0x7FFFFFFF));
+	} else if (peers_info[p_peer].recv_sync_ids.has(p_net_id)) {
+		const ObjectID &sid = peers_info[p_peer].recv_sync_ids[p_net_id];
+		sync = get_id_as<MultiplayerSynchronizer>(sid);
+	}
+	return sync;
+}
+
+void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> p_synchronizers, uint16_t p_sync_net_time, uint64_t p_msec, HashMap<ObjectID, real_t> &r_sync_priorities) {
+	const PeerInfo *info = peers_info.getptr(p_peer);
+	const HashMap<ObjectID, real_t> *relevance = info && info->interest_observer.is_valid() ? &info->interest_relevance : nullptr;
+	// Accumulate the priority of the synchronizers waiting to be sent, the ones left out by the budget keep growing until they make it.
+	for (const ObjectID &oid : p_synchronizers) {
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(oid);
+		ERR_CONTINUE(!sync || !sync->get_replication_config().is_valid() || !sync->is_multiplayer_authority());
+		real_t *priority = r_sync_priorities.getptr(oid);
+		const real_t *rel = relevance ? relevance->getptr(oid) : nullptr;
+		if (!priority) {
+			if (!sync->update_outbound_sync_time(p_msec)) {
+				continue; // nothing to sync.
+			}
+			if (rel) {
+				// Far away spatial synchronizers are synced less often, staggered by object to spread the load.
+				const uint16_t divisor = *rel > 0.5 ? 1 : (*rel > 0.25 ? 2 : 4);
+				if ((p_sync_net_time + uint64_t(oid)) % divisor) {
+					continue;
+				}
+			}
+			priority = &r_sync_priorities.insert(oid, 0)->value;
+		}
+		*priority += sync->get_replication_priority() * (rel ? 0.25 + *rel : 1.0);
+	}
+	if (r_sync_priorities.is_empty()) {
+		return;
+	}
+
+	LocalVector<SyncCandidate> candidates;
+	candidates.reserve(r_sync_priorities.size());
+	for (const KeyValue<ObjectID, real_t> &E : r_sync_priorities) {
+		candidates.push_back(SyncCandidate(E.key, E.value));
+	}
+	candidates.sort();
+
 	MAKE_ROOM(sync_mtu);
 	uint8_t *ptr = packet_cache.ptrw();
 	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC;
 	int ofs = 1;
 	ofs += encode_uint16(p_sync_net_time, &ptr[1]);
+	int sent = 0;
+	bool sent_any = false;
 	// Can only send updates for already notified nodes.
 	// This is a lazy implementation, we could optimize much more here with by grouping by replication config.
-	for (const ObjectID &oid : p_synchronizers) {
+	for (const SyncCandidate &candidate : candidates) {
+		const ObjectID &oid = candidate.id;
 		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(oid);
-		ERR_CONTINUE(!sync || !sync->get_replication_config().is_valid() || !sync->is_multiplayer_authority());
-		if (!sync->update_outbound_sync_time(p_msec)) {
-			continue; // nothing to sync.
+		Node *node = sync ? sync->get_root_node() : nullptr;
+		if (!node) {
+			r_sync_priorities.erase(oid);
+			ERR_CONTINUE(true);
 		}
-
-		Node *node = sync->get_root_node();
-		ERR_CONTINUE(!node);
-		uint32_t net_id = sync->get_net_id();
-		if (net_id == 0 || (net_id & 0x80000000)) {
-			int path_id = 0;
-			bool verified = multiplayer->get_path_cache()->send_object_cache(sync, p_peer, path_id);
-			ERR_CONTINUE_MSG(path_id < 0, "This should never happen!");
-			if (net_id == 0) {
-				// First time path based ID.
-				net_id = path_id | 0x80000000;
-				sync->set_net_id(net_id | 0x80000000);
-			}
-			if (!verified) {
-				// The path based sync is not yet confirmed, skipping.
-				continue;
-			}
+		uint32_t net_id = 0;
+		if (!_verify_synchronizer(p_peer, sync, net_id)) {
+			// The path based sync is not yet confirmed, skipping.
+			r_sync_priorities.erase(oid);
+			continue;
 		}
 		int size;
 		Vector<Variant> vars;
 		Vector<const Variant *> varp;
 		const List<NodePath> props = sync->get_replication_config()->get_sync_properties();
 		Error err = MultiplayerSynchronizer::get_state(props, node, vars, varp);
-		ERR_CONTINUE_MSG(err != OK, "Unable to retrieve sync state.");
-		err = MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), nullptr, size);
-		ERR_CONTINUE_MSG(err != OK, "Unable to encode sync state.");
+		if (err == OK) {
+			err = MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), nullptr, size);
+		}
+		if (err != OK) {
+			r_sync_priorities.erase(oid);
+			ERR_CONTINUE_MSG(true, "Unable to retrieve or encode sync state.");
+		}
+		// At least one state always goes through, even when bigger than the budget.
+		if (sync_budget > 0 && sent_any && sent + ofs + 4 + 4 + size > sync_budget) {
+			break; // Out of budget for this frame, the remaining synchronizers will have a higher priority next frame.
+		}
+		r_sync_priorities.erase(oid);
 		// TODO Handle single state above MTU.
 		ERR_CONTINUE_MSG(size > 3 + 4 + 4 + sync_mtu, vformat("Node states bigger then MTU will not be sent (%d > %d): %s", size, sync_mtu, node->get_path()));
 		if (ofs + 4 + 4 + size > sync_mtu) {
 			// Send what we got, and reset write.
 			_send_raw(packet_cache.ptr(), ofs, p_peer, false);
+			sent += ofs;
 			ofs = 3;
 		}
 		if (size) {
@@ -723,6 +944,7 @@ void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> p
 			MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), &ptr[ofs], size);
 			ofs += size;
 		}
+		sent_any = true;
 #ifdef DEBUG_ENABLED
 		_profile_node_data("sync_out", oid, size);
 #endif
@@ -743,13 +965,7 @@ Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_bu
 		uint32_t size = decode_uint32(&p_buffer[ofs]);
 		ofs += 4;
 		ERR_FAIL_COND_V(size > uint32_t(p_buffer_len - ofs), ERR_INVALID_DATA);
-		MultiplayerSynchronizer *sync = nullptr;
-		if (net_id & 0x80000000) {
-			sync = Object::cast_to<MultiplayerSynchronizer>(multiplayer->get_path_cache()->get_cached_object(p_from, net_id & 0x7FFFFFFF));
-		} else if (peers_info[p_from].recv_sync_ids.has(net_id)) {
-			const ObjectID &sid = peers_info[p_from].recv_sync_ids[net_id];
-			sync = get_id_as<MultiplayerSynchronizer>(sid);
-		}
+		MultiplayerSynchronizer *sync = _find_synchronizer(p_from, net_id);
 		if (!sync) {
 			// Not received yet.
 			ofs += size;
@@ -782,3 +998,91 @@ Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_bu
 	}
 	return OK;
 }
+
+void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID> p_synchronizers, uint64_t p_usec, HashMap<ObjectID, uint64_t> &r_last_watch_usecs) {
+	MAKE_ROOM(sync_mtu);
+	packet_cache.write[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT);
+	int ofs = 1;
+	Vector<const Variant *> varp;
+	for (const ObjectID &oid : p_synchronizers) {
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(oid);
+		ERR_CONTINUE(!sync || !sync->get_replication_config().is_valid() || !sync->is_multiplayer_authority());
+		if (sync->get_replication_config()->get_watch_properties().is_empty()) {
+			continue; // Nothing to watch.
+		}
+		uint64_t *last_usec = r_last_watch_usecs.getptr(oid);
+		uint64_t indexes = sync->get_delta_state(p_usec, last_usec ? *last_usec : 0, varp);
+		if (indexes == 0) {
+			continue; // Peer is up to date.
+		}
+		uint32_t net_id = 0;
+		if (!_verify_synchronizer(p_peer, sync, net_id)) {
+			// The path based sync is not yet confirmed, skipping.
+			continue;
+		}
+		int size = 0;
+		Error err = MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), nullptr, size);
+		ERR_CONTINUE_MSG(err != OK, "Unable to encode delta state.");
+		// Dirty masks are sent as varints, so only the highest changed index costs bytes.
+		int mask_size = encode_varuint(indexes, nullptr);
+		int block_size = 4 + 4 + mask_size + size;
+		if (ofs > 1 && ofs + block_size > sync_mtu) {
+			// Send what we got, and reset write.
+			_send_raw(packet_cache.ptr(), ofs, p_peer, true);
+			ofs = 1;
+		}
+		// Deltas are reliable, states bigger than the MTU are sent alone and fragmented by the peer.
+		MAKE_ROOM(ofs + block_size);
+		uint8_t *ptr = packet_cache.ptrw();
+		ofs += encode_uint32(sync->get_net_id(), &ptr[ofs]);
+		ofs += encode_uint32(mask_size + size, &ptr[ofs]);
+		ofs += encode_varuint(indexes, &ptr[ofs]);
+		MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), &ptr[ofs], size);
+		ofs += size;
+		// The reliable channel acts as acknowledgement, the peer baseline moves forward as soon as the delta is queued.
+		r_last_watch_usecs[oid] = p_usec;
+#ifdef DEBUG_ENABLED
+		_profile_node_data("delta_out", oid, block_size);
+#endif
+	}
+	if (ofs > 1) {
+		// Got some left over to send.
+		_send_raw(packet_cache.ptr(), ofs, p_peer, true);
+	}
+}
+
+Error SceneReplicationInterface::on_delta_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
+	ERR_FAIL_COND_V_MSG(p_buffer_len < 10, ERR_INVALID_DATA, "Invalid delta packet received");
+	int ofs = 1;
+	while (ofs + 8 < p_buffer_len) {
+		uint32_t net_id = decode_uint32(&p_buffer[ofs]);
+		ofs += 4;
+		uint32_t size = decode_uint32(&p_buffer[ofs]);
+		ofs += 4;
+		ERR_FAIL_COND_V(size > uint32_t(p_buffer_len - ofs), ERR_INVALID_DATA);
+		MultiplayerSynchronizer *sync = _find_synchronizer(p_from, net_id);
+		Node *node = sync ? sync->get_root_node() : nullptr;
+		if (!sync || sync->get_multiplayer_authority() != p_from || !node) {
+			ofs += size;
+			ERR_CONTINUE_MSG(true, "Ignoring delta data from non-authority or for missing node.");
+		}
+		int mask_size = 0;
+		uint64_t indexes = 0;
+		ERR_FAIL_COND_V(!decode_varuint(&p_buffer[ofs], size, mask_size, indexes), ERR_INVALID_DATA);
+		const List<NodePath> props = sync->get_delta_properties(indexes);
+		ERR_FAIL_COND_V(props.is_empty(), ERR_INVALID_DATA);
+		Vector<Variant> vars;
+		vars.resize(props.size());
+		int consumed = 0;
+		Error err = MultiplayerAPI::decode_and_decompress_variants(vars, &p_buffer[ofs + mask_size], size - mask_size, consumed);
+		ERR_FAIL_COND_V(err, err);
+		err = MultiplayerSynchronizer::set_state(props, node, vars);
+		ERR_FAIL_COND_V(err, err);
+		ofs += size;
+		sync->emit_signal(SNAME("delta_synchronized"));
+#ifdef DEBUG_ENABLED
+		_profile_node_data("delta_in", sync->get_instance_id(), size);
+#endif
+	}
+	return OK;
+}
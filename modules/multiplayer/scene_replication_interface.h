@@ -35,6 +35,7 @@
 
 #include "multiplayer_spawner.h"
 #include "multiplayer_synchronizer.h"
+#include "scene_interest_grid.h"
 
 class SceneMultiplayer;
 
@@ -64,9 +65,27 @@ private:
 		HashSet<ObjectID> spawn_nodes;
 		HashMap<uint32_t, ObjectID> recv_sync_ids;
 		HashMap<uint32_t, ObjectID> recv_nodes;
+		HashMap<ObjectID, real_t> sync_priorities; // Synchronizers waiting to be sent, with their accumulated priority.
+		HashMap<ObjectID, uint64_t> last_watch_usecs; // Delta baseline, the last watched state the peer received.
+		ObjectID interest_observer;
+		HashMap<ObjectID, real_t> interest_relevance; // Spatial synchronizers near the observer.
 		uint16_t last_sent_sync = 0;
 	};
 
+	struct SyncCandidate {
+		ObjectID id;
+		real_t priority = 0;
+
+		// Highest priority first.
+		bool operator<(const SyncCandidate &p_other) const { return priority > p_other.priority; }
+
+		SyncCandidate() {}
+		SyncCandidate(const ObjectID &p_id, real_t p_priority) {
+			id = p_id;
+			priority = p_priority;
+		}
+	};
+
 	// Replication state.
 	HashMap<int, PeerInfo> peers_info;
 	uint32_t last_net_id = 0;
@@ -74,6 +93,13 @@ private:
 	HashSet<ObjectID> spawned_nodes;
 	HashSet<ObjectID> sync_nodes;
 
+	// Spatial interest management. Synchronizers leave the interest of a peer a bit farther than they enter it,
+	// so the ones moving along the radius aren't despawned and spawned again every frame.
+	static constexpr real_t INTEREST_LEAVE_RADIUS_RATIO = 1.1;
+	SceneInterestGrid interest_grid;
+	HashSet<ObjectID> interest_syncs;
+	real_t interest_radius = 100;
+
 	// Pending local spawn information (handles spawning nested nodes during ready).
 	HashSet<ObjectID> spawn_queue;
 
@@ -88,12 +114,17 @@ private:
 	SceneMultiplayer *multiplayer = nullptr;
 	PackedByteArray packet_cache;
 	int sync_mtu = 1350; // Highly dependent on underlying protocol.
+	int sync_budget = 0; // Bytes of sync state per peer per network frame, 0 means unlimited.
 
 	TrackedNode &_track(const ObjectID &p_id);
 	void _untrack(const ObjectID &p_id);
 	void _node_ready(const ObjectID &p_oid);
 
-	void _send_sync(int p_peer, const HashSet<ObjectID> p_synchronizers, uint16_t p_sync_net_time, uint64_t p_msec);
+	bool _verify_synchronizer(int p_peer, MultiplayerSynchronizer *p_sync, uint32_t &r_net_id);
+	MultiplayerSynchronizer *_find_synchronizer(int p_peer, uint32_t p_net_id);
+
+	void _send_sync(int p_peer, const HashSet<ObjectID> p_synchronizers, uint16_t p_sync_net_time, uint64_t p_msec, HashMap<ObjectID, real_t> &r_sync_priorities);
+	void _send_delta(int p_peer, const HashSet<ObjectID> p_synchronizers, uint64_t p_usec, HashMap<ObjectID, uint64_t> &r_last_watch_usecs);
 	Error _make_spawn_packet(Node *p_node, MultiplayerSpawner *p_spawner, int &r_len);
 	Error _make_despawn_packet(Node *p_node, int &r_len);
 	Error _send_raw(const uint8_t *p_buffer, int p_size, int p_peer, bool p_reliable);
@@ -102,6 +133,9 @@ private:
 	Error _update_sync_visibility(int p_peer, MultiplayerSynchronizer *p_sync);
 	Error _update_spawn_visibility(int p_peer, const ObjectID &p_oid);
 	void _free_remotes(const PeerInfo &p_info);
+	void _update_interest();
+	static bool _get_interest_position(Node *p_node, Vector3 &r_position);
+	bool _is_relevant_to(const MultiplayerSynchronizer *p_sync, int p_peer) const;
 
 	template <class T>
 	static T *get_id_as(const ObjectID &p_id) {
@@ -127,9 +161,20 @@ public:
 	Error on_spawn_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
 	Error on_despawn_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
 	Error on_sync_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
+	Error on_delta_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
 
 	bool is_rpc_visible(const ObjectID &p_oid, int p_peer) const;
 
+	void set_interest_observer(int p_peer, Node *p_node);
+	Node *get_interest_observer(int p_peer) const;
+	void set_interest_radius(real_t p_radius);
+	real_t get_interest_radius() const;
+
+	void set_max_sync_packet_size(int p_size);
+	int get_max_sync_packet_size() const;
+	void set_max_sync_bytes_per_frame(int p_bytes);
+	int get_max_sync_bytes_per_frame() const;
+
 	SceneReplicationInterface(SceneMultiplayer *p_multiplayer) {
 		multiplayer = p_multiplayer;
 	}
@@ -51,6 +51,10 @@
 #define NAME_ID_COMPRESSION_FLAG (1 << NAME_ID_COMPRESSION_SHIFT)
 #define BYTE_ONLY_OR_NO_ARGS_FLAG (1 << BYTE_ONLY_OR_NO_ARGS_SHIFT)
 
+// Node ID compression 3 is never used by a single RPC, it marks a batch of RPCs instead.
+// A batch is the meta byte followed by each RPC packet, prefixed by its length as a varint.
+#define BATCH_FLAG NODE_ID_COMPRESSION_FLAG
+
 #ifdef DEBUG_ENABLED
 _FORCE_INLINE_ void SceneRPCInterface::_profile_node_data(const String &p_what, ObjectID p_id, int p_size) {
 	if (EngineDebugger::is_profiling("multiplayer:rpc")) {
@@ -176,6 +180,10 @@ void SceneRPCInterface::process_rpc(int p_from, const uint8_t *p_packet, int p_p
 	int packet_min_size = 1;
 	int name_id_offset = 1;
 	ERR_FAIL_COND_MSG(p_packet_len < packet_min_size, "Invalid packet received. Size too small.");
+	if ((p_packet[0] & NODE_ID_COMPRESSION_FLAG) == BATCH_FLAG) {
+		_process_batch(p_from, p_packet, p_packet_len);
+		return;
+	}
 	// Compute the meta size, which depends on the compression level.
 	int node_id_compression = (p_packet[0] & NODE_ID_COMPRESSION_FLAG) >> NODE_ID_COMPRESSION_SHIFT;
 	int name_id_compression = (p_packet[0] & NAME_ID_COMPRESSION_FLAG) >> NAME_ID_COMPRESSION_SHIFT;
@@ -244,6 +252,23 @@ void SceneRPCInterface::process_rpc(int p_from, const uint8_t *p_packet, int p_p
 	_process_rpc(node, name_id, p_from, p_packet, packet_len, packet_min_size);
 }
 
+void SceneRPCInterface::_process_batch(int p_from, const uint8_t *p_packet, int p_packet_len) {
+	int ofs = 1;
+	while (ofs < p_packet_len) {
+		uint64_t len = 0;
+		int used = 0;
+		ERR_FAIL_COND_MSG(!decode_varuint(&p_packet[ofs], p_packet_len - ofs, used, len), "Invalid RPC batch received.");
+		ofs += used;
+		ERR_FAIL_COND_MSG(len == 0 || len > uint64_t(p_packet_len - ofs), "Invalid RPC batch received. Size smaller than declared.");
+		ERR_FAIL_COND_MSG((p_packet[ofs] & NODE_ID_COMPRESSION_FLAG) == BATCH_FLAG, "Invalid RPC batch received. Batches cannot be nested.");
+		process_rpc(p_from, &p_packet[ofs], len);
+		ofs += len;
+		if (multiplayer->get_multiplayer_peer().is_null()) {
+			return; // The RPC closed the connection.
+		}
+	}
+}
+
 void SceneRPCInterface::_process_rpc(Node *p_node, const uint16_t p_rpc_method_id, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset) {
 	ERR_FAIL_COND_MSG(p_offset > p_packet_len, "Invalid packet received. Size too small.");
 
@@ -295,6 +320,80 @@ void SceneRPCInterface::_process_rpc(Node *p_node, const uint16_t p_rpc_method_i
 	}
 }
 
+Error SceneRPCInterface::_send_command(int p_to, const RPCConfig &p_config, const uint8_t *p_packet, int p_packet_len) {
+	const int header_size = encode_varuint(p_packet_len, nullptr);
+	if (!batching || 1 + header_size + p_packet_len > batch_mtu) {
+		// Sending directly flushes the pending batches first (see SceneMultiplayer::send_command), so ordering is preserved.
+		Ref<MultiplayerPeer> peer = multiplayer->get_multiplayer_peer();
+		peer->set_transfer_channel(p_config.channel);
+		peer->set_transfer_mode(p_config.transfer_mode);
+		return multiplayer->send_command(p_to, p_packet, p_packet_len);
+	}
+	const BatchKey key(p_to, p_config.channel, p_config.transfer_mode);
+	LocalVector<uint8_t> *batch = batches.getptr(key);
+	if (batch && batch->size() + header_size + p_packet_len > uint32_t(batch_mtu)) {
+		flush_batches();
+		batch = nullptr;
+	}
+	if (!batch) {
+		batch = &batches.insert(key, LocalVector<uint8_t>())->value;
+		batch->push_back(SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL | BATCH_FLAG);
+	}
+	uint32_t ofs = batch->size();
+	batch->resize(ofs + header_size + p_packet_len);
+	ofs += encode_varuint(p_packet_len, batch->ptr() + ofs);
+	memcpy(batch->ptr() + ofs, p_packet, p_packet_len);
+	return OK;
+}
+
+void SceneRPCInterface::set_batching_enabled(bool p_enabled) {
+	if (!p_enabled) {
+		flush_batches();
+	}
+	batching = p_enabled;
+}
+
+bool SceneRPCInterface::is_batching_enabled() const {
+	return batching;
+}
+
+void SceneRPCInterface::flush_batches() {
+	if (flushing_batches || batches.is_empty()) {
+		return;
+	}
+	Ref<MultiplayerPeer> peer = multiplayer->get_multiplayer_peer();
+	if (peer.is_null()) {
+		batches.clear();
+		return;
+	}
+	flushing_batches = true;
+	// Restore the transfer settings when done, since this might happen while sending another command.
+	const int channel = peer->get_transfer_channel();
+	const MultiplayerPeer::TransferMode mode = peer->get_transfer_mode();
+	const HashSet<int> connected = multiplayer->get_connected_peers();
+	for (const KeyValue<BatchKey, LocalVector<uint8_t>> &E : batches) {
+		if (!connected.has(E.key.peer)) {
+			continue; // Disconnected since the RPCs were queued.
+		}
+		peer->set_transfer_channel(E.key.channel);
+		peer->set_transfer_mode(E.key.mode);
+		if (E.value[1] < 0x80 && E.value.size() == 2u + E.value[1]) {
+			// Just one small RPC, no need for the batch header.
+			multiplayer->send_command(E.key.peer, E.value.ptr() + 2, E.value.size() - 2);
+		} else {
+			multiplayer->send_command(E.key.peer, E.value.ptr(), E.value.size());
+		}
+	}
+	batches.clear();
+	peer->set_transfer_channel(channel);
+	peer->set_transfer_mode(mode);
+	flushing_batches = false;
+}
+
+void SceneRPCInterface::clear_batches() {
+	batches.clear();
+}
+
 void SceneRPCInterface::_send_rpc(Node *p_node, int p_to, uint16_t p_rpc_id, const RPCConfig &p_config, const StringName &p_name, const Variant **p_arg, int p_argcount) {
 	Ref<MultiplayerPeer> peer = multiplayer->get_multiplayer_peer();
 	ERR_FAIL_COND_MSG(peer.is_null(), "Attempt to call RPC without active multiplayer peer.");
@@ -428,13 +527,9 @@ void SceneRPCInterface::_send_rpc(Node *p_node, int p_to, uint16_t p_rpc_id, con
 	// We can now set the meta
 	packet_cache.write[0] = command_type + (node_id_compression << NODE_ID_COMPRESSION_SHIFT) + (name_id_compression << NAME_ID_COMPRESSION_SHIFT) + (byte_only_or_no_args ? BYTE_ONLY_OR_NO_ARGS_FLAG : 0);
 
-	// Take chance and set transfer mode, since all send methods will use it.
-	peer->set_transfer_channel(p_config.channel);
-	peer->set_transfer_mode(p_config.transfer_mode);
-
 	if (has_all_peers) {
 		for (const int P : targets) {
-			multiplayer->send_command(P, packet_cache.ptr(), ofs);
+			_send_command(P, p_config, packet_cache.ptr(), ofs);
 		}
 	} else {
 		// Unreachable because the node ID is never compressed if the peers doesn't know it.
@@ -455,11 +550,11 @@ void SceneRPCInterface::_send_rpc(Node *p_node, int p_to, uint16_t p_rpc_id, con
 			if (confirmed) {
 				// This one confirmed path, so use id.
 				encode_uint32(psc_id, &(packet_cache.write[1]));
-				multiplayer->send_command(P, packet_cache.ptr(), ofs);
+				_send_command(P, p_config, packet_cache.ptr(), ofs);
 			} else {
 				// This one did not confirm path yet, so use entire path (sorry!).
 				encode_uint32(0x80000000 | ofs, &(packet_cache.write[1])); // Offset to path and flag.
-				multiplayer->send_command(P, packet_cache.ptr(), ofs + path_len);
+				_send_command(P, p_config, packet_cache.ptr(), ofs + path_len);
 			}
 		}
 	}
@@ -32,6 +32,7 @@
 #define SCENE_RPC_INTERFACE_H
 
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 #include "scene/main/multiplayer_api.h"
 
 class SceneMultiplayer;
@@ -76,9 +77,37 @@ private:
 		NETWORK_NAME_ID_COMPRESSION_16,
 	};
 
+	struct BatchKey {
+		int peer = 0;
+		int channel = 0;
+		MultiplayerPeer::TransferMode mode = MultiplayerPeer::TRANSFER_MODE_RELIABLE;
+
+		static uint32_t hash(const BatchKey &p_key) {
+			uint32_t h = hash_murmur3_one_32(p_key.peer);
+			h = hash_murmur3_one_32(p_key.channel, h);
+			return hash_fmix32(hash_murmur3_one_32(p_key.mode, h));
+		}
+		bool operator==(const BatchKey &p_other) const {
+			return peer == p_other.peer && channel == p_other.channel && mode == p_other.mode;
+		}
+
+		BatchKey() {}
+		BatchKey(int p_peer, int p_channel, MultiplayerPeer::TransferMode p_mode) {
+			peer = p_peer;
+			channel = p_channel;
+			mode = p_mode;
+		}
+	};
+
 	SceneMultiplayer *multiplayer = nullptr;
 	Vector<uint8_t> packet_cache;
 
+	// RPC batching, coalesces the RPCs sent to each peer, channel and transfer mode until the next flush.
+	bool batching = false;
+	bool flushing_batches = false;
+	int batch_mtu = 1350; // Same as the replication sync packets.
+	HashMap<BatchKey, LocalVector<uint8_t>, BatchKey> batches;
+
 	HashMap<ObjectID, RPCConfigCache> rpc_cache;
 
 #ifdef DEBUG_ENABLED
@@ -88,6 +117,9 @@ private:
 protected:
 	void _process_rpc(Node *p_node, const uint16_t p_rpc_method_id, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 
+	Error _send_command(int p_to, const RPCConfig &p_config, const uint8_t *p_packet, int p_packet_len);
+	void _process_batch(int p_from, const uint8_t *p_packet, int p_packet_len);
+
 	void _send_rpc(Node *p_from, int p_to, uint16_t p_rpc_id, const RPCConfig &p_config, const StringName &p_name, const Variant **p_arg, int p_argcount);
 	Node *_process_get_node(int p_from, const uint8_t *p_packet, uint32_t p_node_target, int p_packet_len);
 
@@ -99,6 +131,12 @@ public:
 	void process_rpc(int p_from, const uint8_t *p_packet, int p_packet_len);
 	String get_rpc_md5(const Object *p_obj);
 
+	void set_batching_enabled(bool p_enabled);
+	bool is_batching_enabled() const;
+	bool has_pending_batches() const { return !batches.is_empty(); }
+	void flush_batches();
+	void clear_batches();
+
 	SceneRPCInterface(SceneMultiplayer *p_multiplayer) { multiplayer = p_multiplayer; }
 };
 
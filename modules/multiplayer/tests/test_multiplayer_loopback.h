@@ -0,0 +1,223 @@
+/**************************************************************************/
+/*  test_multiplayer_loopback.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MULTIPLAYER_LOOPBACK_H
+#define TEST_MULTIPLAYER_LOOPBACK_H
+
+#include "modules/multiplayer/multiplayer_synchronizer.h"
+#include "modules/multiplayer/scene_multiplayer.h"
+
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMultiplayerLoopback {
+
+// Delivers the packets put by one peer straight to the other one, and keeps a copy of them for inspection.
+class LoopbackMultiplayerPeer : public MultiplayerPeer {
+	GDCLASS(LoopbackMultiplayerPeer, MultiplayerPeer);
+
+public:
+	struct Packet {
+		Vector<uint8_t> data;
+		int from = 0;
+		int channel = 0;
+		TransferMode mode = TRANSFER_MODE_RELIABLE;
+	};
+
+private:
+	int unique_id = TARGET_PEER_SERVER;
+	LoopbackMultiplayerPeer *remote = nullptr; // Not a reference, the two peers point at each other.
+	List<Packet> incoming;
+	Packet current;
+
+public:
+	Vector<Packet> sent;
+
+	static void connect_peers(LoopbackMultiplayerPeer *p_a, LoopbackMultiplayerPeer *p_b) {
+		p_a->remote = p_b;
+		p_b->remote = p_a;
+		p_a->emit_signal(SNAME("peer_connected"), p_b->unique_id);
+		p_b->emit_signal(SNAME("peer_connected"), p_a->unique_id);
+	}
+
+	void set_unique_id(int p_id) { unique_id = p_id; }
+
+	virtual int get_available_packet_count() const override { return incoming.size(); }
+	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) override {
+		ERR_FAIL_COND_V(incoming.is_empty(), ERR_UNAVAILABLE);
+		current = incoming.front()->get();
+		incoming.pop_front();
+		*r_buffer = current.data.ptr();
+		r_buffer_size = current.data.size();
+		return OK;
+	}
+	virtual Error put_packet(const uint8_t *p_buffer, int p_buffer_size) override {
+		Packet packet;
+		packet.data.resize(p_buffer_size);
+		memcpy(packet.data.ptrw(), p_buffer, p_buffer_size);
+		packet.from = unique_id;
+		packet.channel = get_transfer_channel();
+		packet.mode = get_transfer_mode();
+		sent.push_back(packet);
+		if (remote) {
+			remote->incoming.push_back(packet);
+		}
+		return OK;
+	}
+	virtual int get_max_packet_size() const override { return 1 << 24; }
+
+	virtual void set_target_peer(int p_peer_id) override {}
+	virtual int get_packet_peer() const override {
+		ERR_FAIL_COND_V(incoming.is_empty(), 0);
+		return incoming.front()->get().from;
+	}
+	virtual TransferMode get_packet_mode() const override {
+		ERR_FAIL_COND_V(incoming.is_empty(), TRANSFER_MODE_RELIABLE);
+		return incoming.front()->get().mode;
+	}
+	virtual int get_packet_channel() const override {
+		ERR_FAIL_COND_V(incoming.is_empty(), 0);
+		return incoming.front()->get().channel;
+	}
+	virtual void disconnect_peer(int p_peer, bool p_force = false) override {}
+	virtual bool is_server() const override { return unique_id == TARGET_PEER_SERVER; }
+	virtual void poll() override {}
+	virtual void close() override {}
+	virtual int get_unique_id() const override { return unique_id; }
+	virtual ConnectionStatus get_connection_status() const override { return CONNECTION_CONNECTED; }
+};
+
+// A node with the dynamic properties "p0" to "p63", to be replicated by a MultiplayerSynchronizer.
+class ReplicatedTestNode : public Node {
+	GDCLASS(ReplicatedTestNode, Node);
+
+	static int _get_index(const StringName &p_name) {
+		const String name = p_name;
+		if (!name.begins_with("p") || !name.substr(1).is_valid_int()) {
+			return -1;
+		}
+		const int idx = name.substr(1).to_int();
+		return idx < SceneReplicationConfig::MAX_WATCHED_PROPERTIES ? idx : -1;
+	}
+
+protected:
+	bool _set(const StringName &p_name, const Variant &p_value) {
+		const int idx = _get_index(p_name);
+		if (idx < 0) {
+			return false;
+		}
+		values[idx] = p_value;
+		return true;
+	}
+
+	bool _get(const StringName &p_name, Variant &r_ret) const {
+		const int idx = _get_index(p_name);
+		if (idx < 0) {
+			return false;
+		}
+		r_ret = values[idx];
+		return true;
+	}
+
+public:
+	Variant values[SceneReplicationConfig::MAX_WATCHED_PROPERTIES];
+};
+
+// Adds a ReplicatedTestNode named p_name, with a MultiplayerSynchronizer child named "Sync" using p_config.
+static MultiplayerSynchronizer *add_replicated_node(Node *p_parent, const String &p_name, const Ref<SceneReplicationConfig> &p_config, ReplicatedTestNode **r_node = nullptr) {
+	ReplicatedTestNode *node = memnew(ReplicatedTestNode);
+	node->set_name(p_name);
+	MultiplayerSynchronizer *sync = memnew(MultiplayerSynchronizer);
+	sync->set_name("Sync");
+	sync->set_replication_config(p_config);
+	node->add_child(sync);
+	p_parent->add_child(node);
+	if (r_node) {
+		*r_node = node;
+	}
+	return sync;
+}
+
+// A server and a client SceneMultiplayer connected through loopback peers,
+// each one rooted at its own branch of the scene tree ("/root/Server" and "/root/Client").
+// Nodes added with the same relative path to both roots are the same node for the two peers.
+struct MultiplayerLoopback {
+	Ref<SceneMultiplayer> server;
+	Ref<SceneMultiplayer> client;
+	Ref<LoopbackMultiplayerPeer> server_peer;
+	Ref<LoopbackMultiplayerPeer> client_peer;
+	Node *server_root = nullptr;
+	Node *client_root = nullptr;
+
+	// Polls the server first, so the client receives what the server sent in the same step.
+	void poll() {
+		server->poll();
+		client->poll();
+	}
+
+	MultiplayerLoopback() {
+		SceneTree *tree = SceneTree::get_singleton();
+		server.instantiate();
+		client.instantiate();
+		tree->set_multiplayer(server, NodePath("/root/Server"));
+		tree->set_multiplayer(client, NodePath("/root/Client"));
+
+		server_root = memnew(Node);
+		server_root->set_name("Server");
+		tree->get_root()->add_child(server_root);
+		client_root = memnew(Node);
+		client_root->set_name("Client");
+		tree->get_root()->add_child(client_root);
+
+		server_peer.instantiate();
+		server_peer->set_unique_id(MultiplayerPeer::TARGET_PEER_SERVER);
+		client_peer.instantiate();
+		client_peer->set_unique_id(2);
+		server->set_multiplayer_peer(server_peer);
+		client->set_multiplayer_peer(client_peer);
+		LoopbackMultiplayerPeer::connect_peers(server_peer.ptr(), client_peer.ptr());
+	}
+
+	~MultiplayerLoopback() {
+		memdelete(server_root);
+		memdelete(client_root);
+		server->set_multiplayer_peer(Ref<MultiplayerPeer>());
+		client->set_multiplayer_peer(Ref<MultiplayerPeer>());
+		SceneTree *tree = SceneTree::get_singleton();
+		tree->set_multiplayer(Ref<MultiplayerAPI>(), NodePath("/root/Server"));
+		tree->set_multiplayer(Ref<MultiplayerAPI>(), NodePath("/root/Client"));
+	}
+};
+
+} // namespace TestMultiplayerLoopback
+
+#endif // TEST_MULTIPLAYER_LOOPBACK_H
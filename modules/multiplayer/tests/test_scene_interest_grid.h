@@ -0,0 +1,106 @@
+/**************************************************************************/
+/*  test_scene_interest_grid.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_INTEREST_GRID_H
+#define TEST_SCENE_INTEREST_GRID_H
+
+#include "modules/multiplayer/scene_interest_grid.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneInterestGrid {
+
+TEST_CASE("[SceneInterestGrid] Entries enter and leave the radius") {
+	SceneInterestGrid grid;
+	grid.set_cell_size(10);
+	const ObjectID near_id = ObjectID(uint64_t(1));
+	const ObjectID far_id = ObjectID(uint64_t(2));
+	grid.update(near_id, Vector3(5, 0, 0));
+	grid.update(far_id, Vector3(30, 0, 0));
+
+	HashMap<ObjectID, real_t> previous;
+	HashMap<ObjectID, real_t> relevance;
+	grid.query(Vector3(), 10, 11, previous, relevance);
+	CHECK(relevance.size() == 1);
+	REQUIRE(relevance.has(near_id));
+	CHECK(relevance[near_id] == doctest::Approx(0.5));
+
+	// Entering the radius.
+	grid.update(far_id, Vector3(0, 0, 9));
+	previous = relevance;
+	grid.query(Vector3(), 10, 11, previous, relevance);
+	CHECK(relevance.has(far_id));
+
+	// Leaving the radius, beyond the leave radius.
+	grid.update(near_id, Vector3(12, 0, 0));
+	previous = relevance;
+	grid.query(Vector3(), 10, 11, previous, relevance);
+	CHECK_FALSE(relevance.has(near_id));
+	CHECK(relevance.has(far_id));
+
+	grid.remove(far_id);
+	previous = relevance;
+	grid.query(Vector3(), 10, 11, previous, relevance);
+	CHECK(relevance.is_empty());
+}
+
+TEST_CASE("[SceneInterestGrid] Entries moving along the radius don't flap") {
+	SceneInterestGrid grid;
+	grid.set_cell_size(10);
+	const ObjectID id = ObjectID(uint64_t(1));
+	grid.update(id, Vector3(9.9, 0, 0));
+
+	HashMap<ObjectID, real_t> previous;
+	HashMap<ObjectID, real_t> relevance;
+	grid.query(Vector3(), 10, 11, previous, relevance);
+	REQUIRE(relevance.has(id));
+
+	// Once relevant, it stays relevant with the lowest priority between the radius and the leave radius.
+	for (int i = 0; i < 10; i++) {
+		grid.update(id, Vector3(i % 2 ? 9.9 : 10.5, 0, 0));
+		previous = relevance;
+		grid.query(Vector3(), 10, 11, previous, relevance);
+		REQUIRE(relevance.has(id));
+	}
+
+	grid.update(id, Vector3(10.5, 0, 0));
+	previous = relevance;
+	grid.query(Vector3(), 10, 11, previous, relevance);
+	CHECK(relevance[id] == 0.0);
+
+	// Entries that were not relevant only enter within the radius.
+	previous.clear();
+	grid.query(Vector3(), 10, 11, previous, relevance);
+	CHECK_FALSE(relevance.has(id));
+}
+
+} // namespace TestSceneInterestGrid
+
+#endif // TEST_SCENE_INTEREST_GRID_H
@@ -0,0 +1,200 @@
+/**************************************************************************/
+/*  test_scene_replication_delta.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_REPLICATION_DELTA_H
+#define TEST_SCENE_REPLICATION_DELTA_H
+
+#include "modules/multiplayer/tests/test_multiplayer_loopback.h"
+
+#include "core/io/marshalls.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneReplicationDelta {
+
+using namespace TestMultiplayerLoopback;
+
+static Ref<SceneReplicationConfig> make_watch_config(int p_count) {
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	for (int i = 0; i < p_count; i++) {
+		const NodePath path = NodePath(vformat(":p%d", i));
+		config->add_property(path);
+		config->property_set_watch(path, true);
+	}
+	return config;
+}
+
+TEST_CASE("[SceneReplicationConfig] Watched properties are limited to 64") {
+	Ref<SceneReplicationConfig> config = make_watch_config(SceneReplicationConfig::MAX_WATCHED_PROPERTIES);
+	CHECK(config->get_watch_properties().size() == SceneReplicationConfig::MAX_WATCHED_PROPERTIES);
+	CHECK(config->get_sync_properties().is_empty());
+
+	const NodePath extra = NodePath(":p64");
+	config->add_property(extra);
+	ERR_PRINT_OFF;
+	config->property_set_watch(extra, true);
+	bool valid = true;
+	config->set("properties/64/watch", true, &valid);
+	ERR_PRINT_ON;
+	CHECK_FALSE(valid);
+	CHECK_FALSE(config->property_get_watch(extra));
+	CHECK(config->property_get_sync(extra));
+	CHECK(config->get_watch_properties().size() == SceneReplicationConfig::MAX_WATCHED_PROPERTIES);
+
+	// Syncing a watched property stops watching it, which makes room for another one.
+	config->property_set_sync(NodePath(":p0"), true);
+	CHECK_FALSE(config->property_get_watch(NodePath(":p0")));
+	config->property_set_watch(extra, true);
+	CHECK(config->property_get_watch(extra));
+	CHECK_FALSE(config->property_get_sync(extra));
+	CHECK(config->get_watch_properties().size() == SceneReplicationConfig::MAX_WATCHED_PROPERTIES);
+}
+
+TEST_CASE("[SceneTree][MultiplayerSynchronizer] Delta state contains the watched properties changed since the baseline") {
+	MultiplayerLoopback loopback;
+	ReplicatedTestNode *node = nullptr;
+	MultiplayerSynchronizer *sync = add_replicated_node(loopback.server_root, "Obj", make_watch_config(3), &node);
+	for (int i = 0; i < 3; i++) {
+		node->values[i] = i;
+	}
+
+	// Every property is sent the first time.
+	Vector<const Variant *> varp;
+	CHECK(sync->get_delta_state(1000, 0, varp) == 0b111);
+	CHECK(varp.size() == 3);
+
+	// Nothing changed since the baseline.
+	CHECK(sync->get_delta_state(2000, 1000, varp) == 0);
+	CHECK(varp.is_empty());
+
+	node->values[2] = "changed";
+	CHECK(sync->get_delta_state(3000, 2000, varp) == 0b100);
+	REQUIRE(varp.size() == 1);
+	CHECK(*varp[0] == Variant("changed"));
+	// Peers with an older baseline get every change since then.
+	CHECK(sync->get_delta_state(3000, 0, varp) == 0b111);
+
+	List<NodePath> props = sync->get_delta_properties(0b101);
+	REQUIRE(props.size() == 2);
+	CHECK(props.front()->get() == NodePath(":p0"));
+	CHECK(props.back()->get() == NodePath(":p2"));
+	CHECK(sync->get_delta_properties(1ULL << 63).is_empty());
+
+	// Changes are sampled at most once per delta interval.
+	sync->set_delta_interval(1.0);
+	node->values[1] = "later";
+	CHECK(sync->get_delta_state(4000, 3000, varp) == 0);
+	CHECK(sync->get_delta_state(3000 + 1000000, 3000, varp) == 0b010);
+}
+
+TEST_CASE("[SceneTree][MultiplayerSynchronizer] Dirty masks of 64 watched properties round-trip as varints") {
+	MultiplayerLoopback loopback;
+	ReplicatedTestNode *node = nullptr;
+	MultiplayerSynchronizer *sync = add_replicated_node(loopback.server_root, "Obj", make_watch_config(SceneReplicationConfig::MAX_WATCHED_PROPERTIES), &node);
+
+	Vector<const Variant *> varp;
+	const uint64_t all = sync->get_delta_state(1000, 0, varp);
+	CHECK(all == UINT64_MAX);
+	CHECK(varp.size() == SceneReplicationConfig::MAX_WATCHED_PROPERTIES);
+
+	uint8_t buf[10];
+	uint64_t decoded = 0;
+	int used = 0;
+	CHECK(encode_varuint(all, buf) == 10);
+	CHECK(decode_varuint(buf, 10, used, decoded));
+	CHECK(used == 10);
+	CHECK(decoded == all);
+
+	// Only the highest changed index costs bytes.
+	node->values[3] = 3;
+	const uint64_t low = sync->get_delta_state(2000, 1000, varp);
+	CHECK(low == (1ULL << 3));
+	CHECK(encode_varuint(low, buf) == 1);
+	CHECK(decode_varuint(buf, 1, used, decoded));
+	CHECK(decoded == low);
+
+	node->values[63] = 63;
+	const uint64_t high = sync->get_delta_state(3000, 2000, varp);
+	CHECK(high == (1ULL << 63));
+	CHECK(encode_varuint(high, buf) == 10);
+	CHECK(decode_varuint(buf, 10, used, decoded));
+	CHECK(decoded == high);
+	// Truncated masks are rejected.
+	CHECK_FALSE(decode_varuint(buf, 9, used, decoded));
+
+	List<NodePath> props = sync->get_delta_properties(high);
+	REQUIRE(props.size() == 1);
+	CHECK(props.front()->get() == NodePath(":p63"));
+}
+
+TEST_CASE("[SceneTree][SceneReplicationInterface] Watched property deltas reach the client") {
+	MultiplayerLoopback loopback;
+	ReplicatedTestNode *server_node = nullptr;
+	ReplicatedTestNode *client_node = nullptr;
+	add_replicated_node(loopback.server_root, "Obj", make_watch_config(3), &server_node);
+	add_replicated_node(loopback.client_root, "Obj", make_watch_config(3), &client_node);
+	for (int i = 0; i < 3; i++) {
+		server_node->values[i] = i + 1;
+	}
+
+	// The first step confirms the synchronizer path, the second one sends every watched property.
+	loopback.poll();
+	loopback.poll();
+	for (int i = 0; i < 3; i++) {
+		CHECK(client_node->values[i] == Variant(i + 1));
+	}
+
+	const uint8_t delta_cmd = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT);
+	server_node->values[2] = 30;
+	int sent_before = loopback.server_peer->sent.size();
+	loopback.poll();
+	REQUIRE(loopback.server_peer->sent.size() == sent_before + 1);
+	const LoopbackMultiplayerPeer::Packet &delta = loopback.server_peer->sent[sent_before];
+	CHECK(delta.mode == MultiplayerPeer::TRANSFER_MODE_RELIABLE);
+	REQUIRE(delta.data.size() > 10);
+	CHECK(delta.data[0] == delta_cmd);
+	uint64_t mask = 0;
+	int used = 0;
+	CHECK(decode_varuint(delta.data.ptr() + 9, delta.data.size() - 9, used, mask));
+	CHECK(used == 1);
+	CHECK(mask == 0b100);
+	CHECK(client_node->values[2] == Variant(30));
+	CHECK(client_node->values[1] == Variant(2));
+
+	// The client is up to date, nothing else is sent.
+	sent_before = loopback.server_peer->sent.size();
+	loopback.poll();
+	CHECK(loopback.server_peer->sent.size() == sent_before);
+}
+
+} // namespace TestSceneReplicationDelta
+
+#endif // TEST_SCENE_REPLICATION_DELTA_H
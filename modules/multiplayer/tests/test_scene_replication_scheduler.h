@@ -0,0 +1,182 @@
+/**************************************************************************/
+/*  test_scene_replication_scheduler.h                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_REPLICATION_SCHEDULER_H
+#define TEST_SCENE_REPLICATION_SCHEDULER_H
+
+#include "modules/multiplayer/tests/test_multiplayer_loopback.h"
+
+#include "core/io/marshalls.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneReplicationScheduler {
+
+using namespace TestMultiplayerLoopback;
+
+// Synchronizers of the same size, so the budget and packet size limits are easy to predict.
+static String get_state_value() {
+	return String("x").repeat(60);
+}
+
+// Adds one synced node per priority to both peers, and lets the client confirm their paths.
+static Vector<MultiplayerSynchronizer *> add_synced_nodes(MultiplayerLoopback &p_loopback, const Vector<real_t> &p_priorities) {
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(":p0"));
+
+	Vector<MultiplayerSynchronizer *> syncs;
+	for (int i = 0; i < p_priorities.size(); i++) {
+		const String name = vformat("S%d", i);
+		ReplicatedTestNode *node = nullptr;
+		MultiplayerSynchronizer *sync = add_replicated_node(p_loopback.server_root, name, config, &node);
+		node->values[0] = get_state_value();
+		sync->set_replication_priority(p_priorities[i]);
+		syncs.push_back(sync);
+		add_replicated_node(p_loopback.client_root, name, config);
+	}
+	p_loopback.poll();
+	return syncs;
+}
+
+// Size of a synchronizer block in a sync packet: net ID, state size and state.
+static int get_state_block_size() {
+	const Variant value = get_state_value();
+	const Variant *valuep = &value;
+	int size = 0;
+	MultiplayerAPI::encode_and_compress_variants(&valuep, 1, nullptr, size);
+	return 4 + 4 + size;
+}
+
+// Returns the indexes in p_syncs of the states sent in the sync packets since p_from, in order.
+static Vector<int> get_sent_states(const LoopbackMultiplayerPeer *p_peer, int p_from, const Vector<MultiplayerSynchronizer *> &p_syncs, int *r_packets = nullptr) {
+	Vector<int> states;
+	int packets = 0;
+	for (int i = p_from; i < p_peer->sent.size(); i++) {
+		const Vector<uint8_t> &data = p_peer->sent[i].data;
+		if (data.size() < 3 || data[0] != SceneMultiplayer::NETWORK_COMMAND_SYNC) {
+			continue;
+		}
+		packets++;
+		int ofs = 3;
+		while (ofs + 8 <= data.size()) {
+			const uint32_t net_id = decode_uint32(data.ptr() + ofs);
+			ofs += 8 + decode_uint32(data.ptr() + ofs + 4);
+			int idx = -1;
+			for (int j = 0; j < p_syncs.size(); j++) {
+				if (p_syncs[j]->get_net_id() == net_id) {
+					idx = j;
+				}
+			}
+			states.push_back(idx);
+		}
+	}
+	if (r_packets) {
+		*r_packets = packets;
+	}
+	return states;
+}
+
+TEST_CASE("[SceneTree][SceneReplicationInterface] Starved synchronizers carry their priority over to the next frame") {
+	MultiplayerLoopback loopback;
+	// Only one state fits in each frame, the first state always goes through.
+	loopback.server->set_max_sync_bytes_per_frame(1);
+	const Vector<MultiplayerSynchronizer *> syncs = add_synced_nodes(loopback, { 3, 2, 0.7 });
+
+	// The priorities keep growing while waiting, so the lowest one makes it after a few frames.
+	const int expected[6] = { 0, 1, 0, 1, 0, 2 };
+	for (int frame = 0; frame < 6; frame++) {
+		const int sent_before = loopback.server_peer->sent.size();
+		loopback.poll();
+		const Vector<int> states = get_sent_states(loopback.server_peer.ptr(), sent_before, syncs);
+		REQUIRE(states.size() == 1);
+		CHECK_MESSAGE(states[0] == expected[frame], vformat("Unexpected synchronizer at frame %d.", frame));
+	}
+
+	ReplicatedTestNode *client_node = Object::cast_to<ReplicatedTestNode>(loopback.client_root->get_node(NodePath("S2")));
+	REQUIRE(client_node);
+	CHECK(client_node->values[0] == Variant(get_state_value()));
+}
+
+TEST_CASE("[SceneTree][SceneReplicationInterface] Synchronizers are sent by priority within the frame budget") {
+	MultiplayerLoopback loopback;
+	const int block_size = get_state_block_size();
+	// Room for two states and a half.
+	loopback.server->set_max_sync_bytes_per_frame(3 + block_size * 2 + block_size / 2);
+	const Vector<MultiplayerSynchronizer *> syncs = add_synced_nodes(loopback, { 1, 3, 2 });
+
+	const int sent_before = loopback.server_peer->sent.size();
+	loopback.poll();
+	int packets = 0;
+	const Vector<int> states = get_sent_states(loopback.server_peer.ptr(), sent_before, syncs, &packets);
+	CHECK(packets == 1);
+	REQUIRE(states.size() == 2);
+	CHECK(states[0] == 1);
+	CHECK(states[1] == 2);
+
+	// Without a budget, everything is sent.
+	loopback.server->set_max_sync_bytes_per_frame(0);
+	const int sent_unlimited = loopback.server_peer->sent.size();
+	loopback.poll();
+	CHECK(get_sent_states(loopback.server_peer.ptr(), sent_unlimited, syncs).size() == 3);
+}
+
+TEST_CASE("[SceneTree][SceneReplicationInterface] Sync packets are split at the maximum packet size") {
+	MultiplayerLoopback loopback;
+	const int max_size = 128;
+	const int block_size = get_state_block_size();
+	REQUIRE(3 + block_size <= max_size);
+	REQUIRE(3 + block_size * 2 > max_size);
+	loopback.server->set_max_sync_packet_size(max_size);
+	const Vector<MultiplayerSynchronizer *> syncs = add_synced_nodes(loopback, { 3, 2, 1 });
+
+	const int sent_before = loopback.server_peer->sent.size();
+	loopback.poll();
+	int packets = 0;
+	const Vector<int> states = get_sent_states(loopback.server_peer.ptr(), sent_before, syncs, &packets);
+	CHECK(packets == 3);
+	REQUIRE(states.size() == 3);
+	CHECK(states[0] == 0);
+	CHECK(states[1] == 1);
+	CHECK(states[2] == 2);
+	for (int i = sent_before; i < loopback.server_peer->sent.size(); i++) {
+		CHECK(loopback.server_peer->sent[i].data.size() <= max_size);
+	}
+
+	for (int i = 0; i < syncs.size(); i++) {
+		ReplicatedTestNode *client_node = Object::cast_to<ReplicatedTestNode>(loopback.client_root->get_node(NodePath(vformat("S%d", i))));
+		REQUIRE(client_node);
+		CHECK(client_node->values[0] == Variant(get_state_value()));
+	}
+}
+
+} // namespace TestSceneReplicationScheduler
+
+#endif // TEST_SCENE_REPLICATION_SCHEDULER_H
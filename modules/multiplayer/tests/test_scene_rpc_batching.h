@@ -0,0 +1,181 @@
+/**************************************************************************/
+/*  test_scene_rpc_batching.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_RPC_BATCHING_H
+#define TEST_SCENE_RPC_BATCHING_H
+
+#include "modules/multiplayer/tests/test_multiplayer_loopback.h"
+
+#include "core/io/marshalls.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneRPCBatching {
+
+using namespace TestMultiplayerLoopback;
+
+class RPCBatchTestNode : public Node {
+	GDCLASS(RPCBatchTestNode, Node);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("ping"), &RPCBatchTestNode::ping);
+		ClassDB::bind_method(D_METHOD("add", "value"), &RPCBatchTestNode::add);
+		ClassDB::bind_method(D_METHOD("add_two", "a", "b"), &RPCBatchTestNode::add_two);
+	}
+
+public:
+	Vector<String> *calls = nullptr;
+
+	void ping() { calls->push_back(vformat("%s:ping", get_name())); }
+	void add(int p_value) { calls->push_back(vformat("%s:add(%d)", get_name(), p_value)); }
+	void add_two(int p_a, int p_b) { calls->push_back(vformat("%s:add_two(%d,%d)", get_name(), p_a, p_b)); }
+};
+
+static RPCBatchTestNode *add_rpc_node(Node *p_parent, const String &p_name, Vector<String> *r_calls) {
+	RPCBatchTestNode *node = memnew(RPCBatchTestNode);
+	node->set_name(p_name);
+	node->calls = r_calls;
+	Dictionary config;
+	config["rpc_mode"] = MultiplayerAPI::RPC_MODE_ANY_PEER;
+	config["transfer_mode"] = MultiplayerPeer::TRANSFER_MODE_UNRELIABLE_ORDERED;
+	config["channel"] = 1;
+	node->rpc_config("ping", config);
+	node->rpc_config("add", config);
+	node->rpc_config("add_two", config);
+	p_parent->add_child(node);
+	return node;
+}
+
+TEST_CASE("[SceneTree][SceneRPCInterface] RPC batches round-trip with mixed node IDs and arguments") {
+	MultiplayerLoopback loopback;
+	loopback.server->set_rpc_batching_enabled(true);
+
+	Vector<String> calls;
+	RPCBatchTestNode *n1 = add_rpc_node(loopback.server_root, "N1", &calls);
+	RPCBatchTestNode *n3 = add_rpc_node(loopback.server_root, "N3", &calls);
+	add_rpc_node(loopback.client_root, "N1", &calls);
+	add_rpc_node(loopback.client_root, "N3", &calls);
+
+	const uint8_t batch_flag = (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT) | (1 << SceneMultiplayer::CMD_FLAG_1_SHIFT);
+	const Variant one = 1;
+	const Variant two = 2;
+	const Variant three = 3;
+
+	// Let the client confirm the path of N1, a single RPC is sent without the batch header.
+	CHECK(loopback.server->rpcp(n1, 2, "ping", nullptr, 0) == OK);
+	loopback.poll();
+	loopback.server->poll();
+	REQUIRE(calls.size() == 1);
+	CHECK(calls[0] == "N1:ping");
+	const LoopbackMultiplayerPeer::Packet &single = loopback.server_peer->sent[loopback.server_peer->sent.size() - 1];
+	CHECK((single.data[0] & SceneMultiplayer::CMD_MASK) == SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL);
+	CHECK((single.data[0] & batch_flag) != batch_flag);
+
+	// N3 is not confirmed yet (32 bits ID and path), while N1 is (8 bits ID).
+	calls.clear();
+	const Variant *add_args[1] = { &one };
+	const Variant *add_two_args[2] = { &two, &three };
+	CHECK(loopback.server->rpcp(n3, 2, "ping", nullptr, 0) == OK);
+	CHECK(loopback.server->rpcp(n1, 2, "add", add_args, 1) == OK);
+	CHECK(loopback.server->rpcp(n3, 2, "add_two", add_two_args, 2) == OK);
+	CHECK(calls.is_empty());
+
+	// Flushing restores the transfer settings used by the caller.
+	loopback.server_peer->set_transfer_channel(3);
+	loopback.server_peer->set_transfer_mode(MultiplayerPeer::TRANSFER_MODE_UNRELIABLE);
+	const int sent_before = loopback.server_peer->sent.size();
+	loopback.server->poll();
+	CHECK(loopback.server_peer->get_transfer_channel() == 3);
+	CHECK(loopback.server_peer->get_transfer_mode() == MultiplayerPeer::TRANSFER_MODE_UNRELIABLE);
+
+	REQUIRE(loopback.server_peer->sent.size() == sent_before + 1);
+	const LoopbackMultiplayerPeer::Packet &batch = loopback.server_peer->sent[sent_before];
+	CHECK(batch.channel == 1);
+	CHECK(batch.mode == MultiplayerPeer::TRANSFER_MODE_UNRELIABLE_ORDERED);
+	CHECK((batch.data[0] & SceneMultiplayer::CMD_MASK) == SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL);
+	CHECK((batch.data[0] & batch_flag) == batch_flag);
+
+	const uint8_t expected_node_ids[3] = { 2, 0, 2 }; // 32 bits, 8 bits, 32 bits.
+	int ofs = 1;
+	int count = 0;
+	while (ofs < batch.data.size() && count < 3) {
+		uint64_t len = 0;
+		int used = 0;
+		REQUIRE(decode_varuint(batch.data.ptr() + ofs, batch.data.size() - ofs, used, len));
+		ofs += used;
+		REQUIRE(len <= uint64_t(batch.data.size() - ofs));
+		CHECK(((batch.data[ofs] >> SceneMultiplayer::CMD_FLAG_0_SHIFT) & 3) == expected_node_ids[count]);
+		ofs += len;
+		count++;
+	}
+	CHECK(count == 3);
+	CHECK(ofs == batch.data.size());
+
+	loopback.client->poll();
+	REQUIRE(calls.size() == 3);
+	CHECK(calls[0] == "N3:ping");
+	CHECK(calls[1] == "N1:add(1)");
+	CHECK(calls[2] == "N3:add_two(2,3)");
+}
+
+TEST_CASE("[SceneTree][SceneRPCInterface] Other commands flush the pending RPCs first") {
+	MultiplayerLoopback loopback;
+	loopback.server->set_rpc_batching_enabled(true);
+
+	Vector<String> calls;
+	RPCBatchTestNode *n1 = add_rpc_node(loopback.server_root, "N1", &calls);
+	RPCBatchTestNode *n2 = add_rpc_node(loopback.server_root, "N2", &calls);
+	add_rpc_node(loopback.client_root, "N1", &calls);
+	add_rpc_node(loopback.client_root, "N2", &calls);
+
+	CHECK(loopback.server->rpcp(n1, 2, "ping", nullptr, 0) == OK);
+	loopback.poll();
+	loopback.server->poll();
+	calls.clear();
+
+	// Reaching N2 needs a path simplification command, the RPC queued for N1 must go before it.
+	const int sent_before = loopback.server_peer->sent.size();
+	CHECK(loopback.server->rpcp(n1, 2, "ping", nullptr, 0) == OK);
+	CHECK(loopback.server_peer->sent.size() == sent_before);
+	CHECK(loopback.server->rpcp(n2, 2, "ping", nullptr, 0) == OK);
+	REQUIRE(loopback.server_peer->sent.size() == sent_before + 2);
+	CHECK((loopback.server_peer->sent[sent_before].data[0] & SceneMultiplayer::CMD_MASK) == SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL);
+	CHECK((loopback.server_peer->sent[sent_before + 1].data[0] & SceneMultiplayer::CMD_MASK) == SceneMultiplayer::NETWORK_COMMAND_SIMPLIFY_PATH);
+
+	loopback.poll();
+	REQUIRE(calls.size() == 2);
+	CHECK(calls[0] == "N1:ping");
+	CHECK(calls[1] == "N2:ping");
+}
+
+} // namespace TestSceneRPCBatching
+
+#endif // TEST_SCENE_RPC_BATCHING_H
@@ -30,6 +30,7 @@
 
 #include "godot_navigation_server.h"
 
+#include "core/config/project_settings.h"
 #include "core/os/mutex.h"
 
 #ifndef _3D_DISABLED
@@ -84,6 +85,7 @@ using namespace NavigationUtilities;
 GodotNavigationServer::GodotNavigationServer() {}
 
 GodotNavigationServer::~GodotNavigationServer() {
+	_finish_path_queries(false);
 	flush_queries();
 }
 
@@ -111,6 +113,9 @@ RID GodotNavigationServer::map_create() {
 	RID rid = map_owner.make_rid();
 	NavMap *map = map_owner.get_or_null(rid);
 	map->set_self(rid);
+	map->set_use_avoidance_grid(GLOBAL_GET("navigation/avoidance/use_spatial_grid"));
+	map->set_path_cache_size(GLOBAL_GET("navigation/pathfinding/path_cache_size"));
+	map->set_use_hierarchical_pathfinding(GLOBAL_GET("navigation/pathfinding/use_hierarchical_pathfinding"));
 	return rid;
 }
 
@@ -768,6 +773,9 @@ void GodotNavigationServer::set_active(bool p_active) {
 }
 
 void GodotNavigationServer::flush_queries() {
+	// The path queries read the maps, so they must be done before the commands are executed.
+	_finish_path_queries(true);
+
 	// In c++ we can't be sure that this is performed in the main thread
 	// even with mutable functions.
 	MutexLock lock(commands_mutex);
@@ -846,12 +854,18 @@ PathQueryResult GodotNavigationServer::_query_path(const PathQueryParameters &p_
 	const NavMap *map = map_owner.get_or_null(p_parameters.map);
 	ERR_FAIL_COND_V(map == nullptr, r_query_result);
 
+	_query_map_path(map, p_parameters, r_query_result);
+
+	return r_query_result;
+}
+
+void GodotNavigationServer::_query_map_path(const NavMap *p_map, const PathQueryParameters &p_parameters, PathQueryResult &r_query_result) {
 	// run the pathfinding
 
 	if (p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR) {
 		// while postprocessing is still part of map.get_path() need to check and route it here for the correct "optimize" post-processing
 		if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					true,
@@ -860,7 +874,7 @@ PathQueryResult GodotNavigationServer::_query_path(const PathQueryParameters &p_
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
 		} else if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					false,
@@ -869,15 +883,98 @@ PathQueryResult GodotNavigationServer::_query_path(const PathQueryParameters &p_
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
 		}
-	} else {
-		return r_query_result;
 	}
 
 	// add path postprocessing
 
 	// add path stats
+}
 
-	return r_query_result;
+void GodotNavigationServer::query_paths(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const Callable &p_callback) {
+	ERR_FAIL_COND(!p_callback.is_valid());
+
+	MutexLock lock(operations_mutex);
+
+	PathQueryBatch *batch = memnew(PathQueryBatch);
+	batch->callback = p_callback;
+	batch->maps.resize(p_query_parameters.size());
+	batch->parameters.resize(p_query_parameters.size());
+	batch->results.resize(p_query_parameters.size());
+
+	// The maps are looked up here, the worker threads only read them.
+	for (uint32_t i = 0; i < batch->parameters.size(); i++) {
+		batch->maps[i] = nullptr;
+
+		const Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		ERR_CONTINUE(query_parameters.is_null());
+
+		batch->parameters[i] = query_parameters->get_parameters();
+		batch->maps[i] = map_owner.get_or_null(batch->parameters[i].map);
+		ERR_CONTINUE_MSG(batch->maps[i] == nullptr, "Path query parameters have no valid map.");
+	}
+
+	if (!batch->parameters.is_empty()) {
+		batch->group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer::_process_path_query, batch, batch->parameters.size(), -1, true, SNAME("NavigationServerPathQueries"));
+	}
+	path_query_batches.push_back(batch);
+}
+
+void GodotNavigationServer::_process_path_query(uint32_t p_index, PathQueryBatch *p_batch) {
+	const NavMap *map = p_batch->maps[p_index];
+	if (map) {
+		_query_map_path(map, p_batch->parameters[p_index], p_batch->results[p_index]);
+	}
+}
+
+void GodotNavigationServer::_wait_path_query_batch(PathQueryBatch *p_batch) {
+	if (p_batch->group_task != -1) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(p_batch->group_task);
+		p_batch->group_task = -1;
+	}
+}
+
+void GodotNavigationServer::_finish_path_queries(bool p_deliver_results) {
+	LocalVector<PathQueryBatch *> batches;
+	{
+		MutexLock lock(operations_mutex);
+		batches = path_query_batches;
+		path_query_batches.clear();
+	}
+
+	for (PathQueryBatch *batch : batches) {
+		_wait_path_query_batch(batch);
+
+		if (p_deliver_results) {
+			TypedArray<NavigationPathQueryResult3D> query_results;
+			query_results.resize(batch->results.size());
+			for (uint32_t i = 0; i < batch->results.size(); i++) {
+				const PathQueryResult &result = batch->results[i];
+
+				Ref<NavigationPathQueryResult3D> query_result;
+				query_result.instantiate();
+				query_result->set_path(result.path);
+				query_result->set_path_types(result.path_types);
+				query_result->set_path_rids(result.path_rids);
+				query_result->set_path_owner_ids(result.path_owner_ids);
+				query_results[i] = query_result;
+			}
+
+			Variant args[] = { query_results };
+			const Variant *args_p[] = { &args[0] };
+			Variant return_value;
+			Callable::CallError call_error;
+			batch->callback.callp(args_p, 1, return_value, call_error);
+		}
+
+		memdelete(batch);
+	}
+
+	// The batches queried from the callbacks are delivered on the next
+	// flush, but they must be done before the maps get changed.
+	MutexLock lock(operations_mutex);
+	for (PathQueryBatch *batch : path_query_batches) {
+		_wait_path_query_batch(batch);
+	}
 }
 
 int GodotNavigationServer::get_process_info(ProcessInfo p_info) const {
@@ -31,6 +31,7 @@
 #ifndef GODOT_NAVIGATION_SERVER_H
 #define GODOT_NAVIGATION_SERVER_H
 
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "core/templates/rid_owner.h"
@@ -77,6 +78,22 @@ class GodotNavigationServer : public NavigationServer3D {
 	LocalVector<NavMap *> active_maps;
 	LocalVector<uint32_t> active_maps_update_id;
 
+	/// Path queries resolved in the background, the results are delivered
+	/// on the next flush, before any map is changed.
+	struct PathQueryBatch {
+		LocalVector<const NavMap *> maps;
+		LocalVector<NavigationUtilities::PathQueryParameters> parameters;
+		LocalVector<NavigationUtilities::PathQueryResult> results;
+		Callable callback;
+		WorkerThreadPool::GroupID group_task = -1;
+	};
+	LocalVector<PathQueryBatch *> path_query_batches;
+
+	static void _query_map_path(const NavMap *p_map, const NavigationUtilities::PathQueryParameters &p_parameters, NavigationUtilities::PathQueryResult &r_query_result);
+	void _process_path_query(uint32_t p_index, PathQueryBatch *p_batch);
+	void _wait_path_query_batch(PathQueryBatch *p_batch);
+	void _finish_path_queries(bool p_deliver_results);
+
 	// Performance Monitor
 	int pm_region_count = 0;
 	int pm_agent_count = 0;
@@ -188,6 +205,7 @@ public:
 	virtual void process(real_t p_delta_time) override;
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override;
+	virtual void query_paths(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const Callable &p_callback) override;
 
 	int get_process_info(ProcessInfo p_info) const override;
 };
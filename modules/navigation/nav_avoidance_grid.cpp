@@ -0,0 +1,157 @@
+/**************************************************************************/
+/*  nav_avoidance_grid.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_avoidance_grid.h"
+
+void NavAvoidanceGrid::_insert_in_cell(uint32_t p_index, const Vector3i &p_cell) {
+	Cell *cell = cells.getptr(p_cell);
+	if (!cell) {
+		cell = &cells.insert(p_cell, Cell())->value;
+	}
+	agent_cells[p_index] = p_cell;
+	agent_cell_indices[p_index] = cell->agents.size();
+	cell->agents.push_back(p_index);
+}
+
+void NavAvoidanceGrid::_remove_from_cell(uint32_t p_index) {
+	const Vector3i &key = agent_cells[p_index];
+	Cell *cell = cells.getptr(key);
+	ERR_FAIL_NULL(cell);
+
+	// Swap the last agent of the cell in place of the removed one.
+	const uint32_t index = agent_cell_indices[p_index];
+	const uint32_t last = cell->agents[cell->agents.size() - 1];
+	cell->agents[index] = last;
+	agent_cell_indices[last] = index;
+	cell->agents.resize(cell->agents.size() - 1);
+
+	if (cell->agents.is_empty()) {
+		cells.erase(key);
+	}
+}
+
+void NavAvoidanceGrid::_rebuild_cells() {
+	cells.clear();
+	for (uint32_t i = 0; i < agents.size(); i++) {
+		positions[i] = agents[i]->position_;
+		_insert_in_cell(i, _get_cell(positions[i]));
+	}
+}
+
+float NavAvoidanceGrid::_get_max_neighbor_distance() const {
+	float max_distance = 0.0;
+	for (const RVO::Agent *agent : agents) {
+		max_distance = MAX(max_distance, agent->neighborDist_);
+	}
+	return max_distance;
+}
+
+void NavAvoidanceGrid::set_agents(const LocalVector<RVO::Agent *> &p_agents) {
+	agents = p_agents;
+	positions.resize(agents.size());
+	agent_cells.resize(agents.size());
+	agent_cell_indices.resize(agents.size());
+
+	const float max_distance = _get_max_neighbor_distance();
+	if (max_distance > 0.0) {
+		cell_size = max_distance;
+	}
+	_rebuild_cells();
+}
+
+void NavAvoidanceGrid::update() {
+	// Keep the cells about the size of the largest neighbor distance, so most
+	// searches only have to look at the cells around the agent.
+	const float max_distance = _get_max_neighbor_distance();
+	if (max_distance > 0.0 && (max_distance > cell_size * 2.0 || max_distance < cell_size * 0.5)) {
+		cell_size = max_distance;
+		_rebuild_cells();
+		return;
+	}
+
+	for (uint32_t i = 0; i < agents.size(); i++) {
+		positions[i] = agents[i]->position_;
+		const Vector3i cell = _get_cell(positions[i]);
+		if (cell != agent_cells[i]) {
+			_remove_from_cell(i);
+			_insert_in_cell(i, cell);
+		}
+	}
+}
+
+void NavAvoidanceGrid::clear() {
+	agents.clear();
+	positions.clear();
+	agent_cells.clear();
+	agent_cell_indices.clear();
+	cells.clear();
+}
+
+void NavAvoidanceGrid::compute_agent_neighbors(RVO::Agent *p_agent) const {
+	p_agent->agentNeighbors_.clear();
+	if (p_agent->maxNeighbors_ == 0) {
+		return;
+	}
+
+	const RVO::Vector3 &position = p_agent->position_;
+	const float range = p_agent->neighborDist_;
+	// Shrinks once the agent has found `maxNeighbors_` neighbors.
+	float range_sq = range * range;
+
+	const Vector3i from = _get_cell(position - RVO::Vector3(range, range, range));
+	const Vector3i to = _get_cell(position + RVO::Vector3(range, range, range));
+	const int64_t range_cell_count = int64_t(to.x - from.x + 1) * int64_t(to.y - from.y + 1) * int64_t(to.z - from.z + 1);
+
+	if (range_cell_count > int64_t(cells.size())) {
+		// Less work to check all the agents than all the cells in range.
+		for (uint32_t i = 0; i < agents.size(); i++) {
+			if (agents[i] != p_agent && RVO::absSq(positions[i] - position) < range_sq) {
+				p_agent->insertAgentNeighbor(agents[i], range_sq);
+			}
+		}
+		return;
+	}
+
+	for (int x = from.x; x <= to.x; x++) {
+		for (int y = from.y; y <= to.y; y++) {
+			for (int z = from.z; z <= to.z; z++) {
+				const Cell *cell = cells.getptr(Vector3i(x, y, z));
+				if (!cell) {
+					continue;
+				}
+				for (const uint32_t &index : cell->agents) {
+					if (agents[index] != p_agent && RVO::absSq(positions[index] - position) < range_sq) {
+						p_agent->insertAgentNeighbor(agents[index], range_sq);
+					}
+				}
+			}
+		}
+	}
+}
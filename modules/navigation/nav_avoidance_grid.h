@@ -0,0 +1,84 @@
+/**************************************************************************/
+/*  nav_avoidance_grid.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_AVOIDANCE_GRID_H
+#define NAV_AVOIDANCE_GRID_H
+
+#include "core/math/vector3i.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+#include <Agent.h>
+
+/// Uniform grid used to find the avoidance neighbors of the agents.
+///
+/// Unlike the RVO KdTree, which has to be rebuilt from scratch, the grid is
+/// updated in place: only the agents that moved to another cell are moved in
+/// the grid. The agents are stored as parallel arrays, so the neighbor search
+/// only touches the positions until it finds an agent in range.
+class NavAvoidanceGrid {
+	struct Cell {
+		LocalVector<uint32_t> agents;
+	};
+
+	LocalVector<RVO::Agent *> agents;
+	LocalVector<RVO::Vector3> positions;
+	LocalVector<Vector3i> agent_cells;
+	/// Index of each agent in the list of its cell.
+	LocalVector<uint32_t> agent_cell_indices;
+
+	HashMap<Vector3i, Cell> cells;
+	float cell_size = 1.0;
+
+	_FORCE_INLINE_ Vector3i _get_cell(const RVO::Vector3 &p_position) const {
+		return Vector3i(Math::floor(p_position.x() / cell_size), Math::floor(p_position.y() / cell_size), Math::floor(p_position.z() / cell_size));
+	}
+
+	void _insert_in_cell(uint32_t p_index, const Vector3i &p_cell);
+	void _remove_from_cell(uint32_t p_index);
+	void _rebuild_cells();
+	float _get_max_neighbor_distance() const;
+
+public:
+	/// Replaces the agents of the grid, used when agents are added or removed.
+	void set_agents(const LocalVector<RVO::Agent *> &p_agents);
+	/// Updates the positions of the agents, and the cells of the ones that moved to another cell.
+	void update();
+	void clear();
+
+	uint32_t get_cell_count() const { return cells.size(); }
+	float get_cell_size() const { return cell_size; }
+
+	/// Fills the avoidance neighbors of the agent, like `RVO::Agent::computeNeighbors()`.
+	/// Can be called from multiple threads at once.
+	void compute_agent_neighbors(RVO::Agent *p_agent) const;
+};
+
+#endif // NAV_AVOIDANCE_GRID_H
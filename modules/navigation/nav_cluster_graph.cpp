@@ -0,0 +1,439 @@
+/**************************************************************************/
+/*  nav_cluster_graph.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_cluster_graph.h"
+
+#include "core/templates/sort_array.h"
+#include "nav_region.h"
+
+#define DISTANCE_INFINITY real_t(1e30)
+
+struct NavClusterGraphEntry {
+	real_t cost = 0.0;
+	real_t distance = 0.0;
+	uint32_t id = 0;
+};
+
+struct NavClusterGraphEntrySort {
+	_FORCE_INLINE_ bool operator()(const NavClusterGraphEntry &A, const NavClusterGraphEntry &B) const { // Returns true when the entry A is worse than the entry B.
+		return A.cost > B.cost;
+	}
+};
+
+static _FORCE_INLINE_ real_t _get_connection_distance(const gd::Polygon *p_polygon, const gd::Edge::Connection &p_connection) {
+	const Vector3 pathway_center = (p_connection.pathway_start + p_connection.pathway_end) * 0.5;
+	return p_polygon->center.distance_to(pathway_center) + pathway_center.distance_to(p_connection.polygon->center);
+}
+
+void NavClusterGraph::_add_to_cluster(uint32_t p_cluster, const gd::Polygon *p_polygon) {
+	PolygonInfo info;
+	info.cluster = p_cluster;
+	info.index = clusters[p_cluster].polygons.size();
+	polygons.insert(p_polygon, info);
+	clusters[p_cluster].polygons.push_back(p_polygon);
+}
+
+uint32_t NavClusterGraph::_add_cluster(const NavRegion *p_region, const gd::Polygon *p_polygon) {
+	uint32_t cluster;
+	if (free_clusters.is_empty()) {
+		cluster = clusters.size();
+		clusters.push_back(Cluster());
+	} else {
+		cluster = free_clusters[free_clusters.size() - 1];
+		free_clusters.remove_at(free_clusters.size() - 1);
+	}
+	clusters[cluster].region = p_region;
+	clusters[cluster].used = true;
+	_add_to_cluster(cluster, p_polygon);
+	return cluster;
+}
+
+void NavClusterGraph::_remove_cluster(uint32_t p_cluster) {
+	// The polygons may have been freed already, they are only used as keys here.
+	Cluster &cluster = clusters[p_cluster];
+	for (const gd::Polygon *polygon : cluster.polygons) {
+		polygons.erase(polygon);
+	}
+	cluster = Cluster();
+	free_clusters.push_back(p_cluster);
+}
+
+void NavClusterGraph::_build_region_clusters(const NavRegion *p_region) {
+	// The clusters are grown from the shared edges, so their polygons are connected to each other.
+	LocalVector<uint32_t> &new_clusters = region_clusters[p_region];
+	LocalVector<const gd::Polygon *> queue;
+	for (const gd::Polygon &poly : p_region->get_polygons()) {
+		if (polygons.has(&poly)) {
+			continue;
+		}
+
+		const uint32_t cluster = _add_cluster(p_region, &poly);
+		new_clusters.push_back(cluster);
+		queue.clear();
+		queue.push_back(&poly);
+		for (uint32_t i = 0; i < queue.size() && clusters[cluster].polygons.size() < MAX_CLUSTER_POLYGONS; i++) {
+			for (const gd::Edge &edge : queue[i]->edges) {
+				for (const gd::Edge::Connection &connection : edge.connections) {
+					if (clusters[cluster].polygons.size() >= MAX_CLUSTER_POLYGONS) {
+						break;
+					}
+					if (connection.polygon->owner != p_region || polygons.has(connection.polygon)) {
+						continue;
+					}
+					_add_to_cluster(cluster, connection.polygon);
+					queue.push_back(connection.polygon);
+				}
+			}
+		}
+	}
+}
+
+int32_t NavClusterGraph::_get_node(const gd::Polygon *p_polygon) {
+	PolygonInfo *info = polygons.getptr(p_polygon);
+	ERR_FAIL_NULL_V(info, -1);
+
+	if (info->node == -1) {
+		info->node = nodes.size();
+
+		Node node;
+		node.polygon = p_polygon;
+		node.cluster = info->cluster;
+		node.index = info->index;
+		nodes.push_back(node);
+		clusters[info->cluster].nodes.push_back(info->node);
+	}
+	return info->node;
+}
+
+void NavClusterGraph::_get_cluster_distances(uint32_t p_cluster, const gd::Polygon *p_from, LocalVector<real_t> &r_distances) const {
+	const Cluster &cluster = clusters[p_cluster];
+	r_distances.resize(cluster.polygons.size());
+	for (real_t &distance : r_distances) {
+		distance = DISTANCE_INFINITY;
+	}
+
+	const PolygonInfo *from_info = polygons.getptr(p_from);
+	ERR_FAIL_NULL(from_info);
+
+	// Dijkstra over the polygons of the cluster, from center to center.
+	LocalVector<NavClusterGraphEntry> open_list;
+	SortArray<NavClusterGraphEntry, NavClusterGraphEntrySort> sorter;
+
+	NavClusterGraphEntry begin;
+	begin.id = from_info->index;
+	r_distances[begin.id] = 0.0;
+	open_list.push_back(begin);
+
+	while (!open_list.is_empty()) {
+		const NavClusterGraphEntry current = open_list[0];
+		sorter.pop_heap(0, open_list.size(), open_list.ptr());
+		open_list.remove_at(open_list.size() - 1);
+
+		if (current.cost > r_distances[current.id]) {
+			continue; // Already reached with a shorter distance.
+		}
+
+		const gd::Polygon *polygon = cluster.polygons[current.id];
+		for (const gd::Edge &edge : polygon->edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const PolygonInfo *info = polygons.getptr(connection.polygon);
+				if (!info || info->cluster != p_cluster) {
+					continue;
+				}
+
+				const real_t distance = current.cost + _get_connection_distance(polygon, connection);
+				if (distance < r_distances[info->index]) {
+					r_distances[info->index] = distance;
+
+					NavClusterGraphEntry entry;
+					entry.cost = distance;
+					entry.id = info->index;
+					open_list.push_back(entry);
+					sorter.push_heap(0, open_list.size() - 1, 0, entry, open_list.ptr());
+				}
+			}
+		}
+	}
+}
+
+const LocalVector<real_t> &NavClusterGraph::_get_cached_cluster_distances(uint32_t p_cluster, uint32_t p_index) {
+	LocalVector<real_t> *distances = clusters[p_cluster].distances.getptr(p_index);
+	if (!distances) {
+		distances = &clusters[p_cluster].distances.insert(p_index, LocalVector<real_t>())->value;
+		_get_cluster_distances(p_cluster, clusters[p_cluster].polygons[p_index], *distances);
+	}
+	return *distances;
+}
+
+void NavClusterGraph::update(const LocalVector<NavRegion *> &p_regions, const LocalVector<NavRegion *> &p_changed_regions) {
+	// Link polygons are not part of any region and each one gets its own
+	// cluster, they are cheap to find again from the connections below.
+	for (uint32_t cluster : link_clusters) {
+		_remove_cluster(cluster);
+	}
+	link_clusters.clear();
+
+	// Drop the clusters of the regions that changed or left the map.
+	HashSet<const NavRegion *> current_regions;
+	for (const NavRegion *region : p_regions) {
+		current_regions.insert(region);
+	}
+	LocalVector<const NavRegion *> stale_regions;
+	for (const KeyValue<const NavRegion *, LocalVector<uint32_t>> &E : region_clusters) {
+		if (!current_regions.has(E.key)) {
+			stale_regions.push_back(E.key);
+		}
+	}
+	for (const NavRegion *region : p_changed_regions) {
+		if (region_clusters.has(region)) {
+			stale_regions.push_back(region);
+		}
+	}
+	for (const NavRegion *region : stale_regions) {
+		for (uint32_t cluster : region_clusters[region]) {
+			_remove_cluster(cluster);
+		}
+		region_clusters.erase(region);
+	}
+
+	for (const NavRegion *region : p_regions) {
+		if (!region_clusters.has(region)) {
+			_build_region_clusters(region);
+		}
+	}
+
+	// The connections between the clusters also change around the changed
+	// regions and links, so the nodes are collected again from all of them.
+	for (const Node &node : nodes) {
+		PolygonInfo *info = polygons.getptr(node.polygon);
+		if (info) {
+			info->node = -1;
+		}
+	}
+	nodes.clear();
+	for (Cluster &cluster : clusters) {
+		cluster.nodes.clear();
+	}
+
+	for (const KeyValue<const NavRegion *, LocalVector<uint32_t>> &E : region_clusters) {
+		for (uint32_t cluster : E.value) {
+			for (const gd::Polygon *polygon : clusters[cluster].polygons) {
+				for (const gd::Edge &edge : polygon->edges) {
+					for (const gd::Edge::Connection &connection : edge.connections) {
+						if (!polygons.has(connection.polygon)) {
+							link_clusters.push_back(_add_cluster(nullptr, connection.polygon));
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// The polygons connected to another cluster become the nodes of the graph.
+	for (uint32_t cluster = 0; cluster < clusters.size(); cluster++) {
+		for (uint32_t i = 0; i < clusters[cluster].polygons.size(); i++) {
+			const gd::Polygon *polygon = clusters[cluster].polygons[i];
+			for (const gd::Edge &edge : polygon->edges) {
+				for (const gd::Edge::Connection &connection : edge.connections) {
+					const PolygonInfo *info = polygons.getptr(connection.polygon);
+					if (!info || info->cluster == cluster) {
+						continue;
+					}
+
+					const int32_t from = _get_node(polygon);
+					Edge graph_edge;
+					graph_edge.to = _get_node(connection.polygon);
+					graph_edge.distance = _get_connection_distance(polygon, connection);
+					nodes[from].edges.push_back(graph_edge);
+				}
+			}
+		}
+	}
+
+	// Link the nodes of each cluster with the distance between them, which
+	// only has to be computed for the new clusters and nodes.
+	for (uint32_t cluster = 0; cluster < clusters.size(); cluster++) {
+		if (clusters[cluster].nodes.size() < 2) {
+			continue;
+		}
+
+		for (uint32_t node : clusters[cluster].nodes) {
+			const LocalVector<real_t> &distances = _get_cached_cluster_distances(cluster, nodes[node].index);
+			for (uint32_t other_node : clusters[cluster].nodes) {
+				const real_t distance = distances[nodes[other_node].index];
+				if (other_node == node || distance >= DISTANCE_INFINITY) {
+					continue;
+				}
+
+				Edge graph_edge;
+				graph_edge.to = other_node;
+				graph_edge.distance = distance;
+				nodes[node].edges.push_back(graph_edge);
+			}
+		}
+	}
+}
+
+void NavClusterGraph::clear() {
+	polygons.clear();
+	clusters.clear();
+	free_clusters.clear();
+	region_clusters.clear();
+	link_clusters.clear();
+	nodes.clear();
+}
+
+uint32_t NavClusterGraph::get_polygon_cluster(const gd::Polygon *p_polygon) const {
+	const PolygonInfo *info = polygons.getptr(p_polygon);
+	return info ? info->cluster : UINT32_MAX;
+}
+
+bool NavClusterGraph::find_corridor(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers, HashSet<uint32_t> &r_clusters) const {
+	const PolygonInfo *begin_info = polygons.getptr(p_begin_poly);
+	const PolygonInfo *end_info = polygons.getptr(p_end_poly);
+	if (!begin_info || !end_info || begin_info->cluster == end_info->cluster) {
+		return false;
+	}
+
+	// The begin and end polygons are connected to the nodes of their own cluster.
+	LocalVector<real_t> begin_distances;
+	LocalVector<real_t> end_distances;
+	_get_cluster_distances(begin_info->cluster, p_begin_poly, begin_distances);
+	_get_cluster_distances(end_info->cluster, p_end_poly, end_distances);
+
+	struct SearchState {
+		real_t distance = 0.0;
+		int32_t parent = -1;
+		bool closed = false;
+	};
+
+	// This is an implementation of the A* algorithm on the graph nodes.
+	HashMap<uint32_t, SearchState> states;
+	LocalVector<NavClusterGraphEntry> open_list;
+	SortArray<NavClusterGraphEntry, NavClusterGraphEntrySort> sorter;
+
+	const real_t begin_travel_cost = p_begin_poly->owner->get_travel_cost();
+	const real_t begin_distance = p_begin_point.distance_to(p_begin_poly->center);
+	for (uint32_t node : clusters[begin_info->cluster].nodes) {
+		const real_t distance = begin_distances[nodes[node].index];
+		if (distance >= DISTANCE_INFINITY) {
+			continue;
+		}
+
+		SearchState state;
+		state.distance = (begin_distance + distance) * begin_travel_cost;
+		states.insert(node, state);
+
+		NavClusterGraphEntry entry;
+		entry.distance = state.distance;
+		entry.cost = state.distance + nodes[node].polygon->center.distance_to(p_end_point);
+		entry.id = node;
+		open_list.push_back(entry);
+		sorter.push_heap(0, open_list.size() - 1, 0, entry, open_list.ptr());
+	}
+
+	const real_t end_travel_cost = p_end_poly->owner->get_travel_cost();
+	const real_t end_distance = p_end_poly->center.distance_to(p_end_point);
+	real_t best_distance = DISTANCE_INFINITY;
+	int32_t best_node = -1;
+
+	while (!open_list.is_empty()) {
+		const NavClusterGraphEntry current = open_list[0];
+		sorter.pop_heap(0, open_list.size(), open_list.ptr());
+		open_list.remove_at(open_list.size() - 1);
+
+		if (current.cost >= best_distance) {
+			break;
+		}
+
+		SearchState &state = states[current.id];
+		if (state.closed || current.distance > state.distance) {
+			continue;
+		}
+		state.closed = true;
+
+		const Node &node = nodes[current.id];
+		if (node.cluster == end_info->cluster && end_distances[node.index] < DISTANCE_INFINITY) {
+			const real_t distance = current.distance + (end_distances[node.index] + end_distance) * end_travel_cost;
+			if (distance < best_distance) {
+				best_distance = distance;
+				best_node = current.id;
+			}
+		}
+
+		const NavBase *owner = node.polygon->owner;
+		for (const Edge &edge : node.edges) {
+			const Node &other_node = nodes[edge.to];
+			const NavBase *other_owner = other_node.polygon->owner;
+
+			// Only consider the node if it is in a region or link with compatible layers.
+			if ((p_navigation_layers & other_owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			real_t distance = current.distance + edge.distance * owner->get_travel_cost();
+			if (other_owner != owner) {
+				distance += other_owner->get_enter_cost();
+			}
+
+			SearchState *other_state = states.getptr(edge.to);
+			if (other_state) {
+				if (other_state->closed || distance >= other_state->distance) {
+					continue;
+				}
+				other_state->distance = distance;
+				other_state->parent = current.id;
+			} else {
+				SearchState new_state;
+				new_state.distance = distance;
+				new_state.parent = current.id;
+				states.insert(edge.to, new_state);
+			}
+
+			NavClusterGraphEntry entry;
+			entry.distance = distance;
+			entry.cost = distance + other_node.polygon->center.distance_to(p_end_point);
+			entry.id = edge.to;
+			open_list.push_back(entry);
+			sorter.push_heap(0, open_list.size() - 1, 0, entry, open_list.ptr());
+		}
+	}
+
+	if (best_node == -1) {
+		return false;
+	}
+
+	r_clusters.insert(begin_info->cluster);
+	r_clusters.insert(end_info->cluster);
+	for (int32_t node = best_node; node != -1; node = states[node].parent) {
+		r_clusters.insert(nodes[node].cluster);
+	}
+	return true;
+}
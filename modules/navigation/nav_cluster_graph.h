@@ -0,0 +1,117 @@
+/**************************************************************************/
+/*  nav_cluster_graph.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_CLUSTER_GRAPH_H
+#define NAV_CLUSTER_GRAPH_H
+
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "nav_utils.h"
+
+class NavRegion;
+
+/// Abstract graph used for the hierarchical path-finding (HPA*).
+///
+/// The polygons of each region are grouped in small clusters. The polygons
+/// connected to another cluster are the nodes of the graph, the nodes of
+/// the same cluster are linked with the precomputed distance between them,
+/// so long paths can be found on the clusters before being refined on the
+/// polygons of the clusters along the way.
+class NavClusterGraph {
+	struct PolygonInfo {
+		uint32_t cluster = 0;
+		/// Index of the polygon in its cluster.
+		uint32_t index = 0;
+		/// Graph node of the polygon, if it is connected to another cluster.
+		int32_t node = -1;
+	};
+
+	struct Cluster {
+		/// Region of the polygons, null for the clusters of links.
+		const NavRegion *region = nullptr;
+		LocalVector<const gd::Polygon *> polygons;
+		LocalVector<uint32_t> nodes;
+		/// Distances from a polygon of the cluster to the others, by polygon index. They only change
+		/// with the polygons of the region, so they are kept as long as the cluster exists.
+		HashMap<uint32_t, LocalVector<real_t>> distances;
+		bool used = false;
+	};
+
+	struct Edge {
+		uint32_t to = 0;
+		real_t distance = 0.0;
+	};
+
+	struct Node {
+		const gd::Polygon *polygon = nullptr;
+		uint32_t cluster = 0;
+		/// Index of the polygon in its cluster.
+		uint32_t index = 0;
+		LocalVector<Edge> edges;
+	};
+
+	HashMap<const gd::Polygon *, PolygonInfo> polygons;
+	LocalVector<Cluster> clusters;
+	LocalVector<uint32_t> free_clusters;
+	HashMap<const NavRegion *, LocalVector<uint32_t>> region_clusters;
+	LocalVector<uint32_t> link_clusters;
+	LocalVector<Node> nodes;
+
+	uint32_t _add_cluster(const NavRegion *p_region, const gd::Polygon *p_polygon);
+	void _add_to_cluster(uint32_t p_cluster, const gd::Polygon *p_polygon);
+	void _remove_cluster(uint32_t p_cluster);
+	void _build_region_clusters(const NavRegion *p_region);
+	int32_t _get_node(const gd::Polygon *p_polygon);
+	void _get_cluster_distances(uint32_t p_cluster, const gd::Polygon *p_from, LocalVector<real_t> &r_distances) const;
+	const LocalVector<real_t> &_get_cached_cluster_distances(uint32_t p_cluster, uint32_t p_index);
+
+public:
+	static const uint32_t MAX_CLUSTER_POLYGONS = 64;
+
+	/// Updates the graph after the connections of the map changed. Only the regions in
+	/// `p_changed_regions` (whose polygons were rebuilt) and the ones that are new to the
+	/// graph are clustered again, the clusters of the other regions and their distances are kept.
+	void update(const LocalVector<NavRegion *> &p_regions, const LocalVector<NavRegion *> &p_changed_regions);
+	void clear();
+
+	uint32_t get_cluster_count() const { return clusters.size() - free_clusters.size(); }
+	uint32_t get_node_count() const { return nodes.size(); }
+
+	/// Returns the cluster of the polygon, or `UINT32_MAX` when the polygon is not part of the graph.
+	uint32_t get_polygon_cluster(const gd::Polygon *p_polygon) const;
+
+	/// Finds the clusters a path between the two polygons has to go through.
+	/// Returns false when both polygons are in the same cluster, or when no
+	/// route was found on the graph.
+	bool find_corridor(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers, HashSet<uint32_t> &r_clusters) const;
+};
+
+#endif // NAV_CLUSTER_GRAPH_H
@@ -70,6 +70,31 @@ void NavMap::set_link_connection_radius(float p_link_connection_radius) {
 	regenerate_links = true;
 }
 
+void NavMap::set_path_cache_size(int p_size) {
+	MutexLock lock(path_cache_mutex);
+	path_cache_size = MAX(p_size, 0);
+	path_cache.clear();
+	if (path_cache_size > 0) {
+		path_cache.set_capacity(path_cache_size);
+	}
+}
+
+void NavMap::set_use_avoidance_grid(bool p_enabled) {
+	if (use_avoidance_grid == p_enabled) {
+		return;
+	}
+	use_avoidance_grid = p_enabled;
+	if (!use_avoidance_grid) {
+		avoidance_grid.clear();
+	}
+	agents_dirty = true;
+}
+
+void NavMap::set_use_hierarchical_pathfinding(bool p_enabled) {
+	use_hierarchical_pathfinding = p_enabled;
+	connections_changed = true;
+}
+
 gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 	const int x = int(Math::floor(p_pos.x / cell_size));
 	const int y = int(Math::floor(p_pos.y / cell_size));
@@ -103,30 +128,41 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	float begin_d = 1e20;
 	float end_d = 1e20;
 	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
+	for (const NavRegion *region : regions) {
+		// Skip the regions that can not contain a closer polygon.
+		if ((p_navigation_layers & region->get_navigation_layers()) == 0 || region->get_polygons().is_empty()) {
+			continue;
+		}
+		const AABB &region_bounds = region->get_bounds();
+		if (p_origin.clamp(region_bounds.position, region_bounds.get_end()).distance_to(p_origin) > begin_d && p_destination.clamp(region_bounds.position, region_bounds.get_end()).distance_to(p_destination) > end_d) {
 			continue;
 		}
 
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			float distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
+		for (const gd::Polygon &p : region->get_polygons()) {
+			// Only consider the polygon if it in a region with compatible layers.
+			if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
+				continue;
 			}
 
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
+			// For each face check the distance between the origin/destination
+			for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
+				const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+
+				Vector3 point = face.get_closest_point_to(p_origin);
+				float distance_to_point = point.distance_to(p_origin);
+				if (distance_to_point < begin_d) {
+					begin_d = distance_to_point;
+					begin_poly = &p;
+					begin_point = point;
+				}
+
+				point = face.get_closest_point_to(p_destination);
+				distance_to_point = point.distance_to(p_destination);
+				if (distance_to_point < end_d) {
+					end_d = distance_to_point;
+					end_poly = &p;
+					end_point = point;
+				}
 			}
 		}
 	}
@@ -161,9 +197,46 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
+	// Reuse the path of a previous query between the same polygons and cells.
+	PathCacheKey cache_key;
+	if (path_cache_size > 0) {
+		cache_key.begin_poly = begin_poly;
+		cache_key.end_poly = end_poly;
+		cache_key.begin_key = get_point_key(begin_point);
+		cache_key.end_key = get_point_key(end_point);
+		cache_key.navigation_layers = p_navigation_layers;
+		cache_key.map_update_id = map_update_id;
+		cache_key.flags = (p_optimize ? 1 : 0) | (r_path_types ? 2 : 0) | (r_path_rids ? 4 : 0) | (r_path_owners ? 8 : 0);
+
+		MutexLock lock(path_cache_mutex);
+		const PathCacheEntry *entry = path_cache.getptr(cache_key);
+		if (entry) {
+			if (r_path_types) {
+				*r_path_types = entry->path_types;
+			}
+			if (r_path_rids) {
+				*r_path_rids = entry->path_rids.duplicate();
+			}
+			if (r_path_owners) {
+				*r_path_owners = entry->path_owners;
+			}
+
+			// The cached path went from and to other points of the same cells.
+			Vector<Vector3> path = entry->path;
+			if (path.is_empty()) {
+				return path;
+			}
+			path.write[0] = begin_point;
+			if (entry->reached_end) {
+				path.write[path.size() - 1] = end_point;
+			}
+			return path;
+		}
+	}
+
 	// List of all reachable navigation polys.
 	LocalVector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.reserve(polygons.size() * 0.75);
+	navigation_polys.reserve(pm_polygon_count * 0.75);
 
 	// Add the start polygon to the reachable navigation polygons.
 	gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
@@ -177,6 +250,11 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	List<uint32_t> to_visit;
 	to_visit.push_back(0);
 
+	// With the hierarchical path-finding, the route is first searched on the
+	// cluster graph and only the polygons of the clusters along it are visited.
+	HashSet<uint32_t> corridor_clusters;
+	bool use_corridor = use_hierarchical_pathfinding && cluster_graph.find_corridor(begin_poly, begin_point, end_poly, end_point, p_navigation_layers, corridor_clusters);
+
 	// This is an implementation of the A* algorithm.
 	int least_cost_id = 0;
 	int prev_least_cost_id = -1;
@@ -198,6 +276,10 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					continue;
 				}
 
+				if (use_corridor && !corridor_clusters.has(cluster_graph.get_polygon_cluster(connection.polygon))) {
+					continue;
+				}
+
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				float poly_enter_cost = 0.0;
 				float poly_travel_cost = least_cost_poly.poly->owner->get_travel_cost();
@@ -246,6 +328,24 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		to_visit.erase(least_cost_id);
 
 		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
+		if (to_visit.size() == 0 && use_corridor) {
+			// The End Polygon was not reached along the corridor, search again on all the polygons.
+			use_corridor = false;
+
+			gd::NavigationPoly np = navigation_polys[0];
+			navigation_polys.clear();
+			navigation_polys.push_back(np);
+			to_visit.clear();
+			to_visit.push_back(0);
+			least_cost_id = 0;
+			prev_least_cost_id = -1;
+
+			reachable_end = nullptr;
+			reachable_d = 1e30;
+
+			continue;
+		}
+
 		if (to_visit.size() == 0) {
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
@@ -453,6 +553,24 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	CRASH_COND(r_path_rids && path.size() != r_path_rids->size());
 	CRASH_COND(r_path_owners && path.size() != r_path_owners->size());
 
+	if (path_cache_size > 0) {
+		PathCacheEntry entry;
+		entry.path = path;
+		entry.reached_end = is_reachable;
+		if (r_path_types) {
+			entry.path_types = *r_path_types;
+		}
+		if (r_path_rids) {
+			entry.path_rids = r_path_rids->duplicate();
+		}
+		if (r_path_owners) {
+			entry.path_owners = *r_path_owners;
+		}
+
+		MutexLock lock(path_cache_mutex);
+		path_cache.insert(cache_key, entry);
+	}
+
 	return path;
 }
 
@@ -461,40 +579,42 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 	Vector3 closest_point;
 	real_t closest_point_d = 1e20;
 
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the segment
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			Vector3 inters;
-			if (f.intersects_segment(p_from, p_to, &inters)) {
-				const real_t d = closest_point_d = p_from.distance_to(inters);
-				if (use_collision == false) {
-					closest_point = inters;
-					use_collision = true;
-					closest_point_d = d;
-				} else if (closest_point_d > d) {
-					closest_point = inters;
-					closest_point_d = d;
+	for (const NavRegion *region : regions) {
+		for (const gd::Polygon &p : region->get_polygons()) {
+			// For each face check the distance to the segment
+			for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
+				const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+				Vector3 inters;
+				if (f.intersects_segment(p_from, p_to, &inters)) {
+					const real_t d = closest_point_d = p_from.distance_to(inters);
+					if (use_collision == false) {
+						closest_point = inters;
+						use_collision = true;
+						closest_point_d = d;
+					} else if (closest_point_d > d) {
+						closest_point = inters;
+						closest_point_d = d;
+					}
 				}
 			}
-		}
-
-		if (use_collision == false) {
-			for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
-				Vector3 a, b;
-
-				Geometry3D::get_closest_points_between_segments(
-						p_from,
-						p_to,
-						p.points[point_id].pos,
-						p.points[(point_id + 1) % p.points.size()].pos,
-						a,
-						b);
 
-				const real_t d = a.distance_to(b);
-				if (d < closest_point_d) {
-					closest_point_d = d;
-					closest_point = b;
+			if (use_collision == false) {
+				for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
+					Vector3 a, b;
+
+					Geometry3D::get_closest_points_between_segments(
+							p_from,
+							p_to,
+							p.points[point_id].pos,
+							p.points[(point_id + 1) % p.points.size()].pos,
+							a,
+							b);
+
+					const real_t d = a.distance_to(b);
+					if (d < closest_point_d) {
+						closest_point_d = d;
+						closest_point = b;
+					}
 				}
 			}
 		}
@@ -522,19 +642,19 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 	gd::ClosestPointQueryResult result;
 	real_t closest_point_ds = 1e20;
 
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// For each face check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
-				result.point = inters;
-				result.normal = f.get_plane().normal;
-				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
+	for (const NavRegion *region : regions) {
+		for (const gd::Polygon &p : region->get_polygons()) {
+			// For each face check the distance to the point
+			for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
+				const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+				const Vector3 inters = f.get_closest_point_to(p_point);
+				const real_t ds = inters.distance_squared_to(p_point);
+				if (ds < closest_point_ds) {
+					result.point = inters;
+					result.normal = f.get_plane().normal;
+					result.owner = p.owner->get_self();
+					closest_point_ds = ds;
+				}
 			}
 		}
 	}
@@ -544,27 +664,34 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 
 void NavMap::add_region(NavRegion *p_region) {
 	regions.push_back(p_region);
-	regenerate_links = true;
+	p_region->scratch_polygons();
 }
 
 void NavMap::remove_region(NavRegion *p_region) {
 	int64_t region_index = regions.find(p_region);
 	if (region_index != -1) {
+		// The region may be freed before the next sync, so its polygons are disconnected right away.
+		_remove_region_polygons(p_region);
 		regions.remove_at_unordered(region_index);
-		regenerate_links = true;
 	}
 }
 
 void NavMap::add_link(NavLink *p_link) {
 	links.push_back(p_link);
-	regenerate_links = true;
+	link_connections.insert(p_link, LinkConnection());
+	connections_changed = true;
 }
 
 void NavMap::remove_link(NavLink *p_link) {
 	int64_t link_index = links.find(p_link);
 	if (link_index != -1) {
+		HashMap<NavLink *, LinkConnection>::Iterator link_connection = link_connections.find(p_link);
+		if (link_connection) {
+			_disconnect_link(link_connection->value);
+			link_connections.remove(link_connection);
+		}
 		links.remove_at_unordered(link_index);
-		regenerate_links = true;
+		connections_changed = true;
 	}
 }
 
@@ -604,294 +731,559 @@ void NavMap::remove_agent_as_controlled(NavAgent *agent) {
 	}
 }
 
-void NavMap::sync() {
-	// Performance Monitor
-	int _new_pm_region_count = regions.size();
-	int _new_pm_agent_count = agents.size();
-	int _new_pm_link_count = links.size();
-	int _new_pm_polygon_count = pm_polygon_count;
-	int _new_pm_edge_count = pm_edge_count;
-	int _new_pm_edge_merge_count = pm_edge_merge_count;
-	int _new_pm_edge_connection_count = pm_edge_connection_count;
-	int _new_pm_edge_free_count = pm_edge_free_count;
+static inline gd::EdgeKey _get_edge_key(const gd::Polygon &p_polygon, int p_edge) {
+	return gd::EdgeKey(p_polygon.points[p_edge].key, p_polygon.points[(p_edge + 1) % p_polygon.points.size()].key);
+}
 
-	// Check if we need to update the links.
-	if (regenerate_polygons) {
-		for (NavRegion *region : regions) {
-			region->scratch_polygons();
-		}
-		regenerate_links = true;
+bool NavMap::_regions_overlap(const NavRegion *p_region_a, const NavRegion *p_region_b) const {
+	if (p_region_a->get_polygons().is_empty() || p_region_b->get_polygons().is_empty()) {
+		return false;
 	}
+	return p_region_a->get_bounds().grow(edge_connection_margin).intersects_inclusive(p_region_b->get_bounds());
+}
+
+void NavMap::_update_edge_counts(int p_old_size, int p_new_size) {
+	edge_free_count += (p_new_size == 1 ? 1 : 0) - (p_old_size == 1 ? 1 : 0);
+	edge_merge_count += (p_new_size == 2 ? 1 : 0) - (p_old_size == 2 ? 1 : 0);
+}
+
+void NavMap::_clear_connections() {
+	edge_connections.clear();
+	edge_merge_count = 0;
+	edge_free_count = 0;
+	regions_to_reconnect.clear();
 
 	for (NavRegion *region : regions) {
-		if (region->sync()) {
-			regenerate_links = true;
+		for (gd::Polygon &poly : region->get_polygons()) {
+			for (gd::Edge &edge : poly.edges) {
+				edge.connections.clear();
+			}
 		}
+		region->get_connections().clear();
 	}
 
-	for (NavLink *link : links) {
-		if (link->check_dirty()) {
-			regenerate_links = true;
-		}
+	for (KeyValue<NavLink *, LinkConnection> &E : link_connections) {
+		E.value.polygon.points.clear();
+		E.value.polygon.edges.clear();
+		E.value.start_polygon = nullptr;
+		E.value.end_polygon = nullptr;
+		E.value.search_all = true;
 	}
+}
 
-	if (regenerate_links) {
-		_new_pm_polygon_count = 0;
-		_new_pm_edge_count = 0;
-		_new_pm_edge_merge_count = 0;
-		_new_pm_edge_connection_count = 0;
-		_new_pm_edge_free_count = 0;
+void NavMap::_add_region_polygons(NavRegion *p_region) {
+	// Group the edges per key, connecting the ones that are shared with another polygon.
+	for (gd::Polygon &poly : p_region->get_polygons()) {
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			int next_point = (p + 1) % poly.points.size();
+			gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
 
-		// Remove regions connections.
-		for (NavRegion *region : regions) {
-			region->get_connections().clear();
+			Vector<gd::Edge::Connection> *connections = edge_connections.getptr(ek);
+			if (!connections) {
+				connections = &edge_connections.insert(ek, Vector<gd::Edge::Connection>())->value;
+			}
+			if (connections->size() > 1) {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Attempted to merge a navigation mesh triangle edge with another already-merged edge. This happens when the current `cell_size` is different from the one used to generate the navigation mesh. This will cause navigation problems.");
+				continue;
+			}
+
+			// Add the polygon/edge tuple to this key.
+			gd::Edge::Connection new_connection;
+			new_connection.polygon = &poly;
+			new_connection.edge = p;
+			new_connection.pathway_start = poly.points[p].pos;
+			new_connection.pathway_end = poly.points[next_point].pos;
+			connections->push_back(new_connection);
+			_update_edge_counts(connections->size() - 1, connections->size());
+
+			if (connections->size() == 2) {
+				// Connect edge that are shared in different polygons.
+				gd::Edge::Connection &c1 = connections->write[0];
+				gd::Edge::Connection &c2 = connections->write[1];
+				c1.polygon->edges[c1.edge].connections.push_back(c2);
+				c2.polygon->edges[c2.edge].connections.push_back(c1);
+				// Note: The pathway_start/end are full for those connection and do not need to be modified.
+
+				// The other edge is not free anymore.
+				if (c1.polygon->owner != p_region) {
+					regions_to_reconnect.insert((NavRegion *)c1.polygon->owner);
+				}
+			}
 		}
+	}
 
-		// Resize the polygon count.
-		int count = 0;
-		for (const NavRegion *region : regions) {
-			count += region->get_polygons().size();
+	regions_to_reconnect.insert(p_region);
+}
+
+void NavMap::_remove_region_polygons(NavRegion *p_region) {
+	LocalVector<gd::Polygon> &region_polygons = p_region->get_polygons();
+
+	regions_to_reconnect.erase(p_region);
+	p_region->get_connections().clear();
+	if (region_polygons.is_empty()) {
+		return;
+	}
+
+	// Detach the links that lead to this region, they are searched again on the next sync.
+	for (KeyValue<NavLink *, LinkConnection> &E : link_connections) {
+		LinkConnection &link_connection = E.value;
+		if ((link_connection.start_polygon && link_connection.start_polygon->owner == p_region) || (link_connection.end_polygon && link_connection.end_polygon->owner == p_region)) {
+			_disconnect_link(link_connection);
+			link_connection.start_polygon = nullptr;
+			link_connection.end_polygon = nullptr;
+			link_connection.search_all = true;
 		}
-		polygons.resize(count);
+	}
 
-		// Copy all region polygons in the map.
-		count = 0;
-		for (const NavRegion *region : regions) {
-			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
-			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[count + n] = polygons_source[n];
+	// Remove the edges from their keys, the edges that were shared with this region become free.
+	for (gd::Polygon &poly : region_polygons) {
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			gd::EdgeKey ek = _get_edge_key(poly, p);
+
+			Vector<gd::Edge::Connection> *connections = edge_connections.getptr(ek);
+			if (!connections) {
+				continue;
+			}
+
+			int index = -1;
+			for (int i = 0; i < connections->size(); i++) {
+				if ((*connections)[i].polygon == &poly && (*connections)[i].edge == int(p)) {
+					index = i;
+					break;
+				}
+			}
+			if (index == -1) {
+				continue;
 			}
-			count += region->get_polygons().size();
-		}
 
-		_new_pm_polygon_count = polygons.size();
+			connections->remove_at(index);
+			_update_edge_counts(connections->size() + 1, connections->size());
 
-		// Group all edges per key.
-		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+			if (connections->is_empty()) {
+				edge_connections.erase(ek);
+				continue;
+			}
 
-				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
-				if (!connection) {
-					connections[ek] = Vector<gd::Edge::Connection>();
-					_new_pm_edge_count += 1;
+			for (const gd::Edge::Connection &other : *connections) {
+				Vector<gd::Edge::Connection> &other_connections = other.polygon->edges[other.edge].connections;
+				for (int i = other_connections.size() - 1; i >= 0; i--) {
+					if (other_connections[i].polygon == &poly) {
+						other_connections.remove_at(i);
+					}
 				}
-				if (connections[ek].size() <= 1) {
-					// Add the polygon/edge tuple to this key.
-					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-					connections[ek].push_back(new_connection);
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Attempted to merge a navigation mesh triangle edge with another already-merged edge. This happens when the current `cell_size` is different from the one used to generate the navigation mesh. This will cause navigation problems.");
+				if (other.polygon->owner != p_region) {
+					regions_to_reconnect.insert((NavRegion *)other.polygon->owner);
 				}
 			}
 		}
+	}
 
-		Vector<gd::Edge::Connection> free_edges;
-		for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
-			if (E.value.size() == 2) {
-				// Connect edge that are shared in different polygons.
-				gd::Edge::Connection &c1 = E.value.write[0];
-				gd::Edge::Connection &c2 = E.value.write[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-				_new_pm_edge_merge_count += 1;
-			} else {
-				CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
-				free_edges.push_back(E.value[0]);
-			}
+	// Remove the connections from the nearby free edges.
+	for (NavRegion *region : regions) {
+		if (region != p_region && _regions_overlap(region, p_region)) {
+			_strip_near_connections(region, p_region);
 		}
+	}
 
-		// Find the compatible near edges.
-		//
-		// Note:
-		// Considering that the edges must be compatible (for obvious reasons)
-		// to be connected, create new polygons to remove that small gap is
-		// not really useful and would result in wasteful computation during
-		// connection, integration and path finding.
-		_new_pm_edge_free_count = free_edges.size();
-
-		for (int i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+	for (gd::Polygon &poly : region_polygons) {
+		for (gd::Edge &edge : poly.edges) {
+			edge.connections.clear();
+		}
+	}
 
-			for (int j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
-					continue;
-				}
+	connections_changed = true;
+}
 
-				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
+void NavMap::_strip_near_connections(NavRegion *p_region, const NavRegion *p_to_region) {
+	// Removes the connections between free edges that lead to `p_to_region`, or to any region when null.
+	// The connections of the shared edges and the ones leading to links are kept.
+	for (gd::Polygon &poly : p_region->get_polygons()) {
+		for (uint32_t p = 0; p < poly.edges.size(); p++) {
+			Vector<gd::Edge::Connection> &connections = poly.edges[p].connections;
+			if (connections.is_empty()) {
+				continue;
+			}
 
-				// Compute the projection of the opposite edge on the current one
-				Vector3 edge_vector = edge_p2 - edge_p1;
-				float projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-				float projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+			const gd::EdgeKey ek = _get_edge_key(poly, p);
+			for (int i = connections.size() - 1; i >= 0; i--) {
+				const gd::Edge::Connection &connection = connections[i];
+				if (connection.polygon->owner->get_type() != NavigationUtilities::PathSegmentType::PATH_SEGMENT_TYPE_REGION) {
 					continue;
 				}
-
-				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other1;
-				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-					other1 = other_edge_p1;
-				} else {
-					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other1.distance_to(self1) > edge_connection_margin) {
+				if (p_to_region && connection.polygon->owner != p_to_region) {
 					continue;
 				}
-
-				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other2;
-				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-					other2 = other_edge_p2;
-				} else {
-					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other2.distance_to(self2) > edge_connection_margin) {
+				if (_get_edge_key(*connection.polygon, connection.edge) == ek) {
 					continue;
 				}
+				connections.remove_at(i);
+			}
+		}
+	}
 
-				// The edges can now be connected.
-				gd::Edge::Connection new_connection = other_edge;
-				new_connection.pathway_start = (self1 + other1) / 2.0;
-				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
+	Vector<gd::Edge::Connection> &region_connections = p_region->get_connections();
+	for (int i = region_connections.size() - 1; i >= 0; i--) {
+		if (!p_to_region || region_connections[i].polygon->owner == p_to_region) {
+			region_connections.remove_at(i);
+		}
+	}
+}
 
-				// Add the connection to the region_connection map.
-				((NavRegion *)free_edge.polygon->owner)->get_connections().push_back(new_connection);
-				_new_pm_edge_connection_count += 1;
+void NavMap::_get_free_edges(NavRegion *p_region, LocalVector<gd::Edge::Connection> &r_free_edges) const {
+	for (gd::Polygon &poly : p_region->get_polygons()) {
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			const Vector<gd::Edge::Connection> *connections = edge_connections.getptr(_get_edge_key(poly, p));
+			if (connections && connections->size() == 1) {
+				r_free_edges.push_back((*connections)[0]);
 			}
 		}
+	}
+}
+
+void NavMap::_connect_free_edges(const LocalVector<gd::Edge::Connection> &p_free_edges, const LocalVector<gd::Edge::Connection> &p_other_free_edges) {
+	// Find the compatible near edges.
+	//
+	// Note:
+	// Considering that the edges must be compatible (for obvious reasons)
+	// to be connected, create new polygons to remove that small gap is
+	// not really useful and would result in wasteful computation during
+	// connection, integration and path finding.
+	for (const gd::Edge::Connection &free_edge : p_free_edges) {
+		Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
+		Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+
+		for (const gd::Edge::Connection &other_edge : p_other_free_edges) {
+			Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
+			Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
+
+			// Compute the projection of the opposite edge on the current one
+			Vector3 edge_vector = edge_p2 - edge_p1;
+			float projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
+			float projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
+			if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+				continue;
+			}
 
-		uint32_t link_poly_idx = 0;
-		link_polygons.resize(links.size());
+			// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+			Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
+			Vector3 other1;
+			if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+				other1 = other_edge_p1;
+			} else {
+				other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+			}
+			if (other1.distance_to(self1) > edge_connection_margin) {
+				continue;
+			}
 
-		// Search for polygons within range of a nav link.
-		for (const NavLink *link : links) {
-			const Vector3 start = link->get_start_position();
-			const Vector3 end = link->get_end_position();
+			Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
+			Vector3 other2;
+			if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+				other2 = other_edge_p2;
+			} else {
+				other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+			}
+			if (other2.distance_to(self2) > edge_connection_margin) {
+				continue;
+			}
 
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
-			Vector3 closest_start_point;
+			// The edges can now be connected.
+			gd::Edge::Connection new_connection = other_edge;
+			new_connection.pathway_start = (self1 + other1) / 2.0;
+			new_connection.pathway_end = (self2 + other2) / 2.0;
+			free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
 
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
-			Vector3 closest_end_point;
+			// Add the connection to the region_connection map.
+			((NavRegion *)free_edge.polygon->owner)->get_connections().push_back(new_connection);
+		}
+	}
+}
 
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
+void NavMap::_connect_regions() {
+	// The free edges of the regions to reconnect may have changed, so their
+	// connections are dropped, on both sides, and computed again.
+	for (NavRegion *region : regions_to_reconnect) {
+		_strip_near_connections(region, nullptr);
+		for (NavRegion *other_region : regions) {
+			if (!regions_to_reconnect.has(other_region) && _regions_overlap(region, other_region)) {
+				_strip_near_connections(other_region, region);
+			}
+		}
+	}
 
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
+	// Only the regions that are close enough can have their free edges connected.
+	HashMap<NavRegion *, LocalVector<gd::Edge::Connection>> free_edges;
+	HashSet<NavRegion *> connected_regions;
+	for (NavRegion *region : regions_to_reconnect) {
+		for (NavRegion *other_region : regions) {
+			if (other_region == region || connected_regions.has(other_region) || !_regions_overlap(region, other_region)) {
+				continue;
+			}
 
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
+			if (!free_edges.has(region)) {
+				_get_free_edges(region, free_edges[region]);
+			}
+			if (!free_edges.has(other_region)) {
+				_get_free_edges(other_region, free_edges[other_region]);
 			}
 
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
+			_connect_free_edges(free_edges[region], free_edges[other_region]);
+			_connect_free_edges(free_edges[other_region], free_edges[region]);
+		}
+		connected_regions.insert(region);
+	}
 
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
+	regions_to_reconnect.clear();
+}
+
+void NavMap::_find_link_polygon(const NavRegion *p_region, const Vector3 &p_position, gd::Polygon *&r_polygon, Vector3 &r_point, real_t &r_distance) const {
+	if (p_region->get_polygons().is_empty() || !p_region->get_bounds().grow(link_connection_radius).has_point(p_position)) {
+		return;
+	}
+
+	for (const gd::Polygon &poly : p_region->get_polygons()) {
+		// For each face check the distance to the position.
+		for (uint32_t point_id = 2; point_id < poly.points.size(); point_id += 1) {
+			const Face3 face(poly.points[0].pos, poly.points[point_id - 1].pos, poly.points[point_id].pos);
+			const Vector3 point = face.get_closest_point_to(p_position);
+			const real_t distance = point.distance_to(p_position);
+
+			// Pick the polygon that is within our radius and is closer than anything we've seen yet.
+			if (distance <= link_connection_radius && distance < r_distance) {
+				r_distance = distance;
+				r_point = point;
+				r_polygon = const_cast<gd::Polygon *>(&poly);
 			}
+		}
+	}
+}
 
-			// If we have both a start and end point, then create a synthetic polygon to route through.
-			if (closest_start_polygon && closest_end_polygon) {
-				gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
-				new_polygon.owner = link;
+void NavMap::_connect_link(NavLink *p_link, LinkConnection &p_connection) {
+	// If we have both a start and end point, then create a synthetic polygon to route through.
+	if (!p_connection.start_polygon || !p_connection.end_polygon) {
+		return;
+	}
 
-				new_polygon.edges.clear();
-				new_polygon.edges.resize(4);
-				new_polygon.points.clear();
-				new_polygon.points.reserve(4);
+	gd::Polygon &new_polygon = p_connection.polygon;
+	new_polygon.owner = p_link;
 
-				// Build a set of vertices that create a thin polygon going from the start to the end point.
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+	new_polygon.edges.clear();
+	new_polygon.edges.resize(4);
+	new_polygon.points.clear();
+	new_polygon.points.reserve(4);
 
-				Vector3 center;
-				for (int p = 0; p < 4; ++p) {
-					center += new_polygon.points[p].pos;
-				}
-				new_polygon.center = center / real_t(new_polygon.points.size());
-				new_polygon.clockwise = true;
-
-				// Setup connections to go forward in the link.
-				{
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[0].pos;
-					entry_connection.pathway_end = new_polygon.points[1].pos;
-					closest_start_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_end_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[2].pos;
-					exit_connection.pathway_end = new_polygon.points[3].pos;
-					new_polygon.edges[2].connections.push_back(exit_connection);
-				}
+	// Build a set of vertices that create a thin polygon going from the start to the end point.
+	new_polygon.points.push_back({ p_connection.start_point, get_point_key(p_connection.start_point) });
+	new_polygon.points.push_back({ p_connection.start_point, get_point_key(p_connection.start_point) });
+	new_polygon.points.push_back({ p_connection.end_point, get_point_key(p_connection.end_point) });
+	new_polygon.points.push_back({ p_connection.end_point, get_point_key(p_connection.end_point) });
 
-				// If the link is bi-directional, create connections from the end to the start.
-				if (link->is_bidirectional()) {
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[2].pos;
-					entry_connection.pathway_end = new_polygon.points[3].pos;
-					closest_end_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_start_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[0].pos;
-					exit_connection.pathway_end = new_polygon.points[1].pos;
-					new_polygon.edges[0].connections.push_back(exit_connection);
-				}
+	Vector3 center;
+	for (int p = 0; p < 4; ++p) {
+		center += new_polygon.points[p].pos;
+	}
+	new_polygon.center = center / real_t(new_polygon.points.size());
+	new_polygon.clockwise = true;
+
+	// Setup connections to go forward in the link.
+	{
+		gd::Edge::Connection entry_connection;
+		entry_connection.polygon = &new_polygon;
+		entry_connection.edge = -1;
+		entry_connection.pathway_start = new_polygon.points[0].pos;
+		entry_connection.pathway_end = new_polygon.points[1].pos;
+		p_connection.start_polygon->edges[0].connections.push_back(entry_connection);
+
+		gd::Edge::Connection exit_connection;
+		exit_connection.polygon = p_connection.end_polygon;
+		exit_connection.edge = -1;
+		exit_connection.pathway_start = new_polygon.points[2].pos;
+		exit_connection.pathway_end = new_polygon.points[3].pos;
+		new_polygon.edges[2].connections.push_back(exit_connection);
+	}
+
+	// If the link is bi-directional, create connections from the end to the start.
+	if (p_link->is_bidirectional()) {
+		gd::Edge::Connection entry_connection;
+		entry_connection.polygon = &new_polygon;
+		entry_connection.edge = -1;
+		entry_connection.pathway_start = new_polygon.points[2].pos;
+		entry_connection.pathway_end = new_polygon.points[3].pos;
+		p_connection.end_polygon->edges[0].connections.push_back(entry_connection);
+
+		gd::Edge::Connection exit_connection;
+		exit_connection.polygon = p_connection.start_polygon;
+		exit_connection.edge = -1;
+		exit_connection.pathway_start = new_polygon.points[0].pos;
+		exit_connection.pathway_end = new_polygon.points[1].pos;
+		new_polygon.edges[0].connections.push_back(exit_connection);
+	}
+}
+
+void NavMap::_disconnect_link(LinkConnection &p_connection) {
+	gd::Polygon *link_polygon = &p_connection.polygon;
+	gd::Polygon *ends[2] = { p_connection.start_polygon, p_connection.end_polygon };
+	for (gd::Polygon *end : ends) {
+		if (!end || end->edges.is_empty()) {
+			continue;
+		}
+		Vector<gd::Edge::Connection> &connections = end->edges[0].connections;
+		for (int i = connections.size() - 1; i >= 0; i--) {
+			if (connections[i].polygon == link_polygon) {
+				connections.remove_at(i);
 			}
 		}
+	}
+
+	p_connection.polygon.points.clear();
+	p_connection.polygon.edges.clear();
+}
+
+bool NavMap::_update_link(NavLink *p_link, LinkConnection &p_connection, const LocalVector<NavRegion *> &p_added_regions) {
+	const Vector3 start = p_link->get_start_position();
+	const Vector3 end = p_link->get_end_position();
+
+	gd::Polygon *start_polygon = p_connection.start_polygon;
+	Vector3 start_point = p_connection.start_point;
+	real_t start_distance = p_connection.start_distance;
+
+	gd::Polygon *end_polygon = p_connection.end_polygon;
+	Vector3 end_point = p_connection.end_point;
+	real_t end_distance = p_connection.end_distance;
+
+	// Search for polygons within range of the link, when the link did not
+	// change only the added polygons may be closer than the current ones.
+	const LocalVector<NavRegion *> &search_regions = p_connection.search_all ? regions : p_added_regions;
+	if (p_connection.search_all) {
+		start_polygon = nullptr;
+		start_distance = link_connection_radius;
+		end_polygon = nullptr;
+		end_distance = link_connection_radius;
+	}
+	for (const NavRegion *region : search_regions) {
+		_find_link_polygon(region, start, start_polygon, start_point, start_distance);
+		_find_link_polygon(region, end, end_polygon, end_point, end_distance);
+	}
+
+	if (!p_connection.search_all && start_polygon == p_connection.start_polygon && end_polygon == p_connection.end_polygon) {
+		return false;
+	}
+
+	_disconnect_link(p_connection);
+
+	p_connection.start_polygon = start_polygon;
+	p_connection.start_point = start_point;
+	p_connection.start_distance = start_distance;
+	p_connection.end_polygon = end_polygon;
+	p_connection.end_point = end_point;
+	p_connection.end_distance = end_distance;
+	p_connection.search_all = false;
+
+	_connect_link(p_link, p_connection);
+	return true;
+}
+
+void NavMap::sync() {
+	// Performance Monitor
+	int _new_pm_region_count = regions.size();
+	int _new_pm_agent_count = agents.size();
+	int _new_pm_link_count = links.size();
+	int _new_pm_polygon_count = pm_polygon_count;
+	int _new_pm_edge_count = pm_edge_count;
+	int _new_pm_edge_merge_count = pm_edge_merge_count;
+	int _new_pm_edge_connection_count = pm_edge_connection_count;
+	int _new_pm_edge_free_count = pm_edge_free_count;
+
+	// Check if we need to update the links.
+	if (regenerate_polygons) {
+		for (NavRegion *region : regions) {
+			region->scratch_polygons();
+		}
+		regenerate_links = true;
+	}
+
+	// Only the regions that changed are removed from the connections and
+	// added again, unless everything has to be connected from scratch.
+	LocalVector<NavRegion *> added_regions;
+	if (regenerate_links) {
+		_clear_connections();
+		for (NavRegion *region : regions) {
+			added_regions.push_back(region);
+		}
+	} else {
+		for (NavRegion *region : regions) {
+			if (region->is_dirty()) {
+				_remove_region_polygons(region);
+				added_regions.push_back(region);
+			}
+		}
+	}
+
+	for (NavRegion *region : added_regions) {
+		region->sync();
+	}
+	for (NavRegion *region : added_regions) {
+		_add_region_polygons(region);
+	}
+
+	bool map_changed = regenerate_links || connections_changed || !added_regions.is_empty();
+
+	if (!regions_to_reconnect.is_empty()) {
+		_connect_regions();
+	}
+
+	for (NavLink *link : links) {
+		LinkConnection &link_connection = link_connections[link];
+		if (link->check_dirty()) {
+			link_connection.search_all = true;
+		}
+		if (link_connection.search_all || !added_regions.is_empty()) {
+			map_changed = _update_link(link, link_connection, added_regions) || map_changed;
+		}
+	}
+
+	if (map_changed) {
+		_new_pm_polygon_count = 0;
+		_new_pm_edge_connection_count = 0;
+		for (const NavRegion *region : regions) {
+			_new_pm_polygon_count += region->get_polygons().size();
+			_new_pm_edge_connection_count += region->get_connections_count();
+		}
+		_new_pm_edge_count = edge_connections.size();
+		_new_pm_edge_merge_count = edge_merge_count;
+		_new_pm_edge_free_count = edge_free_count;
+
+		if (use_hierarchical_pathfinding) {
+			cluster_graph.update(regions, added_regions);
+		} else {
+			cluster_graph.clear();
+		}
+
+		// The cached paths can not be hit anymore with the new update ID.
+		if (path_cache_size > 0) {
+			MutexLock lock(path_cache_mutex);
+			path_cache.clear();
+		}
 
 		// Update the update ID.
 		map_update_id = (map_update_id + 1) % 9999999;
 	}
 
 	// Update agents tree.
-	if (agents_dirty) {
+	if (use_avoidance_grid) {
+		if (agents_dirty) {
+			LocalVector<RVO::Agent *> raw_agents;
+			raw_agents.reserve(controlled_agents.size());
+			for (NavAgent *controlled_agent : controlled_agents) {
+				raw_agents.push_back(controlled_agent->get_agent());
+			}
+			avoidance_grid.set_agents(raw_agents);
+		} else {
+			// Only the agents that moved to another cell are moved in the grid.
+			avoidance_grid.update();
+		}
+	} else if (agents_dirty) {
 		// cannot use LocalVector here as RVO library expects std::vector to build KdTree
 		std::vector<RVO::Agent *> raw_agents;
 		raw_agents.reserve(controlled_agents.size());
@@ -903,6 +1295,7 @@ void NavMap::sync() {
 
 	regenerate_polygons = false;
 	regenerate_links = false;
+	connections_changed = false;
 	agents_dirty = false;
 
 	// Performance Monitor
@@ -917,7 +1310,11 @@ void NavMap::sync() {
 }
 
 void NavMap::compute_single_step(uint32_t index, NavAgent **agent) {
-	(*(agent + index))->get_agent()->computeNeighbors(&rvo);
+	if (use_avoidance_grid) {
+		avoidance_grid.compute_agent_neighbors((*(agent + index))->get_agent());
+	} else {
+		(*(agent + index))->get_agent()->computeNeighbors(&rvo);
+	}
 	(*(agent + index))->get_agent()->computeNewVelocity(deltatime);
 }
 
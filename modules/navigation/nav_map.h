@@ -35,7 +35,13 @@
 
 #include "core/math/math_defs.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/lru.h"
 #include "core/templates/rb_map.h"
+#include "core/variant/typed_array.h"
+#include "nav_avoidance_grid.h"
+#include "nav_cluster_graph.h"
 #include "nav_utils.h"
 
 #include <KdTree.h>
@@ -61,19 +67,91 @@ class NavMap : public NavRid {
 	bool regenerate_polygons = true;
 	bool regenerate_links = true;
 
+	/// Set when the connections changed outside of `sync`, e.g. a region got removed.
+	bool connections_changed = false;
+
 	/// Map regions
 	LocalVector<NavRegion *> regions;
 
+	/// Edges of the region polygons grouped per key. This is kept between
+	/// syncs, so only the regions that changed need to be hashed again.
+	HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> edge_connections;
+	int edge_merge_count = 0;
+	int edge_free_count = 0;
+
+	/// Regions whose free edges have to be connected again to the nearby regions.
+	HashSet<NavRegion *> regions_to_reconnect;
+
+	struct LinkConnection {
+		/// Synthetic polygon used to route through the link.
+		gd::Polygon polygon;
+
+		gd::Polygon *start_polygon = nullptr;
+		Vector3 start_point;
+		real_t start_distance = 0.0;
+
+		gd::Polygon *end_polygon = nullptr;
+		Vector3 end_point;
+		real_t end_distance = 0.0;
+
+		/// When set, the link ends are searched again on all the polygons.
+		bool search_all = true;
+	};
+
+	/// Cluster graph used to find long paths faster.
+	bool use_hierarchical_pathfinding = false;
+	NavClusterGraph cluster_graph;
+
+	struct PathCacheKey {
+		const gd::Polygon *begin_poly = nullptr;
+		const gd::Polygon *end_poly = nullptr;
+		gd::PointKey begin_key;
+		gd::PointKey end_key;
+		uint32_t navigation_layers = 0;
+		uint32_t map_update_id = 0;
+		/// The optimization and the requested metadata.
+		uint32_t flags = 0;
+
+		static uint32_t hash(const PathCacheKey &p_key) {
+			uint32_t h = hash_murmur3_one_64((uint64_t)p_key.begin_poly);
+			h = hash_murmur3_one_64((uint64_t)p_key.end_poly, h);
+			h = hash_murmur3_one_64(p_key.begin_key.key, h);
+			h = hash_murmur3_one_64(p_key.end_key.key, h);
+			h = hash_murmur3_one_32(p_key.navigation_layers, h);
+			h = hash_murmur3_one_32(p_key.map_update_id, h);
+			h = hash_murmur3_one_32(p_key.flags, h);
+			return hash_fmix32(h);
+		}
+
+		bool operator==(const PathCacheKey &p_key) const {
+			return begin_poly == p_key.begin_poly && end_poly == p_key.end_poly && begin_key.key == p_key.begin_key.key && end_key.key == p_key.end_key.key && navigation_layers == p_key.navigation_layers && map_update_id == p_key.map_update_id && flags == p_key.flags;
+		}
+	};
+
+	struct PathCacheEntry {
+		Vector<Vector3> path;
+		Vector<int32_t> path_types;
+		TypedArray<RID> path_rids;
+		Vector<int64_t> path_owners;
+		bool reached_end = true;
+	};
+
+	/// Paths of the previous queries, used when `path_cache_size` is not zero.
+	int path_cache_size = 0;
+	mutable Mutex path_cache_mutex;
+	mutable LRUCache<PathCacheKey, PathCacheEntry, PathCacheKey> path_cache;
+
 	/// Map links
 	LocalVector<NavLink *> links;
-	LocalVector<gd::Polygon> link_polygons;
-
-	/// Map polygons
-	LocalVector<gd::Polygon> polygons;
+	HashMap<NavLink *, LinkConnection> link_connections;
 
 	/// Rvo world
 	RVO::KdTree rvo;
 
+	/// Used instead of the KdTree to find the avoidance neighbors, when `use_avoidance_grid` is enabled.
+	bool use_avoidance_grid = false;
+	NavAvoidanceGrid avoidance_grid;
+
 	/// Is agent array modified?
 	bool agents_dirty = false;
 
@@ -123,6 +201,21 @@ public:
 		return link_connection_radius;
 	}
 
+	void set_use_avoidance_grid(bool p_enabled);
+	bool is_using_avoidance_grid() const {
+		return use_avoidance_grid;
+	}
+
+	void set_path_cache_size(int p_size);
+	int get_path_cache_size() const {
+		return path_cache_size;
+	}
+
+	void set_use_hierarchical_pathfinding(bool p_enabled);
+	bool is_using_hierarchical_pathfinding() const {
+		return use_hierarchical_pathfinding;
+	}
+
 	gd::PointKey get_point_key(const Vector3 &p_pos) const;
 
 	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
@@ -173,6 +266,20 @@ public:
 	int get_pm_edge_free_count() const { return pm_edge_free_count; }
 
 private:
+	bool _regions_overlap(const NavRegion *p_region_a, const NavRegion *p_region_b) const;
+	void _update_edge_counts(int p_old_size, int p_new_size);
+	void _clear_connections();
+	void _add_region_polygons(NavRegion *p_region);
+	void _remove_region_polygons(NavRegion *p_region);
+	void _strip_near_connections(NavRegion *p_region, const NavRegion *p_to_region);
+	void _get_free_edges(NavRegion *p_region, LocalVector<gd::Edge::Connection> &r_free_edges) const;
+	void _connect_free_edges(const LocalVector<gd::Edge::Connection> &p_free_edges, const LocalVector<gd::Edge::Connection> &p_other_free_edges);
+	void _connect_regions();
+	void _find_link_polygon(const NavRegion *p_region, const Vector3 &p_position, gd::Polygon *&r_polygon, Vector3 &r_point, real_t &r_distance) const;
+	void _connect_link(NavLink *p_link, LinkConnection &p_connection);
+	void _disconnect_link(LinkConnection &p_connection);
+	bool _update_link(NavLink *p_link, LinkConnection &p_connection, const LocalVector<NavRegion *> &p_added_regions);
+
 	void compute_single_step(uint32_t index, NavAgent **agent);
 	void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
 };
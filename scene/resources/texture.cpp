@@ -676,18 +676,25 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 				continue;
 			}
 
-			Vector<uint8_t> pv;
-			pv.resize(size);
-			{
-				uint8_t *wr = pv.ptrw();
-				f->get_buffer(wr, size);
-			}
-
 			Ref<Image> img;
-			if (data_format == DATA_FORMAT_PNG && Image::png_unpacker) {
-				img = Image::png_unpacker(pv);
-			} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker) {
-				img = Image::webp_unpacker(pv);
+			const uint8_t *mapped = (data_format == DATA_FORMAT_PNG && Image::_png_mem_loader_func) ? f->get_mapped_buffer(size) : nullptr;
+			if (mapped) {
+				// Decode straight from the memory mapped pack, skipping the "PNG " prefix.
+				ERR_FAIL_COND_V(size < 4 || mapped[0] != 'P' || mapped[1] != 'N' || mapped[2] != 'G' || mapped[3] != ' ', Ref<Image>());
+				img = Image::_png_mem_loader_func(mapped + 4, size - 4);
+			} else {
+				Vector<uint8_t> pv;
+				pv.resize(size);
+				{
+					uint8_t *wr = pv.ptrw();
+					f->get_buffer(wr, size);
+				}
+
+				if (data_format == DATA_FORMAT_PNG && Image::png_unpacker) {
+					img = Image::png_unpacker(pv);
+				} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker) {
+					img = Image::webp_unpacker(pv);
+				}
 			}
 
 			if (img.is_null() || img->is_empty()) {
@@ -60,21 +60,35 @@ void GodotBodyPair3D::contact_added_callback(const Vector3 &p_point_A, int p_ind
 	contact.used = true;
 
 	// Attempt to determine if the contact will be reused.
+	// Pick the closest previous contact, so nearby contacts don't swap their accumulated impulses.
 	real_t contact_recycle_radius = space->get_contact_recycle_radius();
+	real_t contact_recycle_radius2 = contact_recycle_radius * contact_recycle_radius;
 
+	int recycle_index = -1;
+	real_t recycle_distance = 0.0;
 	for (int i = 0; i < contact_count; i++) {
-		Contact &c = contacts[i];
-		if (c.local_A.distance_squared_to(local_A) < (contact_recycle_radius * contact_recycle_radius) &&
-				c.local_B.distance_squared_to(local_B) < (contact_recycle_radius * contact_recycle_radius)) {
-			contact.acc_normal_impulse = c.acc_normal_impulse;
-			contact.acc_bias_impulse = c.acc_bias_impulse;
-			contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
-			contact.acc_tangent_impulse = c.acc_tangent_impulse;
-			c = contact;
-			return;
+		const Contact &c = contacts[i];
+		real_t distance_A = c.local_A.distance_squared_to(local_A);
+		real_t distance_B = c.local_B.distance_squared_to(local_B);
+		if (distance_A < contact_recycle_radius2 && distance_B < contact_recycle_radius2) {
+			if (recycle_index == -1 || distance_A + distance_B < recycle_distance) {
+				recycle_index = i;
+				recycle_distance = distance_A + distance_B;
+			}
 		}
 	}
 
+	if (recycle_index != -1) {
+		// Keep the accumulated impulses for warm starting.
+		Contact &c = contacts[recycle_index];
+		contact.acc_normal_impulse = c.acc_normal_impulse;
+		contact.acc_bias_impulse = c.acc_bias_impulse;
+		contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
+		contact.acc_tangent_impulse = c.acc_tangent_impulse;
+		c = contact;
+		return;
+	}
+
 	// Figure out if the contact amount must be reduced to fit the new contact.
 	if (new_index == MAX_CONTACTS) {
 		// Remove the contact with the minimum depth.
@@ -247,6 +261,33 @@ bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A,
 	return true;
 }
 
+bool GodotBodyPair3D::NarrowphaseCache::matches(const GodotShape3D *p_shape_A, const Transform3D &p_xform_A, const GodotShape3D *p_shape_B, const Transform3D &p_xform_B, real_t p_tolerance) const {
+	if (!valid || shape_A != p_shape_A || shape_B != p_shape_B || shape_version_A != p_shape_A->get_version() || shape_version_B != p_shape_B->get_version()) {
+		return false;
+	}
+
+	// The solver only depends on where B is relative to A, so bodies moving together still hit.
+	// Bound how far any point of B moved by the origin delta plus the basis delta over its extents.
+	Transform3D relative = p_xform_A.affine_inverse() * p_xform_B;
+	const AABB &aabb_B = p_shape_B->get_aabb();
+	Vector3 extents_B = aabb_B.position.abs().max(aabb_B.get_end().abs());
+	real_t drift = (relative.origin - relative_xform.origin).length();
+	for (int i = 0; i < 3; i++) {
+		drift += (relative.basis.get_column(i) - relative_xform.basis.get_column(i)).length() * extents_B[i];
+	}
+	return drift <= p_tolerance;
+}
+
+void GodotBodyPair3D::NarrowphaseCache::store(const GodotShape3D *p_shape_A, const Transform3D &p_xform_A, const GodotShape3D *p_shape_B, const Transform3D &p_xform_B, bool p_collided) {
+	relative_xform = p_xform_A.affine_inverse() * p_xform_B;
+	shape_A = p_shape_A;
+	shape_B = p_shape_B;
+	shape_version_A = p_shape_A->get_version();
+	shape_version_B = p_shape_B->get_version();
+	collided = p_collided;
+	valid = true;
+}
+
 real_t combine_bounce(GodotBody3D *A, GodotBody3D *B) {
 	return CLAMP(A->get_bounce() + B->get_bounce(), 0, 1);
 }
@@ -260,6 +301,7 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 
 	if (!A->interacts_with(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
 		collided = false;
+		narrowphase_cache.valid = false;
 		return false;
 	}
 
@@ -272,6 +314,7 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 			report_contacts_only = true;
 		} else {
 			collided = false;
+			narrowphase_cache.valid = false;
 			return false;
 		}
 	}
@@ -291,7 +334,19 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 	GodotShape3D *shape_A_ptr = A->get_shape(shape_A);
 	GodotShape3D *shape_B_ptr = B->get_shape(shape_B);
 
-	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+	// Keep the drift of a cached result well below the penetration the solver allows anyway.
+	real_t narrowphase_tolerance = space->get_contact_max_allowed_penetration() * 0.1;
+	if (narrowphase_cache.matches(shape_A_ptr, xform_A, shape_B_ptr, xform_B, narrowphase_tolerance)) {
+		collided = narrowphase_cache.collided;
+		for (int i = 0; i < contact_count; i++) {
+			// Same as recycling the contact in contact_added_callback().
+			contacts[i].acc_impulse = Vector3();
+			contacts[i].used = true;
+		}
+	} else {
+		collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+		narrowphase_cache.store(shape_A_ptr, xform_A, shape_B_ptr, xform_B, collided);
+	}
 
 	if (!collided) {
 		if (A->is_continuous_collision_detection_enabled() && collide_A) {
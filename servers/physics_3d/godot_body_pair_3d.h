@@ -65,12 +65,36 @@ protected:
 
 	GodotSpace3D *space = nullptr;
 
+	// Static bodies are not part of an island, so pairs of different islands can report contacts to the same one.
+	_FORCE_INLINE_ static bool _is_shared_contact_reporter(const GodotBody3D *p_body) {
+		return p_body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC && p_body->can_report_contacts();
+	}
+
 	GodotBodyContact3D(GodotBody3D **p_body_ptr = nullptr, int p_body_count = 0) :
 			GodotConstraint3D(p_body_ptr, p_body_count) {
 	}
 };
 
 class GodotBodyPair3D : public GodotBodyContact3D {
+public:
+	// Narrowphase input from the last setup. While the shapes stay the same and B barely moves relative
+	// to A, the collision solver would only generate the same contacts again, so the current ones are
+	// kept instead (e.g. for resting bodies). Their depths are still updated from the actual transforms.
+	struct NarrowphaseCache {
+		Transform3D relative_xform;
+		const GodotShape3D *shape_A = nullptr;
+		const GodotShape3D *shape_B = nullptr;
+		uint64_t shape_version_A = 0;
+		uint64_t shape_version_B = 0;
+		bool collided = false;
+		bool valid = false;
+
+		// Hits when no point of shape B moved further than the tolerance relative to shape A since store().
+		bool matches(const GodotShape3D *p_shape_A, const Transform3D &p_xform_A, const GodotShape3D *p_shape_B, const Transform3D &p_xform_B, real_t p_tolerance) const;
+		void store(const GodotShape3D *p_shape_A, const Transform3D &p_xform_A, const GodotShape3D *p_shape_B, const Transform3D &p_xform_B, bool p_collided);
+	};
+
+private:
 	enum {
 		MAX_CONTACTS = 4
 	};
@@ -97,6 +121,8 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	NarrowphaseCache narrowphase_cache;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
@@ -109,6 +135,8 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual bool is_pre_solve_thread_safe() const override { return !_is_shared_contact_reporter(A) && !_is_shared_contact_reporter(B); }
+
 	GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B);
 	~GodotBodyPair3D();
 };
@@ -140,6 +168,8 @@ public:
 	virtual GodotSoftBody3D *get_soft_body_ptr(int p_index) const override { return soft_body; }
 	virtual int get_soft_body_count() const override { return 1; }
 
+	virtual bool is_pre_solve_thread_safe() const override { return !_is_shared_contact_reporter(body); }
+
 	GodotBodySoftBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotSoftBody3D *p_B);
 	~GodotBodySoftBodyPair3D();
 };
@@ -687,6 +687,13 @@ public:
 		return true;
 	}
 
+	// Keeps a separating axis found by a quick test, so the next test_previous_axis() rejects the pair right away.
+	_FORCE_INLINE_ void set_previous_axis(const Vector3 &p_axis) {
+		if (callback && callback->prev_axis) {
+			*callback->prev_axis = p_axis;
+		}
+	}
+
 	static _FORCE_INLINE_ void test_contact_points(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
 		SeparatorAxisTest<ShapeA, ShapeB, withMargin> *separator = (SeparatorAxisTest<ShapeA, ShapeB, withMargin> *)p_userdata;
 		Vector3 axis = (p_point_B - p_point_A);
@@ -1068,6 +1075,149 @@ static void _collision_sphere_face(const GodotShape3D *p_a, const Transform3D &p
 	separator.generate_contacts();
 }
 
+// Quick rejection tests for the most common primitive pairs, run before the full SAT.
+// They only use the box face and edge axes, with the relative rotation computed once, instead of
+// projecting both shapes through project_range() for every axis. They are conservative as long as
+// the bases are orthogonal: when they report a separation, the full SAT would have found one too.
+// With skewed bases the extents along a column don't bound the shape, so they leave it to the SAT.
+
+#define _BOX_SEPARATION_EPSILON 1e-5
+
+// Normalizes the columns of the basis into the axes and scales, fails if they aren't orthogonal.
+static _FORCE_INLINE_ bool _get_orthogonal_axes(const Basis &p_basis, Vector3 r_axes[3], real_t r_scales[3]) {
+	for (int i = 0; i < 3; i++) {
+		r_axes[i] = p_basis.get_column(i);
+		r_scales[i] = r_axes[i].length();
+		if (r_scales[i] <= 0.0) {
+			return false;
+		}
+		r_axes[i] /= r_scales[i];
+	}
+	return Math::abs(r_axes[0].dot(r_axes[1])) < _BOX_SEPARATION_EPSILON && Math::abs(r_axes[0].dot(r_axes[2])) < _BOX_SEPARATION_EPSILON && Math::abs(r_axes[1].dot(r_axes[2])) < _BOX_SEPARATION_EPSILON;
+}
+
+template <bool withMargin>
+static _FORCE_INLINE_ bool _box_box_separated(const GodotBoxShape3D *p_box_A, const Transform3D &p_transform_a, const GodotBoxShape3D *p_box_B, const Transform3D &p_transform_b, real_t p_margin_a, real_t p_margin_b, Vector3 &r_axis) {
+	Vector3 axes_A[3];
+	Vector3 axes_B[3];
+	real_t extents_A[3];
+	real_t extents_B[3];
+	if (!_get_orthogonal_axes(p_transform_a.basis, axes_A, extents_A) || !_get_orthogonal_axes(p_transform_b.basis, axes_B, extents_B)) {
+		return false;
+	}
+	for (int i = 0; i < 3; i++) {
+		extents_A[i] *= p_box_A->get_half_extents()[i];
+		extents_B[i] *= p_box_B->get_half_extents()[i];
+	}
+
+	// Margins are added in full on every axis, which is conservative for the edge axes.
+	const real_t margin = withMargin ? p_margin_a + p_margin_b : 0.0;
+
+	// Rotation of B relative to A, and translation expressed in the frame of A.
+	real_t rot[3][3];
+	real_t abs_rot[3][3];
+	real_t t[3];
+	Vector3 translation = p_transform_b.origin - p_transform_a.origin;
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			rot[i][j] = axes_A[i].dot(axes_B[j]);
+			// Epsilon keeps near parallel edges (with a degenerate cross product) from reporting a false separation.
+			abs_rot[i][j] = Math::abs(rot[i][j]) + _BOX_SEPARATION_EPSILON;
+		}
+		t[i] = translation.dot(axes_A[i]);
+	}
+
+	// Faces of A.
+	for (int i = 0; i < 3; i++) {
+		real_t radius_B = extents_B[0] * abs_rot[i][0] + extents_B[1] * abs_rot[i][1] + extents_B[2] * abs_rot[i][2];
+		if (Math::abs(t[i]) > extents_A[i] + radius_B + margin) {
+			r_axis = axes_A[i];
+			return true;
+		}
+	}
+
+	// Faces of B.
+	for (int j = 0; j < 3; j++) {
+		real_t radius_A = extents_A[0] * abs_rot[0][j] + extents_A[1] * abs_rot[1][j] + extents_A[2] * abs_rot[2][j];
+		real_t distance = t[0] * rot[0][j] + t[1] * rot[1][j] + t[2] * rot[2][j];
+		if (Math::abs(distance) > radius_A + extents_B[j] + margin) {
+			r_axis = axes_B[j];
+			return true;
+		}
+	}
+
+	// Combined edges.
+	for (int i = 0; i < 3; i++) {
+		const int i1 = (i + 1) % 3;
+		const int i2 = (i + 2) % 3;
+		for (int j = 0; j < 3; j++) {
+			const int j1 = (j + 1) % 3;
+			const int j2 = (j + 2) % 3;
+			real_t radius_A = extents_A[i1] * abs_rot[i2][j] + extents_A[i2] * abs_rot[i1][j];
+			real_t radius_B = extents_B[j1] * abs_rot[i][j2] + extents_B[j2] * abs_rot[i][j1];
+			real_t distance = t[i2] * rot[i1][j] - t[i1] * rot[i2][j];
+			if (Math::abs(distance) > radius_A + radius_B + margin) {
+				r_axis = axes_A[i].cross(axes_B[j]).normalized();
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+template <bool withMargin>
+static _FORCE_INLINE_ bool _box_capsule_separated(const GodotBoxShape3D *p_box_A, const Transform3D &p_transform_a, const GodotCapsuleShape3D *p_capsule_B, const Transform3D &p_transform_b, real_t p_margin_a, real_t p_margin_b, Vector3 &r_axis) {
+	Vector3 axes_A[3];
+	real_t extents_A[3];
+	Vector3 axes_B[3];
+	real_t scales_B[3];
+	if (!_get_orthogonal_axes(p_transform_a.basis, axes_A, extents_A) || !_get_orthogonal_axes(p_transform_b.basis, axes_B, scales_B)) {
+		return false;
+	}
+	for (int i = 0; i < 3; i++) {
+		extents_A[i] *= p_box_A->get_half_extents()[i];
+	}
+
+	// Same capsule segment as the other capsule tests, the radius uses the largest scale to stay conservative.
+	Vector3 capsule_half_axis = p_transform_b.basis.get_column(1) * (p_capsule_B->get_height() * 0.5 - p_capsule_B->get_radius());
+	real_t capsule_scale = MAX(scales_B[0], MAX(scales_B[1], scales_B[2]));
+	real_t capsule_radius = p_capsule_B->get_radius() * capsule_scale;
+	if (withMargin) {
+		capsule_radius += p_margin_a + p_margin_b;
+	}
+
+	Vector3 translation = p_transform_b.origin - p_transform_a.origin;
+
+	// Faces of A.
+	for (int i = 0; i < 3; i++) {
+		real_t radius_B = Math::abs(capsule_half_axis.dot(axes_A[i])) + capsule_radius;
+		if (Math::abs(translation.dot(axes_A[i])) > extents_A[i] + radius_B) {
+			r_axis = axes_A[i];
+			return true;
+		}
+	}
+
+	// Edges of A against the capsule cylinder. The axes aren't normalized, so project the capsule radius
+	// with the axis length. The segment itself is perpendicular to them.
+	Vector3 capsule_axis = capsule_half_axis.normalized();
+	for (int i = 0; i < 3; i++) {
+		Vector3 axis = axes_A[i].cross(capsule_axis);
+		real_t axis_length_squared = axis.length_squared();
+		if (axis_length_squared < _BOX_SEPARATION_EPSILON) {
+			continue; // Parallel, already covered by the faces of A.
+		}
+		real_t radius_A = extents_A[0] * Math::abs(axes_A[0].dot(axis)) + extents_A[1] * Math::abs(axes_A[1].dot(axis)) + extents_A[2] * Math::abs(axes_A[2].dot(axis));
+		real_t radius_B = capsule_radius * Math::sqrt(axis_length_squared);
+		if (Math::abs(translation.dot(axis)) > radius_A + radius_B + _BOX_SEPARATION_EPSILON) {
+			r_axis = axis / Math::sqrt(axis_length_squared);
+			return true;
+		}
+	}
+
+	return false;
+}
+
 template <bool withMargin>
 static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_transform_a, const GodotShape3D *p_b, const Transform3D &p_transform_b, _CollectorCallback *p_collector, real_t p_margin_a, real_t p_margin_b) {
 	const GodotBoxShape3D *box_A = static_cast<const GodotBoxShape3D *>(p_a);
@@ -1079,6 +1229,12 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 		return;
 	}
 
+	Vector3 quick_axis;
+	if (_box_box_separated<withMargin>(box_A, p_transform_a, box_B, p_transform_b, p_margin_a, p_margin_b, quick_axis)) {
+		separator.set_previous_axis(quick_axis);
+		return;
+	}
+
 	// test faces of A
 
 	for (int i = 0; i < 3; i++) {
@@ -1177,6 +1333,12 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 		return;
 	}
 
+	Vector3 quick_axis;
+	if (_box_capsule_separated<withMargin>(box_A, p_transform_a, capsule_B, p_transform_b, p_margin_a, p_margin_b, quick_axis)) {
+		separator.set_previous_axis(quick_axis);
+		return;
+	}
+
 	// faces of A
 	for (int i = 0; i < 3; i++) {
 		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
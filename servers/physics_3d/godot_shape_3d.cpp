@@ -61,6 +61,7 @@ constexpr double cylinder_face_support_threshold = 0.999;
 void GodotShape3D::configure(const AABB &p_aabb) {
 	aabb = p_aabb;
 	configured = true;
+	version++;
 	for (const KeyValue<GodotShapeOwner3D *, int> &E : owners) {
 		GodotShapeOwner3D *co = const_cast<GodotShapeOwner3D *>(E.key);
 		co->_shape_changed();
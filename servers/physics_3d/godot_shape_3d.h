@@ -49,6 +49,7 @@ class GodotShape3D {
 	RID self;
 	AABB aabb;
 	bool configured = false;
+	uint64_t version = 0;
 	real_t custom_bias = 0.0;
 
 	HashMap<GodotShapeOwner3D *, int> owners;
@@ -73,6 +74,7 @@ public:
 
 	_FORCE_INLINE_ const AABB &get_aabb() const { return aabb; }
 	_FORCE_INLINE_ bool is_configured() const { return configured; }
+	_FORCE_INLINE_ uint64_t get_version() const { return version; } // Changes every time the shape data is set.
 
 	virtual bool is_concave() const { return false; }
 
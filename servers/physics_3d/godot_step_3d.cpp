@@ -117,12 +117,34 @@ void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdat
 	constraint->setup(delta);
 }
 
-void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const {
+void GodotStep3D::_pre_solve_island(uint32_t p_island_index, void *p_userdata) {
+	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
+	bool has_deferred = false;
+
+	uint32_t constraint_count = constraint_island.size();
+	uint32_t valid_constraint_count = 0;
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		GodotConstraint3D *constraint = constraint_island[constraint_index];
+		if (!pre_solve_single_threaded && !constraint->is_pre_solve_thread_safe()) {
+			// Keep it for now, it's pre-solved later by _pre_solve_island_deferred.
+			constraint_island[valid_constraint_count++] = constraint;
+			has_deferred = true;
+		} else if (constraint->pre_solve(delta)) {
+			// Keep this constraint for solving.
+			constraint_island[valid_constraint_count++] = constraint;
+		}
+	}
+	constraint_island.resize(valid_constraint_count);
+
+	island_has_deferred_pre_solve[p_island_index] = has_deferred;
+}
+
+void GodotStep3D::_pre_solve_island_deferred(LocalVector<GodotConstraint3D *> &p_constraint_island) const {
 	uint32_t constraint_count = p_constraint_island.size();
 	uint32_t valid_constraint_count = 0;
 	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
 		GodotConstraint3D *constraint = p_constraint_island[constraint_index];
-		if (p_constraint_island[constraint_index]->pre_solve(delta)) {
+		if (constraint->is_pre_solve_thread_safe() || constraint->pre_solve(delta)) {
 			// Keep this constraint for solving.
 			p_constraint_island[valid_constraint_count++] = constraint;
 		}
@@ -130,8 +152,8 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
-void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
-	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
+void GodotStep3D::_solve_island(uint32_t p_solve_index, void *p_userdata) {
+	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_solve_order[p_solve_index].island_index];
 
 	int current_priority = 1;
 
@@ -355,16 +377,45 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
-	// Warning: This doesn't run on threads, because it involves thread-unsafe processing.
-	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
+	island_has_deferred_pre_solve.resize(island_count);
+
+	// Debug contacts are added to the space, so they can only be collected from a single thread.
+	pre_solve_single_threaded = p_space->is_debugging_contacts();
+	if (pre_solve_single_threaded) {
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			_pre_solve_island(island_index);
+		}
+	} else {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_pre_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintPreSolveIslands"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		// Warning: This doesn't run on threads, because it involves thread-unsafe processing.
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			if (island_has_deferred_pre_solve[island_index]) {
+				_pre_solve_island_deferred(constraint_islands[island_index]);
+			}
+		}
 	}
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
+	// Islands are independent, so the order they are solved in doesn't change the result.
+	// Start with the largest ones, so a big island picked up last doesn't leave the other threads idle.
+	island_solve_order.clear();
+	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+		uint32_t constraint_count = constraint_islands[island_index].size();
+		if (constraint_count > 0) {
+			IslandSolveOrder order;
+			order.constraint_count = constraint_count;
+			order.island_index = island_index;
+			island_solve_order.push_back(order);
+		}
+	}
+	island_solve_order.sort();
+
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_solve_order.size(), -1, true, SNAME("Physics3DConstraintSolveIslands"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -411,6 +462,8 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 GodotStep3D::GodotStep3D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
+	island_has_deferred_pre_solve.reserve(ISLAND_COUNT_RESERVE);
+	island_solve_order.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
 }
 
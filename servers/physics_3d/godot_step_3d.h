@@ -45,11 +45,29 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
+	struct IslandSolveOrder {
+		uint32_t constraint_count = 0;
+		uint32_t island_index = 0;
+
+		// Largest islands first, ties keep the island order so solving stays deterministic.
+		bool operator<(const IslandSolveOrder &p_other) const {
+			if (constraint_count != p_other.constraint_count) {
+				return constraint_count > p_other.constraint_count;
+			}
+			return island_index < p_other.island_index;
+		}
+	};
+
+	LocalVector<bool> island_has_deferred_pre_solve;
+	LocalVector<IslandSolveOrder> island_solve_order;
+	bool pre_solve_single_threaded = false;
+
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
-	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
-	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _pre_solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _pre_solve_island_deferred(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
+	void _solve_island(uint32_t p_solve_index, void *p_userdata = nullptr);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
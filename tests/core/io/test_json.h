@@ -32,6 +32,7 @@
 #define TEST_JSON_H
 
 #include "core/io/json.h"
+#include "core/io/json_reader.h"
 
 #include "thirdparty/doctest/doctest.h"
 
@@ -146,6 +147,98 @@ TEST_CASE("[JSON] Parsing objects (dictionaries)") {
 			dictionary["empty_object"].hash() == Dictionary().hash(),
 			"The parsed JSON should contain the expected values.");
 }
+
+TEST_CASE("[JSON] Parsing strings with escapes") {
+	JSON json;
+
+	json.parse(String::utf8(R"(["plain", "line\nbreak", "\"quoted\" été 😀", ""])"));
+
+	const Array array = json.get_data();
+	CHECK_MESSAGE(
+			array.size() == 4,
+			"The parsed JSON should contain the expected number of values.");
+	CHECK_MESSAGE(
+			array[0] == "plain",
+			"The parsed JSON should contain the expected values.");
+	CHECK_MESSAGE(
+			array[1] == "line\nbreak",
+			"Escaped characters should be decoded.");
+	CHECK_MESSAGE(
+			array[2] == String::utf8("\"quoted\" été 😀"),
+			"Escaped Unicode characters should be decoded.");
+	CHECK_MESSAGE(
+			array[3] == "",
+			"The parsed JSON should contain the expected values.");
+}
+
+TEST_CASE("[JSONReader] Reading tokens") {
+	Ref<JSONReader> reader;
+	reader.instantiate();
+	const String text = R"({"name": "Godot", "tags": ["engine", 4.1], "skipped": {"a": [1, "]}"]}, "nested": {"ok": true, "none": null}})";
+	reader->open_buffer(text.to_utf8_buffer());
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_OBJECT_BEGIN);
+	CHECK(reader->get_depth() == 1);
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_KEY);
+	CHECK(reader->get_value() == "name");
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_VALUE);
+	CHECK(reader->get_value() == "Godot");
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_value() == "tags");
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_ARRAY_BEGIN);
+	CHECK(reader->get_depth() == 2);
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_value() == "engine");
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_value() == Variant(4.1));
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_ARRAY_END);
+	CHECK(reader->get_depth() == 1);
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_value() == "skipped");
+	reader->skip_section();
+	CHECK_MESSAGE(
+			reader->get_token_type() == JSONReader::TOKEN_OBJECT_END,
+			"Skipping should stop at the end of the skipped object, ignoring brackets in strings.");
+	CHECK(reader->get_depth() == 1);
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_value() == "nested");
+	const Dictionary nested = reader->read_value();
+	CHECK_MESSAGE(
+			nested.size() == 2,
+			"Reading a value should build the whole object.");
+	CHECK(bool(nested["ok"]));
+	CHECK(nested["none"] == Variant());
+	CHECK(reader->get_depth() == 1);
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_OBJECT_END);
+	CHECK(reader->read() == ERR_FILE_EOF);
+}
+
+TEST_CASE("[JSONReader] Reading invalid documents") {
+	Ref<JSONReader> reader;
+	reader.instantiate();
+	reader->open_buffer(String(R"([1 2])").to_utf8_buffer());
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->read() == OK);
+	CHECK_MESSAGE(
+			reader->read() == ERR_PARSE_ERROR,
+			"A missing comma should be reported.");
+	CHECK(!reader->get_error_message().is_empty());
+	CHECK_MESSAGE(
+			reader->read() == ERR_PARSE_ERROR,
+			"Reading after an error should keep failing.");
+}
 } // namespace TestJSON
 
 #endif // TEST_JSON_H
@@ -326,6 +326,111 @@ TEST_CASE("[Marshalls] FLOAT double precision Variant decoding") {
 	CHECK(r_len == 12);
 	CHECK(variant == Variant(0.33333333333333333));
 }
+
+TEST_CASE("[Marshalls] Single-pass Variant encoding") {
+	Dictionary dictionary;
+	dictionary["name"] = "Godot";
+	dictionary[StringName("path")] = NodePath("a/b:c");
+	dictionary[Vector3(1, 2, 3)] = Color(0.5, 0.25, 1, 1);
+	Array array;
+	array.push_back(PackedInt32Array({ 1, -2, 3 }));
+	array.push_back(PackedFloat64Array({ 0.5, 0.125 }));
+	array.push_back(PackedStringArray({ "a", "bcd" }));
+	array.push_back(int64_t(1) << 40);
+	dictionary["array"] = array;
+
+	int len;
+	CHECK(encode_variant(dictionary, nullptr, len) == OK);
+	Vector<uint8_t> expected;
+	expected.resize(len);
+	CHECK(encode_variant(dictionary, expected.ptrw(), len) == OK);
+
+	Vector<uint8_t> buffer;
+	int buffer_len;
+	CHECK(encode_variant(dictionary, buffer, buffer_len) == OK);
+	CHECK_MESSAGE(
+			buffer_len == len,
+			"The single-pass encoding should have the same size as the regular one.");
+	CHECK_MESSAGE(
+			memcmp(buffer.ptr(), expected.ptr(), len) == 0,
+			"The single-pass encoding should be identical to the regular one.");
+}
+
+TEST_CASE("[Marshalls] Compact PackedInt64Array encoding") {
+	const PackedInt64Array values = { 0, -1, 1, 300 };
+	Vector<uint8_t> buffer;
+	int len;
+
+	CHECK(encode_variant(values, buffer, len, false, true) == OK);
+	CHECK_MESSAGE(len == 16, "Small values should be stored with a single byte.");
+	CHECK(buffer[8] == 0x00);
+	CHECK(buffer[9] == 0x01); // -1
+	CHECK(buffer[10] == 0x02); // 1
+	CHECK(buffer[11] == 0xd8); // 300
+	CHECK(buffer[12] == 0x04);
+
+	Variant variant;
+	int r_len;
+	CHECK(decode_variant(variant, buffer.ptr(), len, &r_len) == OK);
+	CHECK(r_len == 16);
+	CHECK(variant == Variant(values));
+}
+
+TEST_CASE("[Marshalls] Compact typed Array encoding") {
+	Array ints;
+	ints.set_typed(Variant::INT, StringName(), Variant());
+	ints.push_back(-5);
+	ints.push_back(int64_t(1) << 50);
+	Array floats;
+	floats.set_typed(Variant::FLOAT, StringName(), Variant());
+	floats.push_back(0.1);
+	Array arrays;
+	arrays.push_back(ints);
+	arrays.push_back(floats);
+
+	Vector<uint8_t> buffer;
+	int len;
+	CHECK(encode_variant(arrays, buffer, len, false, true) == OK);
+
+	Variant variant;
+	int r_len;
+	CHECK(decode_variant(variant, buffer.ptr(), len, &r_len) == OK);
+	CHECK(r_len == len);
+	const Array decoded = variant;
+	CHECK(decoded == arrays);
+	CHECK_MESSAGE(
+			Array(decoded[0]).get_typed_builtin() == Variant::INT,
+			"Compact arrays should keep their type.");
+	CHECK(Array(decoded[1]).get_typed_builtin() == Variant::FLOAT);
+}
+
+TEST_CASE("[Marshalls] Single-pass encoding with a size limit") {
+	Array array;
+	array.push_back(42);
+	PackedByteArray bytes;
+	bytes.resize(4000);
+	array.push_back(bytes);
+
+	Vector<uint8_t> buffer;
+	int len;
+	CHECK(encode_variant(array, buffer, len) == OK);
+	const int full_len = len;
+
+	Vector<uint8_t> limited_buffer;
+	CHECK_MESSAGE(
+			encode_variant(array, limited_buffer, len, false, false, 1024) == ERR_OUT_OF_MEMORY,
+			"Encoding past the size limit should fail.");
+	CHECK(len == 0);
+	CHECK_MESSAGE(
+			limited_buffer.size() <= 1024,
+			"The buffer shouldn't grow past the size limit.");
+
+	CHECK_MESSAGE(
+			encode_variant(array, limited_buffer, len, false, false, full_len) == OK,
+			"An encoding exactly as large as the limit should succeed.");
+	CHECK(len == full_len);
+	CHECK(memcmp(limited_buffer.ptr(), buffer.ptr(), len) == 0);
+}
 } // namespace TestMarshalls
 
 #endif // TEST_MARSHALLS_H
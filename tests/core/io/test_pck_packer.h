@@ -32,7 +32,9 @@
 #define TEST_PCK_PACKER_H
 
 #include "core/io/file_access_pack.h"
+#include "core/io/marshalls.h"
 #include "core/io/pck_packer.h"
+#include "core/math/random_pcg.h"
 #include "core/os/os.h"
 
 #include "tests/test_utils.h"
@@ -40,6 +42,64 @@
 
 namespace TestPCKPacker {
 
+static uint32_t get_pck_format_version(const String &p_pck_path) {
+	Ref<FileAccess> f = FileAccess::open(p_pck_path, FileAccess::READ);
+	if (f.is_null() || f->get_32() != PACK_HEADER_MAGIC) {
+		return 0;
+	}
+	return f->get_32();
+}
+
+// Packs a file in blocks and reads it back through the pack, seeking across the blocks.
+static void check_compressed_round_trip(const String &p_name, int p_dictionary_size) {
+	const int block_size = 1024;
+	// Four full blocks and a partial one. The third block is noise which doesn't compress and is stored raw.
+	Vector<uint8_t> data;
+	data.resize(block_size * 4 + 300);
+	RandomPCG rng(42);
+	const char *text = "Godot Engine ";
+	for (int i = 0; i < data.size(); i++) {
+		const bool noise = i >= block_size * 2 && i < block_size * 3;
+		data.write[i] = noise ? rng.rand() % 256 : text[i % 13];
+	}
+
+	const String cache_path = OS::get_singleton()->get_cache_path();
+	const String src_path = cache_path.path_join(p_name + ".bin");
+	{
+		Ref<FileAccess> src = FileAccess::open(src_path, FileAccess::WRITE);
+		REQUIRE(src.is_valid());
+		src->store_buffer(data.ptr(), data.size());
+	}
+
+	const String output_pck_path = cache_path.path_join(p_name + ".pck");
+	const String packed_path = "res://" + p_name + "/data.bin";
+	PCKPacker pck_packer;
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	pck_packer.set_compression(true, block_size, p_dictionary_size);
+	REQUIRE(pck_packer.add_file(packed_path, src_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	CHECK_MESSAGE(
+			get_pck_format_version(output_pck_path) == PACK_FORMAT_VERSION_V3,
+			"A PCK file with compressed files should use the format version 3.");
+
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+	Ref<FileAccess> f = PackedData::get_singleton()->try_open_path(packed_path);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == (uint64_t)data.size());
+	CHECK_MESSAGE(f->get_buffer(data.size()) == data, "The whole file should be read back unchanged.");
+
+	f->seek(block_size - 10);
+	CHECK_MESSAGE(f->get_buffer(20) == data.slice(block_size - 10, block_size + 10), "Reading across a block boundary should return both blocks.");
+
+	f->seek(block_size * 2 + 5);
+	CHECK_MESSAGE(f->get_buffer(block_size) == data.slice(block_size * 2 + 5, block_size * 3 + 5), "Seeking back into the raw block should read it unchanged.");
+
+	f->seek(block_size * 4 + 100);
+	CHECK_MESSAGE(f->get_buffer(block_size) == data.slice(block_size * 4 + 100), "Reading the last partial block should stop at the end of the file.");
+	CHECK(f->eof_reached());
+}
+
 TEST_CASE("[PCKPacker] Pack an empty PCK file") {
 	PCKPacker pck_packer;
 	const String output_pck_path = OS::get_singleton()->get_cache_path().path_join("output_empty.pck");
@@ -117,6 +177,82 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 35000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Packs without compressed files keep the format version 2") {
+	const String cache_path = OS::get_singleton()->get_cache_path();
+	const String src_path = cache_path.path_join("uncompressed_round_trip.txt");
+	{
+		Ref<FileAccess> src = FileAccess::open(src_path, FileAccess::WRITE);
+		REQUIRE(src.is_valid());
+		src->store_string("Not compressed.");
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = cache_path.path_join("output_uncompressed.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	REQUIRE(pck_packer.add_file("res://uncompressed_round_trip/data.txt", src_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	CHECK_MESSAGE(
+			get_pck_format_version(output_pck_path) == PACK_FORMAT_VERSION_V2,
+			"A PCK file without compressed files should stay readable by older versions.");
+
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+	Ref<FileAccess> f = PackedData::get_singleton()->try_open_path("res://uncompressed_round_trip/data.txt");
+	REQUIRE(f.is_valid());
+	CHECK(f->get_as_utf8_string() == "Not compressed.");
+}
+
+TEST_CASE("[PCKPacker] Compressed files round trip") {
+	check_compressed_round_trip("compressed_round_trip", 0);
+}
+
+TEST_CASE("[PCKPacker] Compressed files with a dictionary round trip") {
+	check_compressed_round_trip("compressed_dictionary_round_trip", 512);
+}
+
+TEST_CASE("[PCKPacker] Compressed files with corrupted block offsets are rejected") {
+	const String cache_path = OS::get_singleton()->get_cache_path();
+	const String src_path = cache_path.path_join("compressed_corrupted.txt");
+	{
+		Ref<FileAccess> src = FileAccess::open(src_path, FileAccess::WRITE);
+		REQUIRE(src.is_valid());
+		for (int i = 0; i < 300; i++) {
+			src->store_string("Godot Engine ");
+		}
+	}
+
+	const String output_pck_path = cache_path.path_join("compressed_corrupted.pck");
+	PCKPacker pck_packer;
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	pck_packer.set_compression(true, 1024, 0);
+	REQUIRE(pck_packer.add_file("res://compressed_corrupted/data.txt", src_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	// Find the block table (block size 1024, 4 blocks) and make the second block end before the first one.
+	Vector<uint8_t> pck = FileAccess::get_file_as_bytes(output_pck_path);
+	const uint8_t table_header[8] = { 0x00, 0x04, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00 };
+	int table = -1;
+	for (int i = 0; i + 8 <= pck.size(); i++) {
+		if (memcmp(pck.ptr() + i, table_header, 8) == 0) {
+			table = i;
+			break;
+		}
+	}
+	REQUIRE(table != -1);
+	encode_uint64(1, pck.ptrw() + table + 16);
+	{
+		Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(pck.ptr(), pck.size());
+	}
+
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+	ERR_PRINT_OFF;
+	Ref<FileAccess> f = PackedData::get_singleton()->try_open_path("res://compressed_corrupted/data.txt");
+	CHECK_MESSAGE(!(f.is_valid() && f->is_open()), "A compressed file with block offsets going backwards should fail to open.");
+	ERR_PRINT_ON;
+}
 } // namespace TestPCKPacker
 
 #endif // TEST_PCK_PACKER_H
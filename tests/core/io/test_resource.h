@@ -109,6 +109,50 @@ TEST_CASE("[Resource] Saving and loading") {
 			loaded_child_resource_text->get_name() == "I'm a child resource",
 			"The loaded child resource name should be equal to the expected value.");
 }
+
+TEST_CASE("[Resource] Loading many sub-resources from a binary file") {
+	// Enough sub-resources for their properties to be parsed on multiple threads.
+	Ref<Resource> resource = memnew(Resource);
+	Array children;
+	Ref<Resource> previous;
+	for (int i = 0; i < 64; i++) {
+		Ref<Resource> child = memnew(Resource);
+		child->set_name("Child " + itos(i));
+		PackedInt32Array data;
+		for (int j = 0; j < i; j++) {
+			data.push_back(j * i);
+		}
+		child->set_meta("data", data);
+		if (previous.is_valid()) {
+			child->set_meta("previous", previous);
+		}
+		children.push_back(child);
+		previous = child;
+	}
+	resource->set_meta("children", children);
+	const String save_path = OS::get_singleton()->get_cache_path().path_join("resource_many.res");
+	ResourceSaver::save(resource, save_path);
+
+	const Ref<Resource> loaded_resource = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded_resource.is_valid());
+	const Array loaded_children = loaded_resource->get_meta("children");
+	REQUIRE(loaded_children.size() == 64);
+	for (int i = 0; i < 64; i++) {
+		const Ref<Resource> child = loaded_children[i];
+		REQUIRE(child.is_valid());
+		CHECK(child->get_name() == "Child " + itos(i));
+		const PackedInt32Array data = child->get_meta("data");
+		REQUIRE(data.size() == i);
+		if (i > 1) {
+			CHECK(data[i - 1] == (i - 1) * i);
+		}
+		if (i > 0) {
+			CHECK_MESSAGE(
+					Ref<Resource>(child->get_meta("previous")) == Ref<Resource>(loaded_children[i - 1]),
+					"Sub-resources referring to the same sub-resource should share it.");
+		}
+	}
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
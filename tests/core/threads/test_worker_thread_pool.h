@@ -153,6 +153,196 @@ TEST_CASE("[WorkerThreadPool] Process 256 elements on native task group low prio
 	CHECK(callable_group_counter.get() == count - 1);
 }
 
+struct DependencyTestData {
+	SafeNumeric<uint32_t> order;
+	uint32_t first_a = 0;
+	uint32_t first_c = 0;
+	uint32_t then_b = 0;
+	SafeNumeric<uint32_t> group_max;
+	uint32_t group_max_seen = 0;
+};
+
+static void static_dependency_a_test(void *p_arg) {
+	DependencyTestData *data = (DependencyTestData *)p_arg;
+	OS::get_singleton()->delay_usec(1000);
+	data->first_a = data->order.increment();
+}
+
+static void static_dependency_c_test(void *p_arg) {
+	DependencyTestData *data = (DependencyTestData *)p_arg;
+	data->first_c = data->order.increment();
+}
+
+static void static_dependency_b_test(void *p_arg) {
+	DependencyTestData *data = (DependencyTestData *)p_arg;
+	data->then_b = data->order.increment();
+	data->group_max_seen = data->group_max.get();
+}
+
+static void static_dependency_group_test(void *p_arg, uint32_t p_index) {
+	DependencyTestData *data = (DependencyTestData *)p_arg;
+	data->group_max.exchange_if_greater(p_index);
+}
+
+TEST_CASE("[WorkerThreadPool] Run tasks after their dependencies") {
+	DependencyTestData data;
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+
+	WorkerThreadPool::TaskID a = pool->add_native_task(static_dependency_a_test, &data, true);
+	WorkerThreadPool::TaskID c = pool->add_native_task(static_dependency_c_test, &data, true);
+	WorkerThreadPool::GroupID group = pool->add_native_group_task_after({ a }, static_dependency_group_test, &data, 256, -1, true);
+	WorkerThreadPool::TaskID b = pool->add_native_task_after({ a, c, group }, static_dependency_b_test, &data, true);
+
+	pool->wait_for_task_completion(b);
+	pool->wait_for_task_completion(a);
+	pool->wait_for_task_completion(c);
+	pool->wait_for_group_task_completion(group);
+
+	CHECK(data.then_b == 3);
+	CHECK(data.group_max_seen == 255);
+
+	// Dependencies that already completed don't delay the task.
+	WorkerThreadPool::TaskID d = pool->add_native_task(static_dependency_c_test, &data, true);
+	while (!pool->is_task_completed(d)) {
+		OS::get_singleton()->delay_usec(1);
+	}
+	WorkerThreadPool::TaskID e = pool->add_native_task_after({ d }, static_dependency_b_test, &data, false);
+	pool->wait_for_task_completion(e);
+	pool->wait_for_task_completion(d);
+	CHECK(data.then_b == 5);
+}
+
+struct NestedTaskData {
+	WorkerThreadPool *pool = nullptr;
+	SafeNumeric<uint32_t> counter;
+	int children = 0;
+};
+
+static void static_nested_child_test(void *p_arg) {
+	NestedTaskData *data = (NestedTaskData *)p_arg;
+	data->counter.increment();
+}
+
+static void static_nested_parent_test(void *p_arg) {
+	NestedTaskData *data = (NestedTaskData *)p_arg;
+	WorkerThreadPool::TaskID *tasks = (WorkerThreadPool::TaskID *)alloca(sizeof(WorkerThreadPool::TaskID) * data->children);
+	for (int i = 0; i < data->children; i++) {
+		tasks[i] = data->pool->add_native_task(static_nested_child_test, data, true);
+	}
+	for (int i = 0; i < data->children; i++) {
+		data->pool->wait_for_task_completion(tasks[i]);
+	}
+}
+
+static void static_nested_group_parent_test(void *p_arg) {
+	NestedTaskData *data = (NestedTaskData *)p_arg;
+	WorkerThreadPool::GroupID group = data->pool->add_native_group_task(static_group_test, &data->counter, data->children, -1, true);
+	data->pool->wait_for_group_task_completion(group);
+}
+
+TEST_CASE("[WorkerThreadPool] Process nested tasks with work stealing") {
+	WorkerThreadPool *pool = memnew(WorkerThreadPool);
+	pool->init(4, false, 0.3, true);
+	CHECK(pool->is_using_work_stealing());
+	CHECK(WorkerThreadPool::get_singleton() != pool);
+
+	NestedTaskData data;
+	data.pool = pool;
+	data.children = 256;
+
+	SUBCASE("Tasks") {
+		const int count = 8;
+		WorkerThreadPool::TaskID tasks[count];
+		for (int i = 0; i < count; i++) {
+			tasks[i] = pool->add_native_task(static_nested_parent_test, &data, true);
+		}
+		for (int i = 0; i < count; i++) {
+			pool->wait_for_task_completion(tasks[i]);
+		}
+		CHECK(data.counter.get() == count * data.children);
+	}
+
+	SUBCASE("Task group") {
+		WorkerThreadPool::TaskID task = pool->add_native_task(static_nested_group_parent_test, &data, true);
+		pool->wait_for_task_completion(task);
+		CHECK(data.counter.get() == data.children - 1);
+	}
+
+	memdelete(pool);
+}
+
+TEST_CASE("[WorkerThreadPool] Process native low priority tasks on a standalone pool") {
+	WorkerThreadPool *pool = memnew(WorkerThreadPool);
+	pool->init(2, true);
+	CHECK(WorkerThreadPool::get_singleton() != pool);
+
+	const int count = 16;
+	SafeNumeric<uint32_t> counter = SafeNumeric<uint32_t>(0);
+	WorkerThreadPool::TaskID tasks[count];
+	for (int i = 0; i < count; i++) {
+		tasks[i] = pool->add_native_task(static_test, &counter, false);
+	}
+	for (int i = 0; i < count; i++) {
+		pool->wait_for_task_completion(tasks[i]);
+	}
+	CHECK(counter.get() == count);
+
+	memdelete(pool);
+}
+
+static void static_benchmark_group_test(void *p_arg, uint32_t p_index) {
+	uint64_t *results = (uint64_t *)p_arg;
+	results[p_index] = hash_murmur3_one_64(p_index);
+}
+
+// Not run by default, use `--test --no-skip --test-case="*Benchmark*"` to print the results.
+TEST_CASE("[WorkerThreadPool][Benchmark] Task throughput" * doctest::skip()) {
+	const int group_count = 256;
+	const int group_elements = 256;
+	const int nested_count = 64;
+	const int nested_children = 256;
+
+	LocalVector<uint64_t> results;
+	results.resize(group_elements);
+
+	for (int thread_count = 1; thread_count <= 64; thread_count *= 2) {
+		for (int work_stealing = 0; work_stealing < 2; work_stealing++) {
+			WorkerThreadPool *pool = memnew(WorkerThreadPool);
+			pool->init(thread_count, false, 0.3, work_stealing);
+
+			// One task per element, so the queue is hit as hard as possible.
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < group_count; i++) {
+				WorkerThreadPool::GroupID group = pool->add_native_group_task(static_benchmark_group_test, results.ptr(), group_elements, group_elements, true);
+				pool->wait_for_group_task_completion(group);
+			}
+			uint64_t group_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+
+			// Tasks submitted from within tasks.
+			NestedTaskData data;
+			data.pool = pool;
+			data.children = nested_children;
+			WorkerThreadPool::TaskID tasks[nested_count];
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < nested_count; i++) {
+				tasks[i] = pool->add_native_task(static_nested_parent_test, &data, true);
+			}
+			for (int i = 0; i < nested_count; i++) {
+				pool->wait_for_task_completion(tasks[i]);
+			}
+			uint64_t nested_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+			CHECK(data.counter.get() == nested_count * nested_children);
+
+			memdelete(pool);
+
+			print_line(vformat("WorkerThreadPool (%d threads, %s): group tasks %d/s, nested tasks %d/s.",
+					thread_count, work_stealing ? "work stealing" : "shared queue",
+					uint64_t(group_count) * group_elements * 1000000 / group_usec,
+					uint64_t(nested_count) * (nested_children + 1) * 1000000 / nested_usec));
+		}
+	}
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
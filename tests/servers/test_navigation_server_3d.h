@@ -31,16 +31,336 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/config/project_settings.h"
+#include "scene/resources/navigation_mesh.h"
 #include "servers/navigation_server_3d.h"
 
 #include "tests/test_macros.h"
 
 namespace TestNavigationServer3D {
+
+// A 4x4 square on the XZ plane.
+static Ref<NavigationMesh> create_square_navigation_mesh() {
+	Ref<NavigationMesh> navigation_mesh;
+	navigation_mesh.instantiate();
+	Vector<Vector3> vertices;
+	vertices.push_back(Vector3(0, 0, 0));
+	vertices.push_back(Vector3(0, 0, 4));
+	vertices.push_back(Vector3(4, 0, 4));
+	vertices.push_back(Vector3(4, 0, 0));
+	navigation_mesh->set_vertices(vertices);
+	Vector<int> polygon;
+	polygon.push_back(0);
+	polygon.push_back(1);
+	polygon.push_back(2);
+	polygon.push_back(3);
+	navigation_mesh->add_polygon(polygon);
+	return navigation_mesh;
+}
+
+class PathQueryReceiver : public Object {
+public:
+	Array results;
+	int calls = 0;
+
+	void receive(const Array &p_results) {
+		results = p_results;
+		calls++;
+	}
+};
+
+class AvoidanceReceiver : public Object {
+public:
+	Vector3 velocity;
+	int calls = 0;
+
+	void receive(const Vector3 &p_velocity) {
+		velocity = p_velocity;
+		calls++;
+	}
+};
+
 TEST_SUITE("[Navigation]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
 		CHECK_EQ(navigation_server->get_maps().size(), 0);
 	}
+
+	TEST_CASE("[NavigationServer3D] Regions should be connected and disconnected when added and removed") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		Ref<NavigationMesh> navigation_mesh = create_square_navigation_mesh();
+
+		RID map = navigation_server->map_create();
+		RID regions[3];
+		// The first two regions share an edge, the last one is separated by a gap smaller than the edge connection margin.
+		const Vector3 offsets[3] = { Vector3(0, 0, 0), Vector3(4, 0, 0), Vector3(8.1, 0, 0) };
+		for (int i = 0; i < 3; i++) {
+			regions[i] = navigation_server->region_create();
+			navigation_server->region_set_map(regions[i], map);
+			navigation_server->region_set_transform(regions[i], Transform3D(Basis(), offsets[i]));
+			navigation_server->region_set_navigation_mesh(regions[i], navigation_mesh);
+		}
+		navigation_server->map_force_update(map);
+
+		Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(1, 0, 2), Vector3(11, 0, 2), true);
+		REQUIRE(path.size() >= 2);
+		CHECK(path[path.size() - 1].is_equal_approx(Vector3(11, 0, 2)));
+		CHECK_EQ(navigation_server->region_get_connections_count(regions[1]), 1);
+		CHECK_EQ(navigation_server->region_get_connections_count(regions[2]), 1);
+
+		SUBCASE("Removing a region should disconnect it from its neighbors") {
+			navigation_server->free(regions[1]);
+			navigation_server->map_force_update(map);
+
+			path = navigation_server->map_get_path(map, Vector3(1, 0, 2), Vector3(11, 0, 2), true);
+			REQUIRE(path.size() >= 2);
+			CHECK(path[path.size() - 1].x <= 4 + CMP_EPSILON);
+			CHECK_EQ(navigation_server->region_get_connections_count(regions[2]), 0);
+
+			regions[1] = navigation_server->region_create();
+			navigation_server->region_set_map(regions[1], map);
+			navigation_server->region_set_transform(regions[1], Transform3D(Basis(), offsets[1]));
+			navigation_server->region_set_navigation_mesh(regions[1], navigation_mesh);
+			navigation_server->map_force_update(map);
+
+			path = navigation_server->map_get_path(map, Vector3(1, 0, 2), Vector3(11, 0, 2), true);
+			REQUIRE(path.size() >= 2);
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(11, 0, 2)));
+			CHECK_EQ(navigation_server->region_get_connections_count(regions[2]), 1);
+		}
+
+		SUBCASE("Moving a region away should disconnect it from its neighbors") {
+			navigation_server->region_set_transform(regions[2], Transform3D(Basis(), Vector3(20, 0, 0)));
+			navigation_server->map_force_update(map);
+
+			CHECK_EQ(navigation_server->region_get_connections_count(regions[1]), 0);
+			CHECK_EQ(navigation_server->region_get_connections_count(regions[2]), 0);
+		}
+
+		for (int i = 0; i < 3; i++) {
+			navigation_server->free(regions[i]);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to flush the free commands.
+	}
+
+	TEST_CASE("[NavigationServer3D] Hierarchical path-finding should find the same paths") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = create_square_navigation_mesh();
+
+		// The setting is read on map creation.
+		RID maps[2];
+		for (int i = 0; i < 2; i++) {
+			ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", i == 1);
+			maps[i] = navigation_server->map_create();
+		}
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", false);
+
+		// An L shaped corridor of regions, so the paths have to turn.
+		LocalVector<RID> regions;
+		for (int i = 0; i < 2; i++) {
+			for (int j = 0; j < 16; j++) {
+				const Vector3 offset = j < 8 ? Vector3(j * 4, 0, 0) : Vector3(28, 0, (j - 7) * 4);
+				RID region = navigation_server->region_create();
+				navigation_server->region_set_map(region, maps[i]);
+				navigation_server->region_set_transform(region, Transform3D(Basis(), offset));
+				navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+				regions.push_back(region);
+			}
+			navigation_server->map_force_update(maps[i]);
+		}
+
+		const Vector3 origin = Vector3(1, 0, 2);
+		const Vector3 destination = Vector3(30, 0, 33);
+		const Vector<Vector3> path = navigation_server->map_get_path(maps[0], origin, destination, true);
+		const Vector<Vector3> hierarchical_path = navigation_server->map_get_path(maps[1], origin, destination, true);
+		REQUIRE(path.size() >= 3);
+		CHECK(path[path.size() - 1].is_equal_approx(destination));
+		CHECK_EQ(hierarchical_path, path);
+
+		SUBCASE("Paths should follow the regions and links that changed") {
+			// Break the corridor in the middle, the clusters of the other regions are kept.
+			for (int i = 0; i < 2; i++) {
+				navigation_server->region_set_transform(regions[i * 16 + 4], Transform3D(Basis(), Vector3(16, 0, 20)));
+				navigation_server->map_force_update(maps[i]);
+			}
+			CHECK_EQ(navigation_server->map_get_path(maps[1], origin, destination, true), navigation_server->map_get_path(maps[0], origin, destination, true));
+
+			// Bridge the gap with a link.
+			RID links[2];
+			for (int i = 0; i < 2; i++) {
+				links[i] = navigation_server->link_create();
+				navigation_server->link_set_map(links[i], maps[i]);
+				navigation_server->link_set_start_position(links[i], Vector3(15, 0, 2));
+				navigation_server->link_set_end_position(links[i], Vector3(21, 0, 2));
+				navigation_server->map_force_update(maps[i]);
+			}
+			const Vector<Vector3> link_path = navigation_server->map_get_path(maps[0], origin, destination, true);
+			REQUIRE(link_path.size() >= 3);
+			CHECK(link_path[link_path.size() - 1].is_equal_approx(destination));
+			CHECK_EQ(navigation_server->map_get_path(maps[1], origin, destination, true), link_path);
+
+			// Repair the corridor.
+			for (int i = 0; i < 2; i++) {
+				navigation_server->free(links[i]);
+				navigation_server->region_set_transform(regions[i * 16 + 4], Transform3D(Basis(), Vector3(16, 0, 0)));
+				navigation_server->map_force_update(maps[i]);
+			}
+			CHECK_EQ(navigation_server->map_get_path(maps[1], origin, destination, true), path);
+		}
+
+		SUBCASE("Unreachable destinations should fall back to the closest reachable point") {
+			navigation_server->region_set_transform(regions[31], Transform3D(Basis(), Vector3(28, 0, 40)));
+			navigation_server->region_set_transform(regions[15], Transform3D(Basis(), Vector3(28, 0, 40)));
+			navigation_server->map_force_update(maps[0]);
+			navigation_server->map_force_update(maps[1]);
+
+			const Vector3 far_destination = Vector3(30, 0, 42);
+			CHECK_EQ(navigation_server->map_get_path(maps[1], origin, far_destination, true), navigation_server->map_get_path(maps[0], origin, far_destination, true));
+		}
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(maps[0]);
+		navigation_server->free(maps[1]);
+		navigation_server->process(0.0); // Give server some cycles to flush the free commands.
+	}
+
+	TEST_CASE("[NavigationServer3D] Cached paths should be invalidated when the map changes") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = create_square_navigation_mesh();
+
+		// The setting is read on map creation.
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/path_cache_size", 16);
+		RID map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/path_cache_size", 0);
+
+		RID regions[2];
+		for (int i = 0; i < 2; i++) {
+			regions[i] = navigation_server->region_create();
+			navigation_server->region_set_map(regions[i], map);
+			navigation_server->region_set_transform(regions[i], Transform3D(Basis(), Vector3(i * 4, 0, 0)));
+			navigation_server->region_set_navigation_mesh(regions[i], navigation_mesh);
+		}
+		navigation_server->map_force_update(map);
+
+		const Vector3 origin = Vector3(1, 0, 2);
+		const Vector3 destination = Vector3(7, 0, 2);
+		const Vector<Vector3> path = navigation_server->map_get_path(map, origin, destination, true);
+		REQUIRE(path.size() >= 2);
+		CHECK(path[path.size() - 1].is_equal_approx(destination));
+		CHECK_EQ(navigation_server->map_get_path(map, origin, destination, true), path);
+
+		navigation_server->free(regions[1]);
+		navigation_server->map_force_update(map);
+
+		const Vector<Vector3> new_path = navigation_server->map_get_path(map, origin, destination, true);
+		REQUIRE(new_path.size() >= 2);
+		CHECK(new_path[new_path.size() - 1].x <= 4 + CMP_EPSILON);
+
+		navigation_server->free(regions[0]);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to flush the free commands.
+	}
+
+	TEST_CASE("[NavigationServer3D] The avoidance grid should find the same neighbors as the KdTree") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// The setting is read on map creation.
+		RID maps[2];
+		for (int i = 0; i < 2; i++) {
+			ProjectSettings::get_singleton()->set_setting("navigation/avoidance/use_spatial_grid", i == 1);
+			maps[i] = navigation_server->map_create();
+			navigation_server->map_set_active(maps[i], true);
+		}
+		ProjectSettings::get_singleton()->set_setting("navigation/avoidance/use_spatial_grid", false);
+
+		// Two agents walking towards each other, and one far away from them.
+		const Vector3 positions[3] = { Vector3(0, 0, 0), Vector3(2, 0, 0), Vector3(50, 0, 0) };
+		const Vector3 velocities[3] = { Vector3(1, 0, 0), Vector3(-1, 0, 0), Vector3(1, 0, 0) };
+		RID agents[2][3];
+		AvoidanceReceiver receivers[2][3];
+		for (int i = 0; i < 2; i++) {
+			for (int j = 0; j < 3; j++) {
+				RID agent = navigation_server->agent_create();
+				navigation_server->agent_set_map(agent, maps[i]);
+				navigation_server->agent_set_neighbor_distance(agent, 5.0);
+				navigation_server->agent_set_max_neighbors(agent, 10);
+				navigation_server->agent_set_time_horizon(agent, 1.0);
+				navigation_server->agent_set_radius(agent, 0.5);
+				navigation_server->agent_set_max_speed(agent, 2.0);
+				navigation_server->agent_set_position(agent, positions[j]);
+				navigation_server->agent_set_velocity(agent, velocities[j]);
+				navigation_server->agent_set_target_velocity(agent, velocities[j]);
+				navigation_server->agent_set_callback(agent, callable_mp(&receivers[i][j], &AvoidanceReceiver::receive));
+				agents[i][j] = agent;
+			}
+		}
+		navigation_server->process(0.1);
+
+		for (int j = 0; j < 3; j++) {
+			CHECK_EQ(receivers[1][j].calls, 1);
+			CHECK(receivers[1][j].velocity.is_equal_approx(receivers[0][j].velocity));
+		}
+		CHECK_FALSE(receivers[1][0].velocity.is_equal_approx(velocities[0]));
+		CHECK(receivers[1][2].velocity.is_equal_approx(velocities[2]));
+
+		SUBCASE("Agents moving to another cell should be moved in the grid") {
+			navigation_server->agent_set_position(agents[1][1], Vector3(50, 0, 20));
+			navigation_server->process(0.1);
+
+			CHECK(receivers[1][0].velocity.is_equal_approx(velocities[0]));
+		}
+
+		for (int i = 0; i < 2; i++) {
+			for (int j = 0; j < 3; j++) {
+				navigation_server->free(agents[i][j]);
+			}
+			navigation_server->free(maps[i]);
+		}
+		navigation_server->process(0.0); // Give server some cycles to flush the free commands.
+	}
+
+	TEST_CASE("[NavigationServer3D] Batched path queries should deliver their results on the next update") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, create_square_navigation_mesh());
+		navigation_server->map_force_update(map);
+
+		TypedArray<NavigationPathQueryParameters3D> queries;
+		for (int i = 0; i < 8; i++) {
+			Ref<NavigationPathQueryParameters3D> query_parameters;
+			query_parameters.instantiate();
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(Vector3(0.5, 0, 0.5));
+			query_parameters->set_target_position(Vector3(3.5, 0, 0.5 + i * 0.4));
+			queries.push_back(query_parameters);
+		}
+
+		PathQueryReceiver receiver;
+		navigation_server->query_paths(queries, callable_mp(&receiver, &PathQueryReceiver::receive));
+		CHECK_EQ(receiver.calls, 0);
+
+		navigation_server->process(0.0);
+		REQUIRE_EQ(receiver.calls, 1);
+		REQUIRE_EQ(receiver.results.size(), queries.size());
+		for (int i = 0; i < queries.size(); i++) {
+			Ref<NavigationPathQueryResult3D> query_result = receiver.results[i];
+			REQUIRE(query_result.is_valid());
+			const Vector<Vector3> &path = query_result->get_path();
+			REQUIRE(path.size() >= 2);
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(3.5, 0, 0.5 + i * 0.4)));
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to flush the free commands.
+	}
 }
 } //namespace TestNavigationServer3D
 
@@ -0,0 +1,216 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "servers/physics_3d/godot_body_pair_3d.h"
+#include "servers/physics_3d/godot_collision_solver_3d.h"
+#include "servers/physics_3d/godot_shape_3d.h"
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+static RID create_box_shape(const Vector3 &p_half_extents) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	RID shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(shape, p_half_extents);
+	return shape;
+}
+
+static RID create_body(RID p_space, RID p_shape, PhysicsServer3D::BodyMode p_mode, const Vector3 &p_position) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	RID body = physics_server->body_create();
+	physics_server->body_set_mode(body, p_mode);
+	physics_server->body_add_shape(body, p_shape);
+	physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_position));
+	physics_server->body_set_space(body, p_space);
+	return body;
+}
+
+// Same box as a convex hull, which always goes through the full SAT without the box quick tests.
+static void setup_box_hull(GodotConvexPolygonShape3D &r_hull, const Vector3 &p_half_extents) {
+	PackedVector3Array points;
+	for (int i = 0; i < 8; i++) {
+		points.push_back(Vector3(i & 1 ? p_half_extents.x : -p_half_extents.x, i & 2 ? p_half_extents.y : -p_half_extents.y, i & 4 ? p_half_extents.z : -p_half_extents.z));
+	}
+	r_hull.set_data(points);
+}
+
+static Dictionary capsule_data(real_t p_radius, real_t p_height) {
+	Dictionary data;
+	data["radius"] = p_radius;
+	data["height"] = p_height;
+	return data;
+}
+
+TEST_SUITE("[Physics]") {
+	TEST_CASE("[GodotCollisionSolver3D] Box quick rejection agrees with the full SAT") {
+		GodotBoxShape3D box;
+		box.set_data(Vector3(0.5, 0.5, 0.5));
+		GodotConvexPolygonShape3D hull;
+		setup_box_hull(hull, Vector3(0.5, 0.5, 0.5));
+		GodotCapsuleShape3D capsule;
+		capsule.set_data(capsule_data(0.3, 1.0));
+
+		// The first column is sheared into the second, so the box reaches x = 1.0 instead of 0.5.
+		const Basis skewed = Basis(Vector3(1, 0, 0), Vector3(1, 1, 0), Vector3(0, 0, 1)).transposed();
+		const Basis rotated = Basis(Vector3(0, 1, 0), Math_PI / 4.0);
+
+		struct PairCase {
+			const char *name;
+			Transform3D transform_a;
+			Transform3D transform_b;
+			bool box_collides;
+			bool capsule_collides;
+		};
+		const PairCase cases[] = {
+			{ "Touching", Transform3D(), Transform3D(Basis(), Vector3(0.999, 0, 0)), true, false },
+			{ "Separated", Transform3D(), Transform3D(Basis(), Vector3(1.001, 0, 0)), false, false },
+			{ "Touching rotated", Transform3D(rotated, Vector3()), Transform3D(Basis(), Vector3(0.5 * Math_SQRT2 + 0.499, 0, 0)), true, false },
+			{ "Separated rotated", Transform3D(rotated, Vector3()), Transform3D(Basis(), Vector3(0.5 * Math_SQRT2 + 0.501, 0, 0)), false, false },
+			{ "Touching capsule", Transform3D(), Transform3D(Basis(), Vector3(0.799, 0, 0)), true, true },
+			{ "Separated capsule", Transform3D(), Transform3D(Basis(), Vector3(0.801, 0, 0)), true, false },
+			{ "Skewed", Transform3D(skewed, Vector3()), Transform3D(Basis(), Vector3(1.2, 0.3, 0)), true, true },
+			{ "Skewed and scaled", Transform3D(skewed.scaled(Vector3(2, 2, 2)), Vector3()), Transform3D(Basis(), Vector3(2.2, 0.8, 0)), true, true },
+		};
+
+		for (const PairCase &pair : cases) {
+			INFO(pair.name);
+			const bool box_collides = GodotCollisionSolver3D::solve_static(&box, pair.transform_a, &box, pair.transform_b, nullptr, nullptr);
+			CHECK(box_collides == GodotCollisionSolver3D::solve_static(&hull, pair.transform_a, &hull, pair.transform_b, nullptr, nullptr));
+			CHECK(box_collides == pair.box_collides);
+
+			const bool capsule_collides = GodotCollisionSolver3D::solve_static(&box, pair.transform_a, &capsule, pair.transform_b, nullptr, nullptr);
+			CHECK(capsule_collides == GodotCollisionSolver3D::solve_static(&hull, pair.transform_a, &capsule, pair.transform_b, nullptr, nullptr));
+			CHECK(capsule_collides == pair.capsule_collides);
+		}
+	}
+
+	TEST_CASE("[GodotCollisionSolver3D] Box quick rejection keeps the separating axis") {
+		GodotBoxShape3D box;
+		box.set_data(Vector3(0.5, 0.5, 0.5));
+		const Transform3D transform_b = Transform3D(Basis(), Vector3(0, 0, 2));
+
+		Vector3 sep_axis;
+		CHECK_FALSE(GodotCollisionSolver3D::solve_static(&box, Transform3D(), &box, transform_b, nullptr, nullptr, &sep_axis));
+		CHECK(sep_axis.abs().is_equal_approx(Vector3(0, 0, 1)));
+
+		// Once the boxes overlap, the previous axis no longer separates them and the SAT replaces it.
+		const Transform3D overlapping = Transform3D(Basis(), Vector3(0, 0.9, 0));
+		CHECK(GodotCollisionSolver3D::solve_static(&box, Transform3D(), &box, overlapping, nullptr, nullptr, &sep_axis));
+		CHECK(sep_axis.abs().is_equal_approx(Vector3(0, 1, 0)));
+	}
+
+
+	TEST_CASE("[GodotBodyPair3D] Narrowphase cache") {
+		GodotBoxShape3D box_a;
+		box_a.set_data(Vector3(0.5, 0.5, 0.5));
+		GodotBoxShape3D box_b;
+		box_b.set_data(Vector3(2, 0.5, 0.5));
+		const real_t tolerance = 0.001;
+
+		const Transform3D xform_a = Transform3D(Basis(), Vector3(0, 0.95, 0));
+		const Transform3D xform_b = Transform3D();
+		GodotBodyPair3D::NarrowphaseCache cache;
+		CHECK_FALSE(cache.matches(&box_a, xform_a, &box_b, xform_b, tolerance));
+		cache.store(&box_a, xform_a, &box_b, xform_b, true);
+
+		SUBCASE("Hits when the pair stays in place or moves together") {
+			CHECK(cache.matches(&box_a, xform_a, &box_b, xform_b, tolerance));
+			const Transform3D moved = Transform3D(Basis(Vector3(0, 1, 0), 0.3), Vector3(5, 1, -2));
+			CHECK(cache.matches(&box_a, moved * xform_a, &box_b, moved * xform_b, tolerance));
+			// Solver jitter well below the tolerance still hits.
+			CHECK(cache.matches(&box_a, xform_a, &box_b, xform_b.translated(Vector3(0, 1e-5, 0)), tolerance));
+		}
+
+		SUBCASE("Misses when the pair moves relative to each other") {
+			CHECK_FALSE(cache.matches(&box_a, xform_a, &box_b, xform_b.translated(Vector3(0, 0.01, 0)), tolerance));
+			// A small rotation moves the far ends of the long box more than the tolerance.
+			CHECK_FALSE(cache.matches(&box_a, xform_a, &box_b, Transform3D(Basis(Vector3(0, 0, 1), 0.001), Vector3()), tolerance));
+			CHECK_FALSE(cache.matches(&box_b, xform_a, &box_a, xform_b, tolerance));
+		}
+
+		SUBCASE("Misses when a shape changes") {
+			box_b.set_data(Vector3(2, 0.6, 0.5));
+			CHECK_FALSE(cache.matches(&box_a, xform_a, &box_b, xform_b, tolerance));
+			cache.store(&box_a, xform_a, &box_b, xform_b, true);
+			CHECK(cache.matches(&box_a, xform_a, &box_b, xform_b, tolerance));
+		}
+	}
+
+	TEST_CASE("[SceneTree][PhysicsServer3D] Static body reports contacts from several islands") {
+		PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+		physics_server->set_active(true);
+
+		RID space = physics_server->space_create();
+		physics_server->space_set_active(space, true);
+
+		// Two boxes far apart rest on the same contact reporting static floor, so they are in different islands
+		// whose pairs both write to the floor's contacts.
+		RID floor_shape = create_box_shape(Vector3(20, 0.5, 20));
+		RID box_shape = create_box_shape(Vector3(0.5, 0.5, 0.5));
+		RID floor = create_body(space, floor_shape, PhysicsServer3D::BODY_MODE_STATIC, Vector3());
+		physics_server->body_set_max_contacts_reported(floor, 64);
+		RID box_a = create_body(space, box_shape, PhysicsServer3D::BODY_MODE_RIGID, Vector3(-10, 0.95, 0));
+		RID box_b = create_body(space, box_shape, PhysicsServer3D::BODY_MODE_RIGID, Vector3(10, 0.95, 0));
+
+		for (int i = 0; i < 4; i++) {
+			physics_server->step(1.0 / 60.0);
+		}
+
+		CHECK(physics_server->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT) == 2);
+
+		PhysicsDirectBodyState3D *floor_state = physics_server->body_get_direct_state(floor);
+		REQUIRE(floor_state != nullptr);
+		bool touched_by_a = false;
+		bool touched_by_b = false;
+		for (int i = 0; i < floor_state->get_contact_count(); i++) {
+			touched_by_a = touched_by_a || floor_state->get_contact_collider(i) == box_a;
+			touched_by_b = touched_by_b || floor_state->get_contact_collider(i) == box_b;
+		}
+		CHECK_MESSAGE(touched_by_a, "The floor should report contacts with the first island.");
+		CHECK_MESSAGE(touched_by_b, "The floor should report contacts with the second island.");
+
+		physics_server->free(box_b);
+		physics_server->free(box_a);
+		physics_server->free(floor);
+		physics_server->free(box_shape);
+		physics_server->free(floor_shape);
+		physics_server->free(space);
+		physics_server->set_active(false);
+	}
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H